@@ -0,0 +1,83 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-19.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <filesystem>
+#include <iosfwd>
+#include <stop_token>
+#include "AsyncTask.hpp"
+#include "ExecutionContext.hpp"
+#include "Image.hpp"
+#include "Png/PngWriteOptions.hpp"
+#include "YimageException.hpp"
+
+namespace Yimage
+{
+    /**
+     * @brief Thrown by asynchronous operations that stop because
+     *      cancellation was requested.
+     */
+    class OperationCancelled : public YimageException
+    {
+    public:
+        using YimageException::YimageException;
+    };
+
+    /**
+     * @brief Reads an image on @a executor, or on the executor in
+     *      default_execution_context() if @a executor is empty.
+     *
+     * The image is decoded in bands of rows with an ImageReader, and
+     * @a stop_token is checked before each band. If stop is requested,
+     * the task fails with OperationCancelled.
+     *
+     * The pixels are identical to those returned by read_image, but
+     * the metadata only contains the format, path and palette.
+     */
+    [[nodiscard]]
+    AsyncTask<Image> async_read_image(std::filesystem::path path,
+                                      const Executor& executor = {},
+                                      std::stop_token stop_token = {});
+
+    /**
+     * @brief Reads an image from @a buffer on @a executor. The buffer
+     *      must remain valid until the task has finished.
+     */
+    [[nodiscard]]
+    AsyncTask<Image> async_read_image(const void* buffer, size_t size,
+                                      const Executor& executor = {},
+                                      std::stop_token stop_token = {});
+
+    /**
+     * @brief Writes @a image as PNG to @a path with write_png on the
+     *      executor in @a context.
+     *
+     * The task runs on Yimage's internal thread pool if @a context
+     * has no executor, and write_png gets @a context as well. The
+     * pixels in @a image must remain valid until the task has
+     * finished. @a stop_token is checked before each write to the file,
+     * the incomplete file is removed if the task is cancelled.
+     */
+    [[nodiscard]]
+    AsyncTask<void> async_write_png(std::filesystem::path path,
+                                    const ImageView& image,
+                                    const PngWriteOptions& options = {},
+                                    const ExecutionContext& context = default_execution_context(),
+                                    std::stop_token stop_token = {});
+
+    /**
+     * @brief Writes @a image as PNG to @a stream on the executor in
+     *      @a context. The stream must remain valid until the task has
+     *      finished.
+     */
+    [[nodiscard]]
+    AsyncTask<void> async_write_png(std::ostream& stream,
+                                    const ImageView& image,
+                                    const PngWriteOptions& options = {},
+                                    const ExecutionContext& context = default_execution_context(),
+                                    std::stop_token stop_token = {});
+}
@@ -0,0 +1,123 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-19.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <coroutine>
+#include <future>
+#include <memory>
+#include <mutex>
+
+namespace Yimage
+{
+    namespace Detail
+    {
+        template <typename T>
+        struct AsyncState
+        {
+            template <typename Func>
+            void run(Func& func)
+            {
+                try
+                {
+                    if constexpr (std::is_void_v<T>)
+                    {
+                        func();
+                        promise.set_value();
+                    }
+                    else
+                    {
+                        promise.set_value(func());
+                    }
+                }
+                catch (...)
+                {
+                    promise.set_exception(std::current_exception());
+                }
+
+                std::coroutine_handle<> handle;
+                {
+                    std::lock_guard lock(mutex);
+                    done = true;
+                    handle = continuation;
+                }
+                if (handle)
+                    handle.resume();
+            }
+
+            std::promise<T> promise;
+            std::future<T> future = promise.get_future();
+            std::mutex mutex;
+            std::coroutine_handle<> continuation;
+            bool done = false;
+        };
+    }
+
+    /**
+     * @brief The result of an operation that runs on an executor.
+     *
+     * The result can be obtained in one of three ways: by co_await-ing
+     * the task in a coroutine, by calling get(), which blocks until the
+     * operation has finished, or as a std::future from future(). Only
+     * one of them can be used for a given task.
+     *
+     * A coroutine that awaits the task is resumed on the thread that
+     * finished the operation.
+     */
+    template <typename T>
+    class AsyncTask
+    {
+    public:
+        AsyncTask() = default;
+
+        explicit AsyncTask(std::shared_ptr<Detail::AsyncState<T>> state)
+            : state_(std::move(state))
+        {}
+
+        explicit operator bool() const
+        {
+            return state_ && state_->future.valid();
+        }
+
+        [[nodiscard]]
+        bool await_ready() const
+        {
+            std::lock_guard lock(state_->mutex);
+            return state_->done;
+        }
+
+        bool await_suspend(std::coroutine_handle<> handle)
+        {
+            std::lock_guard lock(state_->mutex);
+            if (state_->done)
+                return false;
+            state_->continuation = handle;
+            return true;
+        }
+
+        T await_resume()
+        {
+            return state_->future.get();
+        }
+
+        /**
+         * @brief Waits for the operation to finish and returns its result
+         *      or rethrows its exception.
+         */
+        T get()
+        {
+            return state_->future.get();
+        }
+
+        [[nodiscard]]
+        std::future<T> future()
+        {
+            return std::move(state_->future);
+        }
+    private:
+        std::shared_ptr<Detail::AsyncState<T>> state_;
+    };
+}
@@ -0,0 +1,126 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-19.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <exception>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <vector>
+#include "ExecutionContext.hpp"
+#include "Image.hpp"
+
+namespace Yimage
+{
+    class BatchDecoderOptions
+    {
+    public:
+        [[nodiscard]]
+        size_t max_pending() const;
+
+        /**
+         * @brief Sets the maximum number of images that can be read or
+         *      decoded, but not yet delivered, at any time.
+         *
+         * This puts a cap on the decoder's memory use. The default, 0,
+         * means twice the number of images that are decoded at the
+         * same time.
+         */
+        BatchDecoderOptions& max_pending(size_t value);
+
+        [[nodiscard]]
+        bool ordered() const;
+
+        /**
+         * @brief Sets whether the images are delivered in the same order
+         *      as the inputs, or as soon as they are decoded.
+         *
+         * The default is true.
+         */
+        BatchDecoderOptions& ordered(bool value);
+    private:
+        size_t max_pending_ = 0;
+        bool ordered_ = true;
+    };
+
+    struct BatchResult
+    {
+        /**
+         * @brief The index of the image in the decoder's input.
+         */
+        size_t index = 0;
+        /**
+         * @brief The decoded image, empty if @a error is set.
+         */
+        Image image;
+        std::exception_ptr error;
+    };
+
+    /**
+     * @brief Reads and decodes many images in parallel.
+     *
+     * Each image is read and decoded by a task that runs on the
+     * execution context's executor, with as many images in progress
+     * at the same time as the context allows. Decoding thereby
+     * overlaps with the caller's processing of the previous images.
+     * Files are opened with open_image_source, which means that they
+     * are memory-mapped where possible. The work starts as soon as the
+     * decoder is constructed and pauses when max_pending() images are
+     * waiting to be delivered.
+     *
+     * Errors are reported per image, a file that can't be read or
+     * decoded doesn't stop the rest of the batch.
+     */
+    class BatchDecoder
+    {
+    public:
+        explicit BatchDecoder(std::vector<std::filesystem::path> paths,
+                              const BatchDecoderOptions& options = {},
+                              const ExecutionContext& context = default_execution_context());
+
+        /**
+         * @brief Decodes images that are already in memory. The buffers
+         *      must remain valid until the decoder is destroyed.
+         */
+        explicit BatchDecoder(std::vector<std::pair<const void*, size_t>> buffers,
+                              const BatchDecoderOptions& options = {},
+                              const ExecutionContext& context = default_execution_context());
+
+        BatchDecoder(const BatchDecoder&) = delete;
+
+        /**
+         * @brief Stops reading and decoding and waits for the tasks
+         *      to finish their current images.
+         */
+        ~BatchDecoder();
+
+        BatchDecoder& operator=(const BatchDecoder&) = delete;
+
+        /**
+         * @brief Returns the total number of images in the batch.
+         */
+        [[nodiscard]]
+        size_t size() const;
+
+        /**
+         * @brief Waits for and returns the next image, or an empty
+         *      optional when all images have been delivered.
+         */
+        [[nodiscard]]
+        std::optional<BatchResult> next();
+
+        /**
+         * @brief Calls @a callback on the calling thread for each image
+         *      as it becomes available.
+         */
+        void run(const std::function<void(BatchResult&)>& callback);
+    private:
+        struct Data;
+        std::unique_ptr<Data> data_;
+    };
+}
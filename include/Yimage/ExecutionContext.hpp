@@ -0,0 +1,119 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-19.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <cstddef>
+#include <functional>
+
+namespace Yimage
+{
+    /**
+     * @brief A function that runs a task, typically by handing it over
+     *      to a thread pool owned by the application.
+     *
+     * The executor must eventually run every task it receives, but it
+     * is free to run it on the calling thread.
+     */
+    using Executor = std::function<void(std::function<void()>)>;
+
+    enum class ParallelismHint
+    {
+        /**
+         * @brief Use several threads if the amount of work makes it
+         *      worthwhile.
+         */
+        AUTO,
+        /**
+         * @brief Do all the work on the calling thread.
+         */
+        SEQUENTIAL,
+        /**
+         * @brief Spread the work across all available threads, even
+         *      when there is little of it.
+         */
+        MAXIMUM
+    };
+
+    /**
+     * @brief Controls how Yimage's parallel operations use threads.
+     *
+     * Unless an executor is set, Yimage runs additional work on an
+     * internal thread pool which is created the first time it's needed.
+     */
+    class ExecutionContext
+    {
+    public:
+        [[nodiscard]]
+        size_t thread_count() const;
+
+        /**
+         * @brief Sets the maximum number of threads, including the calling
+         *      thread, that can work on a single operation.
+         *
+         * 0 means the number of hardware threads.
+         */
+        ExecutionContext& thread_count(size_t value);
+
+        [[nodiscard]]
+        const Executor& executor() const;
+
+        /**
+         * @brief Sets the function used to run work on other threads.
+         *
+         * If the executor is empty, Yimage's internal thread pool is used.
+         */
+        ExecutionContext& executor(Executor value);
+
+        [[nodiscard]]
+        size_t grain_size() const;
+
+        /**
+         * @brief Sets the approximate number of bytes processed by each
+         *      task. 0 means a default size that fits in the CPU's L2 cache.
+         */
+        ExecutionContext& grain_size(size_t value);
+
+        [[nodiscard]]
+        ParallelismHint parallelism() const;
+
+        ExecutionContext& parallelism(ParallelismHint value);
+
+        /**
+         * @brief Returns the number of threads that can work on an
+         *      operation, with the parallelism hint taken into account.
+         */
+        [[nodiscard]]
+        size_t max_threads() const;
+    private:
+        Executor executor_;
+        size_t thread_count_ = 0;
+        size_t grain_size_ = 0;
+        ParallelismHint parallelism_ = ParallelismHint::AUTO;
+    };
+
+    /**
+     * @brief Returns a copy of the context used by operations where
+     *      no context is given explicitly.
+     */
+    [[nodiscard]]
+    ExecutionContext default_execution_context();
+
+    void set_default_execution_context(ExecutionContext context);
+
+    /**
+     * @brief Calls @a func for every index in [0, @a count), using as many
+     *      threads as @a context allows.
+     *
+     * The calling thread takes part in the work. The function returns
+     * when all calls have finished. If one or more calls throw, the first
+     * exception is rethrown.
+     */
+    void run_parallel(size_t count,
+                      const std::function<void(size_t)>& func,
+                      const ExecutionContext& context
+                          = default_execution_context());
+}
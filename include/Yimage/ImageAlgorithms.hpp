@@ -6,18 +6,52 @@
 // License text is included with the source distribution.
 //****************************************************************************
 #pragma once
-#include "MutableImageView.hpp"
+#include "Image.hpp"
+#include "TileScheduler.hpp"
 
 namespace Yimage
 {
-    void fill_rgba8(const MutableImageView& image, Rgba8 rgba);
+    void fill_rgba8(const MutableImageView& image, Rgba8 rgba,
+                    const ExecutionContext& context
+                        = default_execution_context());
 
-    void fill_rgba8(const MutableImageView& image, const Rgba8* rgba, size_t num_rgba);
+    void fill_rgba8(const MutableImageView& image,
+                    const Rgba8* rgba, size_t num_rgba,
+                    const ExecutionContext& context
+                        = default_execution_context());
 
-    void flip_vertically(MutableImageView image);
+    void flip_vertically(MutableImageView image,
+                         const ExecutionContext& context
+                             = default_execution_context());
 
     void paste(ImageView src,
                MutableImageView dst,
                ptrdiff_t x = 0,
-               ptrdiff_t y = 0);
+               ptrdiff_t y = 0,
+               const ExecutionContext& context = default_execution_context());
+
+    /**
+     * @brief Replaces the indices in @a src with the colors they refer to
+     *      in the palette in @a src's metadata.
+     *
+     * @a src must have one of the indexed pixel types, and @a dst must
+     * have the same width and height as @a src and a pixel type with
+     * 8-bit channels, e.g. RGB_8 or RGBA_8. Indices without a
+     * corresponding color in the palette become opaque black.
+     */
+    void expand_palette(const ImageView& src, const MutableImageView& dst,
+                        const ExecutionContext& context
+                            = default_execution_context());
+
+    void expand_palette(const ImageView& src,
+                        const Rgba8* palette, size_t palette_size,
+                        const MutableImageView& dst,
+                        const ExecutionContext& context
+                            = default_execution_context());
+
+    [[nodiscard]]
+    Image expand_palette(const ImageView& src,
+                         PixelType pixel_type = PixelType::RGBA_8,
+                         const ExecutionContext& context
+                             = default_execution_context());
 }
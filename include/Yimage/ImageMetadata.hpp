@@ -7,6 +7,8 @@
 //****************************************************************************
 #pragma once
 #include <filesystem>
+#include <vector>
+#include "Rgba8.hpp"
 
 namespace Yimage
 {
@@ -29,5 +31,9 @@ namespace Yimage
 
         std::filesystem::path path;
         ImageFormat format = ImageFormat::UNKNOWN;
+        /**
+         * @brief The colors of images with an indexed pixel type.
+         */
+        std::vector<Rgba8> palette;
     };
 }
@@ -0,0 +1,129 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-19.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <memory>
+#include <optional>
+#include <vector>
+#include "ExecutionContext.hpp"
+#include "ImageView.hpp"
+#include "MutableImageView.hpp"
+
+namespace Yimage
+{
+    enum class PyramidFilter
+    {
+        /**
+         * @brief Each pixel is the plain average of a 2x2 block.
+         */
+        BOX,
+        /**
+         * @brief Color channels are treated as sRGB-encoded and averaged
+         *      in linear light. Alpha channels and MONO_FLOAT_32 images
+         *      are averaged as with BOX.
+         */
+        SRGB_BOX
+    };
+
+    /**
+     * @brief A mip chain where all levels share a single contiguous buffer.
+     *
+     * Level 0 has the size of the original image, each subsequent level
+     * is half the width and height of the previous one (rounded up),
+     * and the last level is at most 1x1 pixels. The levels are stored
+     * back-to-back without row gaps.
+     */
+    class ImagePyramid
+    {
+    public:
+        ImagePyramid();
+
+        ImagePyramid(PixelType pixel_type, size_t width, size_t height,
+                     size_t levels = 0);
+
+        ImagePyramid(const ImagePyramid& rhs);
+
+        ImagePyramid(ImagePyramid&& rhs) noexcept;
+
+        ~ImagePyramid();
+
+        ImagePyramid& operator=(const ImagePyramid& rhs);
+
+        ImagePyramid& operator=(ImagePyramid&& rhs) noexcept;
+
+        [[nodiscard]]
+        explicit operator bool() const;
+
+        [[nodiscard]]
+        size_t level_count() const;
+
+        [[nodiscard]]
+        ImageView level(size_t index) const;
+
+        [[nodiscard]]
+        MutableImageView mutable_level(size_t index);
+
+        [[nodiscard]]
+        const unsigned char* data() const;
+
+        [[nodiscard]]
+        unsigned char* data();
+
+        /**
+         * @brief Returns the combined size of all levels in bytes.
+         */
+        [[nodiscard]]
+        size_t size() const;
+
+        [[nodiscard]]
+        PixelType pixel_type() const;
+    private:
+        struct Level
+        {
+            size_t offset = 0;
+            size_t width = 0;
+            size_t height = 0;
+        };
+
+        PixelType pixel_type_ = PixelType::NONE;
+        size_t size_ = 0;
+        std::vector<Level> levels_;
+        std::unique_ptr<unsigned char[]> buffer_;
+    };
+
+    /**
+     * @brief Returns the number of levels in a complete pyramid for
+     *      an image of the given size, including the original image.
+     */
+    [[nodiscard]]
+    size_t get_max_pyramid_levels(size_t width, size_t height);
+
+    /**
+     * @brief Creates a copy of @a image followed by successively
+     *      downscaled versions of it.
+     *
+     * @param image The image. Pixel types with less than 8 bits per pixel
+     *      are not supported.
+     * @param levels The number of levels, including the original image.
+     *      0 or a number greater than the maximum produces a complete
+     *      pyramid down to 1x1 pixels.
+     * @param filter Determines how 2x2 blocks are averaged.
+     * @param no_data For MONO_FLOAT_32 images, pixels with this value are
+     *      ignored when averaging. NaN pixels are always ignored. Blocks
+     *      where every pixel is ignored produce @a no_data, or NaN if
+     *      @a no_data isn't given.
+     * @param context Controls how many threads are used to compute
+     *      each level.
+     */
+    [[nodiscard]]
+    ImagePyramid build_pyramid(const ImageView& image,
+                               size_t levels = 0,
+                               PyramidFilter filter = PyramidFilter::BOX,
+                               std::optional<float> no_data = {},
+                               const ExecutionContext& context
+                                   = default_execution_context());
+}
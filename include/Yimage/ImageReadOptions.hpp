@@ -0,0 +1,40 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-19.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <cstddef>
+
+namespace Yimage
+{
+    /**
+     * @brief Settings for read_image that apply to all image formats.
+     */
+    class ImageReadOptions
+    {
+    public:
+        [[nodiscard]]
+        size_t min_width() const;
+
+        [[nodiscard]]
+        size_t min_height() const;
+
+        /**
+         * @brief Tells read_image that an image of at least @a width x
+         *      @a height pixels is sufficient, for instance because it
+         *      will be resized to a thumbnail afterwards.
+         *
+         * JPEG images are decoded at the smallest scale that gives at
+         * least this size, see JpegReadOptions::min_size. Other formats
+         * are decoded at full size. The default, 0 x 0, decodes all
+         * images at full size.
+         */
+        ImageReadOptions& min_size(size_t width, size_t height);
+    private:
+        size_t min_width_ = 0;
+        size_t min_height_ = 0;
+    };
+}
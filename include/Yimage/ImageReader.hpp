@@ -0,0 +1,80 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-19.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <filesystem>
+#include <memory>
+#include "ImageSource.hpp"
+#include "MutableImageView.hpp"
+#include "ProbeImage.hpp"
+
+namespace Yimage
+{
+    class ImageReaderBackend;
+
+    /**
+     * @brief Decodes an image a few rows at a time.
+     *
+     * Only the rows that are requested are decoded, which means that
+     * memory use is proportional to the height of the bands rather than
+     * the size of the image. The exceptions are interlaced PNG images,
+     * which must be decoded in full before the first row is available.
+     *
+     * The rows are identical to those in the image returned by read_image.
+     */
+    class ImageReader
+    {
+    public:
+        ImageReader();
+
+        explicit ImageReader(const std::filesystem::path& path);
+
+        /**
+         * @brief Reads an image from @a buffer. The buffer must remain
+         *      valid until the reader is closed.
+         */
+        ImageReader(const void* buffer, size_t size);
+
+        explicit ImageReader(std::unique_ptr<ImageSource> source);
+
+        ImageReader(ImageReader&& rhs) noexcept;
+
+        ~ImageReader();
+
+        ImageReader& operator=(ImageReader&& rhs) noexcept;
+
+        explicit operator bool() const;
+
+        void open(const std::filesystem::path& path);
+
+        void open(const void* buffer, size_t size);
+
+        void open(std::unique_ptr<ImageSource> source);
+
+        void close();
+
+        [[nodiscard]]
+        const ImageInfo& info() const;
+
+        /**
+         * @brief Returns the number of rows that have been read.
+         */
+        [[nodiscard]]
+        size_t current_row() const;
+
+        /**
+         * @brief Decodes the next @a band.height() rows into @a band.
+         *
+         * @a band must have the same width and pixel type as the image,
+         * and can not have more rows than there are left in the image.
+         */
+        void read_rows(const MutableImageView& band);
+    private:
+        std::unique_ptr<ImageReaderBackend> backend_;
+        size_t current_row_ = 0;
+    };
+}
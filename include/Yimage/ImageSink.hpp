@@ -0,0 +1,239 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-19.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <cstdint>
+#include <filesystem>
+#include <iosfwd>
+#include <memory>
+#include <memory_resource>
+#include <span>
+#include <vector>
+
+namespace Yimage
+{
+    /**
+     * @brief The destination of the bytes produced by the encoders.
+     *
+     * Implementations throw an exception if the bytes can't be written.
+     */
+    class ImageSink
+    {
+    public:
+        virtual ~ImageSink() = default;
+
+        virtual void write(const void* data, size_t size) = 0;
+
+        /**
+         * @brief Called by the encoders when the image is complete.
+         */
+        virtual void flush();
+
+        /**
+         * @brief Called by the encoders before they start writing, with
+         *      an estimate of the number of bytes they will write.
+         *
+         * The estimate can be too small as well as too large. Sinks that
+         * store the bytes in memory can allocate the space in advance.
+         */
+        virtual void reserve(size_t size);
+    };
+
+    /**
+     * @brief A sink that appends the bytes to a vector. The vector must
+     *      remain valid as long as the sink is in use.
+     */
+    class VectorSink : public ImageSink
+    {
+    public:
+        explicit VectorSink(std::vector<unsigned char>& buffer);
+
+        void write(const void* data, size_t size) override;
+
+        void reserve(size_t size) override;
+    private:
+        std::vector<unsigned char>* buffer_;
+    };
+
+    /**
+     * @brief A sink that stores the bytes in memory from an arena, for
+     *      instance a std::pmr::monotonic_buffer_resource that is reset
+     *      after each request.
+     *
+     * The arena must remain valid as long as the sink or the buffer
+     * returned by release() is in use.
+     */
+    class ArenaSink : public ImageSink
+    {
+    public:
+        explicit ArenaSink(std::pmr::memory_resource* arena
+                               = std::pmr::get_default_resource());
+
+        void write(const void* data, size_t size) override;
+
+        void reserve(size_t size) override;
+
+        /**
+         * @brief Returns the bytes written so far.
+         */
+        [[nodiscard]]
+        std::span<const unsigned char> data() const;
+
+        /**
+         * @brief Hands over the bytes written so far without copying
+         *      them, and leaves the sink empty.
+         */
+        [[nodiscard]]
+        std::pmr::vector<unsigned char> release();
+    private:
+        std::pmr::vector<unsigned char> buffer_;
+    };
+
+    /**
+     * @brief What FileSink::flush does to make sure the file is written
+     *      to disk.
+     */
+    enum class FileSync
+    {
+        /**
+         * @brief Leaves it to the operating system.
+         */
+        NONE,
+        /**
+         * @brief Waits until the file's contents are on disk, with
+         *      fdatasync.
+         */
+        DATA,
+        /**
+         * @brief Waits until the file's contents and metadata are on
+         *      disk, with fsync or FlushFileBuffers.
+         */
+        FULL
+    };
+
+    class FileSinkOptions
+    {
+    public:
+        [[nodiscard]]
+        size_t buffer_size() const;
+
+        /**
+         * @brief Sets the size of the buffer that collects the bytes
+         *      before they are written to the file.
+         *
+         * The default is 256 KB, which makes most PNG images a single
+         * write call. 0 writes the bytes straight to the file.
+         */
+        FileSinkOptions& buffer_size(size_t value);
+
+        [[nodiscard]]
+        bool preallocate() const;
+
+        /**
+         * @brief Sets whether FileSink::reserve allocates disk space for
+         *      the estimated size of the file, which reduces
+         *      fragmentation.
+         *
+         * The default is false. Only supported on Linux, where the space
+         * beyond the end of the file is released again by flush().
+         */
+        FileSinkOptions& preallocate(bool value);
+
+        [[nodiscard]]
+        FileSync sync() const;
+
+        /**
+         * @brief Sets what FileSink::flush does to make sure the file is
+         *      written to disk. The default is FileSync::NONE.
+         */
+        FileSinkOptions& sync(FileSync value);
+
+        [[nodiscard]]
+        bool drop_cache() const;
+
+        /**
+         * @brief Sets whether FileSink::flush tells the operating system
+         *      that the file's pages won't be needed again, with
+         *      posix_fadvise.
+         *
+         * Keeps a program that writes many files from filling the page
+         * cache. Only the pages that have been written to disk can be
+         * dropped, so it is most effective with a sync policy. The
+         * default is false, it is ignored on Windows.
+         */
+        FileSinkOptions& drop_cache(bool value);
+    private:
+        size_t buffer_size_ = 256 * 1024;
+        bool preallocate_ = false;
+        FileSync sync_ = FileSync::NONE;
+        bool drop_cache_ = false;
+    };
+
+    /**
+     * @brief A sink that writes to a file through its file descriptor,
+     *      or handle on Windows. The file is created or truncated.
+     *
+     * The bytes are collected in a buffer and written when it is full
+     * and when flush() is called. The destructor writes what remains in
+     * the buffer, but ignores errors, call flush() to detect them.
+     */
+    class FileSink : public ImageSink
+    {
+    public:
+        explicit FileSink(const std::filesystem::path& path,
+                          const FileSinkOptions& options = {});
+
+        FileSink(const FileSink&) = delete;
+
+        ~FileSink() override;
+
+        FileSink& operator=(const FileSink&) = delete;
+
+        void write(const void* data, size_t size) override;
+
+        /**
+         * @brief Writes the buffer to the file, and syncs the file
+         *      according to the options.
+         */
+        void flush() override;
+
+        void reserve(size_t size) override;
+    private:
+        void write_buffer();
+
+        void write_file(const unsigned char* data, size_t size);
+
+        FileSinkOptions options_;
+        // Allocated by the first write, and not initialized, to avoid
+        // touching more pages than the file needs.
+        std::unique_ptr<unsigned char[]> buffer_;
+        size_t buffer_used_ = 0;
+        uint64_t file_size_ = 0;
+        bool preallocated_ = false;
+#ifdef _WIN32
+        void* handle_ = nullptr;
+#else
+        int fd_ = -1;
+#endif
+    };
+
+    /**
+     * @brief A sink that writes to a stream. The stream must remain
+     *      valid as long as the sink is in use.
+     */
+    class StreamSink : public ImageSink
+    {
+    public:
+        explicit StreamSink(std::ostream& stream);
+
+        void write(const void* data, size_t size) override;
+
+        void flush() override;
+    private:
+        std::ostream* stream_;
+    };
+}
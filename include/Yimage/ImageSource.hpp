@@ -0,0 +1,162 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-19.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <cstdint>
+#include <filesystem>
+#include <iosfwd>
+#include <memory>
+#include <span>
+
+namespace Yimage
+{
+    /**
+     * @brief The encoded bytes of an image, as read by the decoders.
+     *
+     * Reads are positional, which allows file sources to use pread and
+     * several decoders to share the same file. Sources where the entire
+     * image is already in memory also return it from data(), the decoders
+     * then read it directly instead of copying it through read().
+     */
+    class ImageSource
+    {
+    public:
+        virtual ~ImageSource() = default;
+
+        /**
+         * @brief Copies up to @a size bytes starting at @a offset
+         *      to @a buffer.
+         *
+         * @return The number of bytes copied, which is less than @a size
+         *      only at the end of the source.
+         */
+        virtual size_t read(uint64_t offset, void* buffer, size_t size) = 0;
+
+        /**
+         * @brief Returns the size of the source in bytes, or the
+         *      maximum value of uint64_t if it's unknown.
+         */
+        [[nodiscard]]
+        virtual uint64_t size() const = 0;
+
+        /**
+         * @brief Returns the entire source if it is in memory, otherwise
+         *      an empty span.
+         */
+        [[nodiscard]]
+        virtual std::span<const unsigned char> data() const;
+    };
+
+    /**
+     * @brief A source for an image in a buffer. The buffer must remain
+     *      valid as long as the source is in use.
+     */
+    class MemorySource : public ImageSource
+    {
+    public:
+        MemorySource(const void* buffer, size_t size);
+
+        size_t read(uint64_t offset, void* buffer, size_t size) override;
+
+        [[nodiscard]]
+        uint64_t size() const override;
+
+        [[nodiscard]]
+        std::span<const unsigned char> data() const override;
+    private:
+        std::span<const unsigned char> data_;
+    };
+
+    /**
+     * @brief A source that reads a file with pread, or its equivalent
+     *      on Windows.
+     */
+    class FileSource : public ImageSource
+    {
+    public:
+        explicit FileSource(const std::filesystem::path& path);
+
+        FileSource(const FileSource&) = delete;
+
+        ~FileSource() override;
+
+        FileSource& operator=(const FileSource&) = delete;
+
+        size_t read(uint64_t offset, void* buffer, size_t size) override;
+
+        [[nodiscard]]
+        uint64_t size() const override;
+    private:
+#ifdef _WIN32
+        void* handle_ = nullptr;
+#else
+        int fd_ = -1;
+#endif
+        uint64_t size_ = 0;
+    };
+
+    class MemoryMappedFile;
+
+    /**
+     * @brief A source for a memory-mapped file.
+     *
+     * Throws an exception if the file can't be mapped, use
+     * open_image_source() to fall back to a FileSource in that case.
+     */
+    class MappedFileSource : public ImageSource
+    {
+    public:
+        explicit MappedFileSource(const std::filesystem::path& path);
+
+        ~MappedFileSource() override;
+
+        size_t read(uint64_t offset, void* buffer, size_t size) override;
+
+        [[nodiscard]]
+        uint64_t size() const override;
+
+        [[nodiscard]]
+        std::span<const unsigned char> data() const override;
+    private:
+        explicit MappedFileSource(std::unique_ptr<MemoryMappedFile> mapping);
+
+        friend std::unique_ptr<ImageSource>
+        open_image_source(const std::filesystem::path& path);
+
+        std::unique_ptr<MemoryMappedFile> mapping_;
+    };
+
+    /**
+     * @brief A source that reads from a stream. Offsets are relative
+     *      to the stream's position when the source was created.
+     *
+     * The stream must remain valid as long as the source is in use.
+     * It only has to support seeking if the decoder reads the image
+     * out of order, which only the TIFF decoder does.
+     */
+    class StreamSource : public ImageSource
+    {
+    public:
+        explicit StreamSource(std::istream& stream);
+
+        size_t read(uint64_t offset, void* buffer, size_t size) override;
+
+        [[nodiscard]]
+        uint64_t size() const override;
+    private:
+        std::istream* stream_;
+        uint64_t start_;
+        uint64_t position_ = 0;
+    };
+
+    /**
+     * @brief Returns a MappedFileSource for @a path if the file can be
+     *      mapped, otherwise a FileSource.
+     */
+    [[nodiscard]]
+    std::unique_ptr<ImageSource> open_image_source(const std::filesystem::path& path);
+}
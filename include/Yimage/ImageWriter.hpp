@@ -0,0 +1,110 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-19.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <filesystem>
+#include <iosfwd>
+#include <memory>
+#include "ImageSink.hpp"
+#include "ImageView.hpp"
+#include "ProbeImage.hpp"
+#include "Png/PngWriteOptions.hpp"
+
+namespace Yimage
+{
+    class ImageWriterBackend;
+
+    /**
+     * @brief Encodes an image a few rows at a time.
+     *
+     * The rows are encoded and written as they are passed to
+     * write_rows(), which means that the image never has to be in memory
+     * in its entirety. The output is complete when the last row has been
+     * written. Closing the writer before that leaves a truncated image.
+     *
+     * Only PNG is supported at the moment.
+     */
+    class ImageWriter
+    {
+    public:
+        ImageWriter();
+
+        /**
+         * @brief Creates the file at @a path and prepares it for an image
+         *      with the size and pixel type in @a info.
+         *
+         * If @a info.format is UNKNOWN, the format is determined by
+         * the extension of @a path.
+         *
+         * @param png_options The compression settings used if the image
+         *      is written as PNG. Throws an exception if they ask for
+         *      quantizing and @a info.pixel_type isn't indexed, use
+         *      write_image to quantize images.
+         */
+        ImageWriter(const std::filesystem::path& path, const ImageInfo& info,
+                    const PngWriteOptions& png_options = {});
+
+        /**
+         * @brief Writes the image to @a stream. The stream must remain
+         *      valid until the writer is closed.
+         */
+        ImageWriter(std::ostream& stream, const ImageInfo& info,
+                    const PngWriteOptions& png_options = {});
+
+        /**
+         * @brief Writes the image to @a sink. The sink must remain
+         *      valid until the writer is closed.
+         */
+        ImageWriter(ImageSink& sink, const ImageInfo& info,
+                    const PngWriteOptions& png_options = {});
+
+        ImageWriter(ImageWriter&& rhs) noexcept;
+
+        ~ImageWriter();
+
+        ImageWriter& operator=(ImageWriter&& rhs) noexcept;
+
+        explicit operator bool() const;
+
+        void open(const std::filesystem::path& path, const ImageInfo& info,
+                  const PngWriteOptions& png_options = {});
+
+        void open(std::ostream& stream, const ImageInfo& info,
+                  const PngWriteOptions& png_options = {});
+
+        void open(ImageSink& sink, const ImageInfo& info,
+                  const PngWriteOptions& png_options = {});
+
+        void close();
+
+        [[nodiscard]]
+        const ImageInfo& info() const;
+
+        /**
+         * @brief Returns the number of rows that have been written.
+         */
+        [[nodiscard]]
+        size_t current_row() const;
+
+        /**
+         * @brief Encodes the rows in @a band and writes them after the
+         *      rows that have already been written.
+         *
+         * @a band must have the same width and pixel type as the image,
+         * and can not have more rows than there are left in the image.
+         */
+        void write_rows(const ImageView& band);
+    private:
+        void open(std::unique_ptr<ImageSink> sink, const ImageInfo& info,
+                  const PngWriteOptions& png_options);
+
+        std::unique_ptr<ImageSink> own_sink_;
+        ImageSink* sink_ = nullptr;
+        std::unique_ptr<ImageWriterBackend> backend_;
+        size_t current_row_ = 0;
+    };
+}
@@ -0,0 +1,61 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-19.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <memory>
+#include "../Image.hpp"
+#include "../ImageSource.hpp"
+#include "JpegReadOptions.hpp"
+
+namespace Yimage
+{
+    /**
+     * @brief Decodes JPEG images with a jpeg_decompress_struct that is
+     *      reused from one image to the next.
+     *
+     * The decompressor, its error manager and its permanent memory pool
+     * are only created once, and the input buffer is kept between
+     * images. Keep one decoder per thread when decoding many small
+     * images. A decoder can not be used by several threads at the
+     * same time.
+     */
+    class JpegDecoder
+    {
+    public:
+        JpegDecoder();
+
+        explicit JpegDecoder(const JpegReadOptions& options);
+
+        JpegDecoder(JpegDecoder&& rhs) noexcept;
+
+        ~JpegDecoder();
+
+        JpegDecoder& operator=(JpegDecoder&& rhs) noexcept;
+
+        [[nodiscard]]
+        const JpegReadOptions& options() const;
+
+        JpegDecoder& options(const JpegReadOptions& value);
+
+        [[nodiscard]]
+        Image read(ImageSource& source);
+
+        [[nodiscard]]
+        Image read(const void* buffer, size_t size);
+
+        /**
+         * @brief Reads a JPEG image directly into @a dst, see read_jpeg_into.
+         */
+        void read_into(ImageSource& source, const MutableImageView& dst);
+
+        void read_into(const void* buffer, size_t size,
+                       const MutableImageView& dst);
+    private:
+        struct Data;
+        std::unique_ptr<Data> data_;
+    };
+}
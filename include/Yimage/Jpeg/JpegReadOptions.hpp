@@ -0,0 +1,80 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-19.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <cstddef>
+#include <utility>
+
+namespace Yimage
+{
+    /**
+     * @brief Settings for read_jpeg, read_jpeg_into and JpegDecoder.
+     *
+     * libjpeg can scale the image by M/8, where M is 1 to 16, inside
+     * the inverse DCT. Decoding at 1/8 of the size costs a fraction of
+     * decoding the full image and then resizing it.
+     */
+    class JpegReadOptions
+    {
+    public:
+        [[nodiscard]]
+        unsigned scale_num() const;
+
+        /**
+         * @brief Sets the numerator of the scale the image is decoded at.
+         *
+         * libjpeg uses the smallest scale M/8 that is at least
+         * scale_num / scale_denom. The default is 1.
+         */
+        JpegReadOptions& scale_num(unsigned value);
+
+        [[nodiscard]]
+        unsigned scale_denom() const;
+
+        /**
+         * @brief Sets the denominator of the scale the image is decoded
+         *      at. The default is 1.
+         */
+        JpegReadOptions& scale_denom(unsigned value);
+
+        [[nodiscard]]
+        size_t min_width() const;
+
+        [[nodiscard]]
+        size_t min_height() const;
+
+        /**
+         * @brief Makes the decoder choose the smallest scale that gives
+         *      an image of at least @a width x @a height pixels, see
+         *      get_jpeg_scale.
+         *
+         * The scale is chosen when the image size is known, and
+         * scale_num and scale_denom are ignored. The default, 0 x 0,
+         * uses scale_num and scale_denom instead.
+         */
+        JpegReadOptions& min_size(size_t width, size_t height);
+    private:
+        unsigned scale_num_ = 1;
+        unsigned scale_denom_ = 1;
+        size_t min_width_ = 0;
+        size_t min_height_ = 0;
+    };
+
+    /**
+     * @brief Returns the numerator and denominator of the smallest
+     *      scale, 1/8, 1/4, 3/8 and so on up to 1/1, that makes an image
+     *      of @a width x @a height pixels at least @a min_width x
+     *      @a min_height pixels.
+     *
+     * Returns 1/1 if the image is smaller than the minimum size, images
+     * are never scaled up.
+     */
+    [[nodiscard]]
+    std::pair<unsigned, unsigned>
+    get_jpeg_scale(size_t width, size_t height,
+                   size_t min_width, size_t min_height);
+}
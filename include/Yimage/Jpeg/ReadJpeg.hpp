@@ -8,13 +8,50 @@
 #pragma once
 #include <cstdio>
 #include <filesystem>
+#include <iosfwd>
 #include "../Image.hpp"
+#include "../ImageSource.hpp"
+#include "JpegReadOptions.hpp"
 
 namespace Yimage
 {
-    [[nodiscard]] Image read_jpeg(const std::filesystem::path& path);
+    [[nodiscard]] Image read_jpeg(ImageSource& source,
+                                  const JpegReadOptions& options = {});
 
-    [[nodiscard]] Image read_jpeg(FILE* file);
+    [[nodiscard]] Image read_jpeg(std::istream& stream,
+                                  const JpegReadOptions& options = {});
 
-    [[nodiscard]] Image read_jpeg(const void* buffer, size_t size);
+    [[nodiscard]] Image read_jpeg(const std::filesystem::path& path,
+                                  const JpegReadOptions& options = {});
+
+    [[nodiscard]] Image read_jpeg(FILE* file,
+                                  const JpegReadOptions& options = {});
+
+    [[nodiscard]] Image read_jpeg(const void* buffer, size_t size,
+                                  const JpegReadOptions& options = {});
+
+    /**
+     * @brief Reads a JPEG image directly into @a dst.
+     *
+     * @a dst must have the size and pixel type that read_jpeg would
+     * return for the same image and @a options, see probe_image and
+     * get_jpeg_scale. Rows are written in place, so @a dst can have gaps
+     * between its rows.
+     */
+    void read_jpeg_into(ImageSource& source, const MutableImageView& dst,
+                        const JpegReadOptions& options = {});
+
+    void read_jpeg_into(std::istream& stream, const MutableImageView& dst,
+                        const JpegReadOptions& options = {});
+
+    void read_jpeg_into(const std::filesystem::path& path,
+                        const MutableImageView& dst,
+                        const JpegReadOptions& options = {});
+
+    void read_jpeg_into(FILE* file, const MutableImageView& dst,
+                        const JpegReadOptions& options = {});
+
+    void read_jpeg_into(const void* buffer, size_t size,
+                        const MutableImageView& dst,
+                        const JpegReadOptions& options = {});
 }
@@ -0,0 +1,202 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-19.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+#include "Image.hpp"
+#include "ImageReader.hpp"
+
+namespace Yimage
+{
+    /**
+     * @brief A step in a Pipeline that produces the rows of an image
+     *      from top to bottom.
+     *
+     * Stages are pulled: each call to read_rows() produces the next rows
+     * of the stage's output and reads only as much as it needs from the
+     * stage before it.
+     */
+    class PipelineStage
+    {
+    public:
+        virtual ~PipelineStage() = default;
+
+        [[nodiscard]]
+        virtual size_t width() const = 0;
+
+        [[nodiscard]]
+        virtual size_t height() const = 0;
+
+        [[nodiscard]]
+        virtual PixelType pixel_type() const = 0;
+
+        /**
+         * @brief Returns the palette of indexed pixel types. The default
+         *      implementation returns an empty palette.
+         */
+        [[nodiscard]]
+        virtual const std::vector<Rgba8>& palette() const;
+
+        /**
+         * @brief Writes the next @a band.height() rows of the stage's
+         *      output to @a band.
+         *
+         * @a band has the stage's width and pixel type.
+         */
+        virtual void read_rows(const MutableImageView& band) = 0;
+
+        /**
+         * @brief Returns the stage's entire output if it is already
+         *      in memory, otherwise an empty view.
+         *
+         * The following stage reads directly from this view rather than
+         * calling read_rows().
+         */
+        [[nodiscard]]
+        virtual ImageView view() const;
+    };
+
+    /**
+     * @brief A chain of image operations that are evaluated lazily, one
+     *      band of rows at a time.
+     *
+     * None of the operations are performed until the pipeline is run.
+     * The rows then flow through all the operations in bands that fit
+     * in the CPU cache, which means that memory use is bounded by the
+     * width of the image rather than its size, also when the source is
+     * an ImageReader. The exception is flip_vertically(), which has to
+     * buffer the entire image unless its input is already in memory.
+     *
+     * A pipeline can only be run once.
+     */
+    class Pipeline
+    {
+    public:
+        explicit Pipeline(const ImageView& image);
+
+        explicit Pipeline(std::unique_ptr<PipelineStage> source);
+
+        /**
+         * @brief Creates a pipeline that decodes the rows from @a reader
+         *      as they are needed.
+         */
+        explicit Pipeline(ImageReader reader);
+
+        Pipeline(Pipeline&& rhs) noexcept;
+
+        ~Pipeline();
+
+        Pipeline& operator=(Pipeline&& rhs) noexcept;
+
+        [[nodiscard]]
+        size_t width() const;
+
+        [[nodiscard]]
+        size_t height() const;
+
+        [[nodiscard]]
+        PixelType pixel_type() const;
+
+        /**
+         * @brief Returns the palette of the pipeline's output, or an
+         *      empty palette if the pixel type isn't indexed.
+         */
+        [[nodiscard]]
+        const std::vector<Rgba8>& palette() const;
+
+        /**
+         * @brief Converts the pixels to @a pixel_type.
+         *
+         * Only conversions between pixel types with 8 bits per channel
+         * or less are supported, and the destination type can not have
+         * less than 8 bits per pixel.
+         */
+        Pipeline& convert(PixelType pixel_type);
+
+        /**
+         * @brief Keeps only the given rectangle. The rectangle is clipped
+         *      to the size of the image.
+         */
+        Pipeline& crop(size_t x, size_t y, size_t width, size_t height);
+
+        Pipeline& flip_horizontally();
+
+        Pipeline& flip_vertically();
+
+        /**
+         * @brief Scales the image to the given size.
+         *
+         * Upscaling uses bilinear interpolation while downscaling
+         * averages the source pixels covered by each destination pixel.
+         * Pixel types with less than 8 bits per channel are not supported.
+         */
+        Pipeline& resize(size_t width, size_t height);
+
+        /**
+         * @brief Replaces the value of each color channel with the
+         *      corresponding entry in @a lut. Alpha channels are left
+         *      unchanged.
+         *
+         * Only pixel types with 8 bits per channel are supported.
+         */
+        Pipeline& apply_lut(const std::array<uint8_t, 256>& lut);
+
+        [[nodiscard]]
+        size_t band_height() const;
+
+        /**
+         * @brief Sets the number of rows in the bands passed to the sink.
+         *
+         * The default, 0, chooses a height that makes each band
+         * approximately 64 KiB.
+         */
+        Pipeline& band_height(size_t rows);
+
+        /**
+         * @brief Runs the pipeline and passes the result to @a sink one
+         *      band at a time, from top to bottom.
+         *
+         * The view passed to @a sink is only valid until it returns.
+         */
+        void run(const std::function<void(const ImageView& band)>& sink);
+
+        /**
+         * @brief Runs the pipeline and writes the result to @a image.
+         *
+         * @a image must have the same size and pixel type as
+         * the pipeline.
+         */
+        void run(const MutableImageView& image);
+
+        /**
+         * @brief Runs the pipeline and returns the result as an image.
+         *
+         * The image only has metadata if the pipeline has a palette.
+         */
+        [[nodiscard]]
+        Image to_image();
+
+        /**
+         * @brief Returns the last stage in the pipeline, leaving the
+         *      pipeline empty.
+         *
+         * This makes it possible to use the pipeline as the source
+         * of other pipelines or to pull rows from it directly.
+         */
+        [[nodiscard]]
+        std::unique_ptr<PipelineStage> release();
+    private:
+        PipelineStage& stage() const;
+
+        std::unique_ptr<PipelineStage> stage_;
+        size_t band_height_ = 0;
+    };
+}
@@ -28,8 +28,19 @@ namespace Yimage
         ARGB_8,
         RGBA_8,
         ARGB_16,
-        RGBA_16
+        RGBA_16,
+        /**
+         * @brief Indices into the palette in the image's metadata, see
+         *      ImageMetadata::palette.
+         */
+        INDEXED_1,
+        INDEXED_2,
+        INDEXED_4,
+        INDEXED_8
     };
 
     size_t get_pixel_size(PixelType type);
+
+    [[nodiscard]]
+    bool is_indexed(PixelType type);
 }
@@ -0,0 +1,60 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-19.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <memory>
+#include "../Image.hpp"
+#include "../ImageSource.hpp"
+#include "PngReadOptions.hpp"
+
+namespace Yimage
+{
+    /**
+     * @brief Decodes PNG images and keeps the memory libpng and zlib
+     *      allocate for the next image.
+     *
+     * Setting up libpng's structures and zlib's inflate state costs
+     * about as much as decoding a small icon. Keep one decoder per
+     * thread when decoding many small images. A decoder can not be
+     * used by several threads at the same time.
+     */
+    class PngDecoder
+    {
+    public:
+        PngDecoder();
+
+        explicit PngDecoder(const PngReadOptions& options);
+
+        PngDecoder(PngDecoder&& rhs) noexcept;
+
+        ~PngDecoder();
+
+        PngDecoder& operator=(PngDecoder&& rhs) noexcept;
+
+        [[nodiscard]]
+        const PngReadOptions& options() const;
+
+        PngDecoder& options(const PngReadOptions& value);
+
+        [[nodiscard]]
+        Image read(ImageSource& source);
+
+        [[nodiscard]]
+        Image read(const void* buffer, size_t size);
+
+        /**
+         * @brief Reads a PNG image directly into @a dst, see read_png_into.
+         */
+        void read_into(ImageSource& source, const MutableImageView& dst);
+
+        void read_into(const void* buffer, size_t size,
+                       const MutableImageView& dst);
+    private:
+        struct Data;
+        std::unique_ptr<Data> data_;
+    };
+}
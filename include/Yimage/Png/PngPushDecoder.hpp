@@ -0,0 +1,106 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-19.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <functional>
+#include <memory>
+#include "../Image.hpp"
+#include "../ProbeImage.hpp"
+
+namespace Yimage
+{
+    /**
+     * @brief Decodes a PNG image from data that arrives in pieces, for
+     *      instance over a network connection.
+     *
+     * The data is passed to push() in chunks of any size, and each
+     * chunk is decoded as far as possible before push() returns.
+     * The info callback is called as soon as the IHDR chunk has been
+     * read, and the row callback is called for each row as soon as
+     * it has been decoded.
+     *
+     * Interlaced images are decoded pass by pass. The row callback is
+     * then called once for each row in each of the seven passes the row
+     * is part of, with the pixels from all the passes so far. This
+     * requires the entire image to be kept in memory.
+     */
+    class PngPushDecoder
+    {
+    public:
+        using InfoCallback = std::function<void(const ImageInfo& info)>;
+
+        /**
+         * @brief A function that receives the rows of the image.
+         *
+         * @param y The index of the row.
+         * @param pass The Adam7 pass, from 0 to 6, or 0 if the image
+         *      isn't interlaced.
+         * @param row A view with a single row. It is only valid until
+         *      the callback returns, unless the decoder keeps the image.
+         */
+        using RowCallback = std::function<void(size_t y, int pass,
+                                               const ImageView& row)>;
+
+        PngPushDecoder();
+
+        PngPushDecoder(PngPushDecoder&& rhs) noexcept;
+
+        ~PngPushDecoder();
+
+        PngPushDecoder& operator=(PngPushDecoder&& rhs) noexcept;
+
+        PngPushDecoder& on_info(InfoCallback callback);
+
+        PngPushDecoder& on_row(RowCallback callback);
+
+        [[nodiscard]]
+        bool keep_image() const;
+
+        /**
+         * @brief Sets whether the decoded rows are collected in image().
+         *
+         * The default is true. Interlaced images are always kept.
+         */
+        PngPushDecoder& keep_image(bool value);
+
+        /**
+         * @brief Decodes as much of the image as possible with the
+         *      data received so far.
+         *
+         * Exceptions thrown by the callbacks are passed on to the
+         * caller. The decoder can't be used after an exception.
+         */
+        void push(const void* data, size_t size);
+
+        /**
+         * @brief Returns the image's format, size and pixel type, or
+         *      an ImageInfo with the pixel type NONE if the IHDR chunk
+         *      hasn't been read yet.
+         */
+        [[nodiscard]]
+        const ImageInfo& info() const;
+
+        /**
+         * @brief Returns true when the IEND chunk has been read.
+         */
+        [[nodiscard]]
+        bool is_finished() const;
+
+        /**
+         * @brief Returns the rows decoded so far if the decoder keeps
+         *      the image, otherwise an empty image.
+         */
+        [[nodiscard]]
+        const Image& image() const;
+
+        [[nodiscard]]
+        Image release_image();
+    private:
+        struct Data;
+        std::unique_ptr<Data> data_;
+    };
+}
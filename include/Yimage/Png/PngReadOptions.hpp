@@ -0,0 +1,41 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-19.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+
+namespace Yimage
+{
+    /**
+     * @brief Settings for read_png, read_png_into and PngDecoder.
+     */
+    class PngReadOptions
+    {
+    public:
+        /**
+         * @brief Options for images that are known to be intact, for
+         *      instance because they have already been verified with
+         *      a cryptographic hash. The checksums aren't verified.
+         */
+        [[nodiscard]]
+        static PngReadOptions trusted();
+
+        [[nodiscard]]
+        bool verify_checksums() const;
+
+        /**
+         * @brief Sets whether the CRC of each chunk and the Adler-32
+         *      checksum of the compressed image data are verified.
+         *
+         * The default is true. When it's false, corrupt data is decoded
+         * as if it was intact, which gives a garbled image or an error
+         * later in the decoding.
+         */
+        PngReadOptions& verify_checksums(bool value);
+    private:
+        bool verify_checksums_ = true;
+    };
+}
@@ -0,0 +1,148 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-19.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include "../Quantize.hpp"
+
+namespace Yimage
+{
+    /**
+     * @brief Compression and encoding settings for PngWriter and
+     *      write_png.
+     *
+     * Settings that aren't set keep libpng's defaults.
+     */
+    class PngWriteOptions
+    {
+    public:
+        /**
+         * @brief Compression level 1 and only the Sub filter. For
+         *      temporary files where encoding time matters more
+         *      than size.
+         */
+        [[nodiscard]]
+        static PngWriteOptions fastest();
+
+        /**
+         * @brief libpng's defaults: compression level 6 and adaptive
+         *      filtering.
+         */
+        [[nodiscard]]
+        static PngWriteOptions balanced();
+
+        /**
+         * @brief Compression level 9, the largest window and memory
+         *      level, and adaptive filtering with all filters.
+         */
+        [[nodiscard]]
+        static PngWriteOptions smallest();
+
+        [[nodiscard]]
+        const std::optional<int>& compression_level() const;
+
+        /**
+         * @brief Sets zlib's compression level, from 0 (no compression)
+         *      to 9.
+         */
+        PngWriteOptions& compression_level(std::optional<int> value);
+
+        [[nodiscard]]
+        const std::optional<int>& compression_strategy() const;
+
+        /**
+         * @brief Sets zlib's compression strategy, for instance
+         *      Z_DEFAULT_STRATEGY, Z_FILTERED, Z_HUFFMAN_ONLY or Z_RLE.
+         *
+         * libpng uses Z_FILTERED when the rows are filtered and
+         * Z_DEFAULT_STRATEGY otherwise.
+         */
+        PngWriteOptions& compression_strategy(std::optional<int> value);
+
+        [[nodiscard]]
+        const std::optional<int>& window_bits() const;
+
+        /**
+         * @brief Sets the base two logarithm of zlib's window size,
+         *      from 8 to 15.
+         */
+        PngWriteOptions& window_bits(std::optional<int> value);
+
+        [[nodiscard]]
+        const std::optional<int>& memory_level() const;
+
+        /**
+         * @brief Sets how much memory zlib uses for its internal
+         *      state, from 1 to 9.
+         */
+        PngWriteOptions& memory_level(std::optional<int> value);
+
+        [[nodiscard]]
+        const std::optional<int>& filters() const;
+
+        /**
+         * @brief Sets the row filters libpng chooses between, a
+         *      combination of PNG_FILTER_NONE, PNG_FILTER_SUB,
+         *      PNG_FILTER_UP, PNG_FILTER_AVG and PNG_FILTER_PAETH,
+         *      or PNG_ALL_FILTERS.
+         *
+         * Fewer filters means less work per row.
+         */
+        PngWriteOptions& filters(std::optional<int> value);
+
+        [[nodiscard]]
+        const std::optional<size_t>& buffer_size() const;
+
+        /**
+         * @brief Sets the size of the buffer zlib's output is collected
+         *      in. Each time the buffer is full, an IDAT chunk is
+         *      written to the sink.
+         */
+        PngWriteOptions& buffer_size(std::optional<size_t> value);
+
+        [[nodiscard]]
+        const std::optional<QuantizeOptions>& quantize() const;
+
+        /**
+         * @brief Makes write_png reduce the colors in images that
+         *      aren't indexed to a palette, and write them as indexed
+         *      PNG images.
+         *
+         * Images with few colors are written without any loss.
+         *
+         * Pipelines are run to completion first, since the palette
+         * depends on every pixel. ImageWriter and the write_png
+         * overloads for raw pixel data write the rows as they receive
+         * them, and throw an exception instead if quantizing is set.
+         */
+        PngWriteOptions& quantize(std::optional<QuantizeOptions> value);
+
+        [[nodiscard]]
+        bool interlaced() const;
+
+        /**
+         * @brief Makes the writer store the image with Adam7
+         *      interlacing, which lets viewers show a coarse version
+         *      of the image before all of it has been received.
+         *
+         * Interlaced images are larger, and can't be written with
+         * several threads or one band of rows at a time.
+         */
+        PngWriteOptions& interlaced(bool value);
+    private:
+        std::optional<int> compression_level_;
+        std::optional<int> compression_strategy_;
+        std::optional<int> window_bits_;
+        std::optional<int> memory_level_;
+        std::optional<int> filters_;
+        std::optional<size_t> buffer_size_;
+        std::optional<QuantizeOptions> quantize_;
+        bool interlaced_ = false;
+    };
+}
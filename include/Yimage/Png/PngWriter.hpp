@@ -9,8 +9,11 @@
 
 #include <string>
 #include <iosfwd>
+#include <memory>
+#include "../ImageSink.hpp"
 #include "PngMetadata.hpp"
 #include "PngTransform.hpp"
+#include "PngWriteOptions.hpp"
 
 namespace Yimage
 {
@@ -19,7 +22,15 @@ namespace Yimage
     public:
         PngWriter();
 
-        PngWriter(std::ostream& stream, PngMetadata info, PngTransform transform);
+        PngWriter(std::ostream& stream, PngMetadata info, PngTransform transform,
+                  const PngWriteOptions& options = {});
+
+        /**
+         * @brief Writes the PNG image to @a sink. The sink must remain
+         *      valid until the writer is destroyed.
+         */
+        PngWriter(ImageSink& sink, PngMetadata info, PngTransform transform,
+                  const PngWriteOptions& options = {});
 
         PngWriter(PngWriter&& obj) noexcept;
 
@@ -33,16 +44,30 @@ namespace Yimage
 
         void write(const void* image, size_t size);
 
+        /**
+         * @brief Writes @a count rows of pixels.
+         *
+         * Interlaced images must be written with a single call that
+         * passes all the rows.
+         */
         void write_rows(const void* rows[], uint32_t count, size_t row_size);
 
+        /**
+         * @brief Writes a single row of pixels. Not available for
+         *      interlaced images.
+         */
         void write_row(const void* row, size_t size);
 
         void write_end();
     private:
+        void create(ImageSink& sink);
+
         void assert_is_valid() const;
 
+        std::unique_ptr<ImageSink> stream_sink_;
         PngMetadata metadata_;
         PngTransform transform_;
+        PngWriteOptions options_;
         png_structp png_ptr_ = nullptr;
         png_infop info_ptr_ = nullptr;
     };
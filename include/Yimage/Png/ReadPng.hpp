@@ -8,12 +8,41 @@
 #pragma once
 #include <filesystem>
 #include "../Image.hpp"
+#include "../ImageSource.hpp"
+#include "PngReadOptions.hpp"
 
 namespace Yimage
 {
-    [[nodiscard]] Image read_png(std::istream& stream);
+    [[nodiscard]] Image read_png(ImageSource& source,
+                                 const PngReadOptions& options = {});
 
-    [[nodiscard]] Image read_png(const std::filesystem::path& path);
+    [[nodiscard]] Image read_png(std::istream& stream,
+                                 const PngReadOptions& options = {});
 
-    [[nodiscard]] Image read_png(const void* buffer, size_t size);
+    [[nodiscard]] Image read_png(const std::filesystem::path& path,
+                                 const PngReadOptions& options = {});
+
+    [[nodiscard]] Image read_png(const void* buffer, size_t size,
+                                 const PngReadOptions& options = {});
+
+    /**
+     * @brief Reads a PNG image directly into @a dst.
+     *
+     * @a dst must have the size and pixel type that read_png would
+     * return for the same image, see probe_image. Rows are written
+     * in place, so @a dst can have gaps between its rows.
+     */
+    void read_png_into(ImageSource& source, const MutableImageView& dst,
+                       const PngReadOptions& options = {});
+
+    void read_png_into(std::istream& stream, const MutableImageView& dst,
+                       const PngReadOptions& options = {});
+
+    void read_png_into(const std::filesystem::path& path,
+                       const MutableImageView& dst,
+                       const PngReadOptions& options = {});
+
+    void read_png_into(const void* buffer, size_t size,
+                       const MutableImageView& dst,
+                       const PngReadOptions& options = {});
 }
@@ -7,23 +7,91 @@
 //****************************************************************************
 #pragma once
 #include <filesystem>
+#include "../ExecutionContext.hpp"
+#include "../ImageSink.hpp"
 #include "../ImageView.hpp"
+#include "../Pipeline.hpp"
 #include "PngMetadata.hpp"
 #include "PngTransform.hpp"
+#include "PngWriteOptions.hpp"
 
 namespace Yimage
 {
+    /**
+     * @brief Writes the rows in @a image with the format in @a options.
+     *
+     * Throws an exception if PngWriteOptions::quantize is set in
+     * @a write_options, as the pixels must already be in the format
+     * described by @a options.
+     */
     void write_png(std::ostream& stream,
                    const void* image, size_t image_size,
-                   PngMetadata options, PngTransform transform);
+                   PngMetadata options, PngTransform transform,
+                   const PngWriteOptions& write_options = {});
 
     void write_png(const std::filesystem::path& path,
                    const void* image, size_t image_size,
-                   PngMetadata info, PngTransform transform);
+                   PngMetadata info, PngTransform transform,
+                   const PngWriteOptions& write_options = {});
+
+    /**
+     * @brief Writes @a img to @a sink.
+     *
+     * Calls ImageSink::reserve with an estimate of the size of the PNG
+     * before anything is written.
+     *
+     * Large images are split into bands of rows that are filtered and
+     * compressed on separate threads, as many as @a context allows.
+     * The bands are compressed independently, which makes the file
+     * slightly larger than when it is written on a single thread.
+     * PngWriteOptions::buffer_size is ignored in this case.
+     *
+     * @param options Compression settings, see PngWriteOptions::fastest
+     *      and PngWriteOptions::smallest.
+     */
+    void write_png(ImageSink& sink, const ImageView& img,
+                   const PngWriteOptions& options = {},
+                   const ExecutionContext& context = default_execution_context());
 
     void write_png(std::ostream& stream,
-                   const ImageView& img);
+                   const ImageView& img,
+                   const PngWriteOptions& options = {},
+                   const ExecutionContext& context = default_execution_context());
+
+    /**
+     * @brief Appends @a img as a PNG image to @a buffer.
+     *
+     * Space is reserved in @a buffer in advance from an estimate of the
+     * size of the PNG, which is faster than writing to a
+     * std::ostringstream.
+     */
+    void write_png(std::vector<unsigned char>& buffer,
+                   const ImageView& img,
+                   const PngWriteOptions& options = {},
+                   const ExecutionContext& context = default_execution_context());
 
     void write_png(const std::filesystem::path& path,
-                   const ImageView& img);
+                   const ImageView& img,
+                   const PngWriteOptions& options = {},
+                   const ExecutionContext& context = default_execution_context());
+
+    /**
+     * @brief Runs @a pipeline and writes the result to @a stream as
+     *      it is produced, one band at a time.
+     *
+     * Interlaced images, and images that are quantized according to
+     * @a options, are produced in full first and then written like an
+     * ImageView, with as many threads as @a context allows.
+     */
+    void write_png(ImageSink& sink, Pipeline& pipeline,
+                   const PngWriteOptions& options = {},
+                   const ExecutionContext& context = default_execution_context());
+
+    void write_png(std::ostream& stream, Pipeline& pipeline,
+                   const PngWriteOptions& options = {},
+                   const ExecutionContext& context = default_execution_context());
+
+    void write_png(const std::filesystem::path& path, Pipeline& pipeline,
+                   const PngWriteOptions& options = {},
+                   const ExecutionContext& context = default_execution_context());
 }
@@ -0,0 +1,53 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-19.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <filesystem>
+#include "ImageMetadata.hpp"
+#include "ImageSource.hpp"
+#include "PixelType.hpp"
+
+namespace Yimage
+{
+    struct ImageInfo
+    {
+        ImageFormat format = ImageFormat::UNKNOWN;
+        size_t width = 0;
+        size_t height = 0;
+        /**
+         * @brief The pixel type of the image returned by read_image,
+         *      or NONE if read_image doesn't support the image.
+         */
+        PixelType pixel_type = PixelType::NONE;
+        /**
+         * @brief The colors of indexed images.
+         *
+         * probe_image leaves it empty, ImageReader fills it in for
+         * PNG images.
+         */
+        std::vector<Rgba8> palette = {};
+    };
+
+    bool operator==(const ImageInfo& a, const ImageInfo& b);
+
+    /**
+     * @brief Returns the format, size and pixel type of an image without
+     *      decoding it.
+     *
+     * Only the PNG IHDR chunk, the JPEG segments up to the first SOF
+     * marker or the first TIFF IFD are read. Throws an exception if the
+     * format is unrecognized or the header is incomplete.
+     */
+    [[nodiscard]]
+    ImageInfo probe_image(ImageSource& source);
+
+    [[nodiscard]]
+    ImageInfo probe_image(const std::filesystem::path& path);
+
+    [[nodiscard]]
+    ImageInfo probe_image(const void* buffer, size_t size);
+}
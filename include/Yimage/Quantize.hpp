@@ -0,0 +1,103 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-19.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <vector>
+#include "Image.hpp"
+#include "TileScheduler.hpp"
+
+namespace Yimage
+{
+    enum class DitherMethod
+    {
+        NONE,
+        /**
+         * @brief Adds an 8x8 Bayer pattern to the colors. The rows are
+         *      independent of each other, and the result doesn't change
+         *      with the number of threads.
+         */
+        ORDERED,
+        /**
+         * @brief Spreads the error of each pixel to its neighbors. Each
+         *      thread dithers a separate band of rows.
+         */
+        FLOYD_STEINBERG
+    };
+
+    class QuantizeOptions
+    {
+    public:
+        [[nodiscard]]
+        size_t max_colors() const;
+
+        /**
+         * @brief Sets the maximum number of colors in the palette, from
+         *      2 to 256. The default is 256.
+         */
+        QuantizeOptions& max_colors(size_t value);
+
+        [[nodiscard]]
+        DitherMethod dither() const;
+
+        /**
+         * @brief Sets how the colors that aren't in the palette are
+         *      approximated. The default is DitherMethod::NONE.
+         *
+         * Images with no more colors than the palette can hold are
+         * never dithered.
+         */
+        QuantizeOptions& dither(DitherMethod value);
+    private:
+        size_t max_colors_ = 256;
+        DitherMethod dither_ = DitherMethod::NONE;
+    };
+
+    /**
+     * @brief Returns a palette with at most @a max_colors colors that
+     *      approximates the colors in @a src.
+     *
+     * If @a src has no more than @a max_colors different colors, the
+     * palette contains exactly those colors. Otherwise the palette is
+     * made with the median cut algorithm. The colors with the lowest
+     * alpha values come first in the palette, which keeps PNG's tRNS
+     * chunk short.
+     */
+    [[nodiscard]]
+    std::vector<Rgba8> make_palette(const ImageView& src,
+                                    size_t max_colors = 256,
+                                    const ExecutionContext& context
+                                        = default_execution_context());
+
+    /**
+     * @brief Replaces each pixel in @a src with the index of the nearest
+     *      color in @a palette.
+     *
+     * @a dst must have the same width and height as @a src, and one of
+     * the indexed pixel types with room for all the indices in
+     * @a palette. The palette isn't added to @a dst's metadata.
+     */
+    void remap_to_palette(const ImageView& src,
+                          const std::vector<Rgba8>& palette,
+                          const MutableImageView& dst,
+                          DitherMethod dither = DitherMethod::NONE,
+                          const ExecutionContext& context
+                              = default_execution_context());
+
+    /**
+     * @brief Returns an indexed image with the colors in @a src reduced
+     *      to a palette of at most options.max_colors() colors.
+     *
+     * The palette is stored in the image's metadata. The pixel type is
+     * the smallest indexed type that can hold the palette and where the
+     * rows end on a byte boundary.
+     */
+    [[nodiscard]]
+    Image quantize(const ImageView& src,
+                   const QuantizeOptions& options = {},
+                   const ExecutionContext& context
+                       = default_execution_context());
+}
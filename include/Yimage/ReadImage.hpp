@@ -8,6 +8,8 @@
 #pragma once
 #include <filesystem>
 #include "Image.hpp"
+#include "ImageReadOptions.hpp"
+#include "ImageSource.hpp"
 
 namespace Yimage
 {
@@ -24,7 +26,33 @@ namespace Yimage
      */
     [[nodiscard]] ImageFormat get_image_format(const void* buffer, size_t size);
 
-    [[nodiscard]] Image read_image(const std::filesystem::path& path);
+    /**
+     * @brief Determines the image format from the signature at the
+     *      start of @a source.
+     */
+    [[nodiscard]] ImageFormat get_image_format(ImageSource& source);
+
+    [[nodiscard]] Image read_image(ImageSource& source,
+                                   const ImageReadOptions& options = {});
+
+    [[nodiscard]] Image read_image(const std::filesystem::path& path,
+                                   const ImageReadOptions& options = {});
+
+    [[nodiscard]] Image read_image(const void* buffer, size_t size,
+                                   const ImageReadOptions& options = {});
+
+    /**
+     * @brief Decodes an image directly into @a dst.
+     *
+     * @a dst must have the size and pixel type that read_image would
+     * return for the same image, see probe_image. Rows are written in
+     * place, which means that @a dst can be a subimage of a larger image.
+     */
+    void read_image_into(ImageSource& source, const MutableImageView& dst);
+
+    void read_image_into(const std::filesystem::path& path,
+                         const MutableImageView& dst);
 
-    [[nodiscard]] Image read_image(const void* buffer, size_t size);
+    void read_image_into(const void* buffer, size_t size,
+                         const MutableImageView& dst);
 }
@@ -8,10 +8,20 @@
 #pragma once
 #include <iosfwd>
 #include "../Image.hpp"
+#include "../ImageSource.hpp"
 #include "TiffMetadata.hpp"
 
 namespace Yimage
 {
+    /**
+     * @brief Reads a TIFF image from @a source.
+     *
+     * @param path The name of the source. Used for error messages.
+     */
+    [[nodiscard]] Image
+    read_tiff(ImageSource& source,
+              const std::filesystem::path& path = "TIFF stream");
+
     /**
      * @brief Reads a TIFF image from a stream.
      *
@@ -27,6 +37,25 @@ namespace Yimage
 
     [[nodiscard]] Image read_tiff(const void* buffer, size_t size);
 
+    /**
+     * @brief Reads a TIFF image from a stream directly into @a dst.
+     *
+     * @a dst must have the size and pixel type that read_tiff would
+     * return for the same image, see probe_image. Rows are written
+     * in place, so @a dst can have gaps between its rows.
+     */
+    void read_tiff_into(ImageSource& source, const MutableImageView& dst,
+                        const std::filesystem::path& path = "TIFF stream");
+
+    void read_tiff_into(std::istream& stream, const MutableImageView& dst,
+                        const std::filesystem::path& path = "TIFF stream");
+
+    void read_tiff_into(const std::filesystem::path& path,
+                        const MutableImageView& dst);
+
+    void read_tiff_into(const void* buffer, size_t size,
+                        const MutableImageView& dst);
+
     [[nodiscard]] std::unique_ptr<TiffMetadata>
     read_tiff_metadata(const std::filesystem::path& path);
 }
@@ -0,0 +1,51 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-19.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <memory>
+#include "../Image.hpp"
+#include "../ImageSource.hpp"
+
+namespace Yimage
+{
+    /**
+     * @brief Decodes TIFF images and keeps the buffers for strips and
+     *      tiles for the next image.
+     *
+     * libtiff can not reuse a TIFF handle for a different file, so
+     * only Yimage's own buffers are kept. A decoder can not be used
+     * by several threads at the same time.
+     */
+    class TiffDecoder
+    {
+    public:
+        TiffDecoder();
+
+        TiffDecoder(TiffDecoder&& rhs) noexcept;
+
+        ~TiffDecoder();
+
+        TiffDecoder& operator=(TiffDecoder&& rhs) noexcept;
+
+        [[nodiscard]]
+        Image read(ImageSource& source);
+
+        [[nodiscard]]
+        Image read(const void* buffer, size_t size);
+
+        /**
+         * @brief Reads a TIFF image directly into @a dst, see read_tiff_into.
+         */
+        void read_into(ImageSource& source, const MutableImageView& dst);
+
+        void read_into(const void* buffer, size_t size,
+                       const MutableImageView& dst);
+    private:
+        struct Data;
+        std::unique_ptr<Data> data_;
+    };
+}
@@ -0,0 +1,70 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-19.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <functional>
+#include <vector>
+#include "ExecutionContext.hpp"
+#include "MutableImageView.hpp"
+
+namespace Yimage
+{
+    struct ImageRegion
+    {
+        size_t x = 0;
+        size_t y = 0;
+        size_t width = 0;
+        size_t height = 0;
+    };
+
+    bool operator==(const ImageRegion& a, const ImageRegion& b);
+
+    /**
+     * @brief Splits an image into tiles of approximately @a grain_size
+     *      bytes.
+     *
+     * Tiles span the full width of the image unless a few rows are larger
+     * than @a grain_size. The x-coordinate of every tile is a multiple of 8,
+     * which means that tiles always start on a byte boundary.
+     *
+     * @param pixel_size The pixel size in bits.
+     */
+    [[nodiscard]]
+    std::vector<ImageRegion> make_tiles(size_t width, size_t height,
+                                        size_t pixel_size,
+                                        size_t grain_size = 0);
+
+    /**
+     * @brief Calls @a kernel for each tile in an image of the given size.
+     *
+     * The kernel is called concurrently from several threads and must
+     * not modify pixels outside its own tile. The tile size is determined
+     * by the grain size and parallelism hint in @a context.
+     */
+    void for_each_tile(size_t width, size_t height, size_t pixel_size,
+                       const std::function<void(const ImageRegion&)>& kernel,
+                       const ExecutionContext& context
+                           = default_execution_context());
+
+    void for_each_tile(const MutableImageView& image,
+                       const std::function<void(const MutableImageView&)>& kernel,
+                       const ExecutionContext& context
+                           = default_execution_context());
+
+    /**
+     * @brief Calls @a kernel with corresponding tiles of @a src and @a dst.
+     *
+     * @a src and @a dst must have the same width and height, but can have
+     * different pixel types.
+     */
+    void for_each_tile(const ImageView& src,
+                       const MutableImageView& dst,
+                       const std::function<void(const ImageView&,
+                                                const MutableImageView&)>& kernel,
+                       const ExecutionContext& context
+                           = default_execution_context());
+}
@@ -0,0 +1,77 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-19.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <filesystem>
+#include <iosfwd>
+#include "ImageSink.hpp"
+#include "ImageView.hpp"
+#include "Pipeline.hpp"
+#include "Png/PngWriteOptions.hpp"
+
+namespace Yimage
+{
+    /**
+     * @brief Determines the image format from the extension of @a path.
+     * @return The image format or UNKNOWN if the extension
+     *      is unrecognized.
+     */
+    [[nodiscard]]
+    ImageFormat get_image_format_from_extension(const std::filesystem::path& path);
+
+    /**
+     * @brief Writes @a image to @a path in the format given by
+     *      the extension of @a path.
+     */
+    void write_image(const std::filesystem::path& path,
+                     const ImageView& image);
+
+    /**
+     * @brief Writes @a image to @a path in the given format, or the
+     *      format given by the extension of @a path if @a format
+     *      is UNKNOWN.
+     *
+     * @param png_options The compression and quantize settings used
+     *      if the image is written as PNG.
+     */
+    void write_image(const std::filesystem::path& path,
+                     const ImageView& image,
+                     ImageFormat format,
+                     const PngWriteOptions& png_options = {});
+
+    void write_image(std::ostream& stream,
+                     const ImageView& image,
+                     ImageFormat format,
+                     const PngWriteOptions& png_options = {});
+
+    void write_image(ImageSink& sink,
+                     const ImageView& image,
+                     ImageFormat format,
+                     const PngWriteOptions& png_options = {});
+
+    /**
+     * @brief Runs @a pipeline and writes the result to @a path as
+     *      it is produced, one band at a time.
+     *
+     * If the result is quantized according to @a png_options, the
+     * entire image is produced before it is written.
+     */
+    void write_image(const std::filesystem::path& path,
+                     Pipeline& pipeline,
+                     ImageFormat format = ImageFormat::UNKNOWN,
+                     const PngWriteOptions& png_options = {});
+
+    void write_image(std::ostream& stream,
+                     Pipeline& pipeline,
+                     ImageFormat format,
+                     const PngWriteOptions& png_options = {});
+
+    void write_image(ImageSink& sink,
+                     Pipeline& pipeline,
+                     ImageFormat format,
+                     const PngWriteOptions& png_options = {});
+}
@@ -7,9 +7,26 @@
 //****************************************************************************
 #pragma once
 
+#include "AsyncImage.hpp"
+#include "BatchDecoder.hpp"
 #include "ImageAlgorithms.hpp"
+#include "ImagePyramid.hpp"
+#include "ImageReadOptions.hpp"
+#include "ImageReader.hpp"
+#include "ImageSink.hpp"
+#include "ImageSource.hpp"
+#include "ImageWriter.hpp"
+#include "Pipeline.hpp"
+#include "ProbeImage.hpp"
+#include "Quantize.hpp"
 #include "ReadImage.hpp"
+#include "WriteImage.hpp"
+#include "Jpeg/JpegDecoder.hpp"
+#include "Jpeg/JpegReadOptions.hpp"
 #include "Jpeg/ReadJpeg.hpp"
+#include "Png/PngDecoder.hpp"
+#include "Png/PngPushDecoder.hpp"
+#include "Png/PngReadOptions.hpp"
 #include "Png/ReadPng.hpp"
 #include "Png/WritePng.hpp"
 #include "YimageException.hpp"
@@ -0,0 +1,200 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-19.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "Yimage/AsyncImage.hpp"
+
+#include <algorithm>
+#include "Yimage/ImageReader.hpp"
+#include "Yimage/ImageSink.hpp"
+#include "Yimage/Png/WritePng.hpp"
+#include "ThreadPool.hpp"
+
+namespace Yimage
+{
+    namespace
+    {
+        /**
+         * @brief The approximate number of bytes decoded or encoded
+         *      between each check of the stop token.
+         */
+        constexpr size_t BAND_SIZE = 1024 * 1024;
+
+        size_t get_band_height(const ImageInfo& info)
+        {
+            auto row_size = (info.width * get_pixel_size(info.pixel_type) + 7) / 8;
+            return std::max<size_t>(BAND_SIZE / std::max<size_t>(row_size, 1), 1);
+        }
+
+        void throw_if_stop_requested(const std::stop_token& stop_token)
+        {
+            if (stop_token.stop_requested())
+                throw OperationCancelled("The operation was cancelled.");
+        }
+
+        template <typename T, typename Func>
+        AsyncTask<T> run_async(Func func, const ExecutionContext& context)
+        {
+            auto state = std::make_shared<Detail::AsyncState<T>>();
+            submit_task(context, [state, func = std::move(func)]() mutable
+            {
+                state->run(func);
+            });
+            return AsyncTask<T>(std::move(state));
+        }
+
+        /**
+         * @brief Returns the default execution context, with its
+         *      executor replaced by @a executor if it isn't empty.
+         */
+        ExecutionContext get_context(const Executor& executor)
+        {
+            auto context = default_execution_context();
+            if (executor)
+                context.executor(executor);
+            return context;
+        }
+
+        Image read_image(ImageReader& reader, const std::stop_token& stop_token)
+        {
+            auto& info = reader.info();
+            Image image(info.pixel_type, info.width, info.height);
+            auto band_height = get_band_height(info);
+            for (size_t y = 0; y < info.height; y += band_height)
+            {
+                throw_if_stop_requested(stop_token);
+                auto rows = std::min(band_height, info.height - y);
+                reader.read_rows(image.mutable_subimage(0, y, info.width, rows));
+            }
+            auto metadata = std::make_unique<ImageMetadata>(info.format);
+            metadata->palette = info.palette;
+            image.set_metadata(std::move(metadata));
+            return image;
+        }
+
+        /**
+         * @brief A sink that fails with OperationCancelled when stop is
+         *      requested, which stops write_png between two writes.
+         */
+        class StoppableSink : public ImageSink
+        {
+        public:
+            StoppableSink(ImageSink& sink, std::stop_token stop_token)
+                : sink_(sink),
+                  stop_token_(std::move(stop_token))
+            {}
+
+            void write(const void* data, size_t size) override
+            {
+                throw_if_stop_requested(stop_token_);
+                sink_.write(data, size);
+            }
+
+            void flush() override
+            {
+                sink_.flush();
+            }
+
+            void reserve(size_t size) override
+            {
+                sink_.reserve(size);
+            }
+        private:
+            ImageSink& sink_;
+            std::stop_token stop_token_;
+        };
+
+        void write_png(ImageSink& sink, const ImageView& image,
+                       const PngWriteOptions& options,
+                       const ExecutionContext& context,
+                       const std::stop_token& stop_token)
+        {
+            throw_if_stop_requested(stop_token);
+            StoppableSink stoppable_sink(sink, stop_token);
+            try
+            {
+                Yimage::write_png(stoppable_sink, image, options, context);
+            }
+            catch (const YimageException&)
+            {
+                // The PNG writer reports sink errors with its own
+                // exception, the cancellation must be detected here.
+                throw_if_stop_requested(stop_token);
+                throw;
+            }
+        }
+    }
+
+    AsyncTask<Image> async_read_image(std::filesystem::path path,
+                                      const Executor& executor,
+                                      std::stop_token stop_token)
+    {
+        return run_async<Image>(
+            [path = std::move(path), stop_token]
+            {
+                throw_if_stop_requested(stop_token);
+                ImageReader reader(path);
+                auto image = read_image(reader, stop_token);
+                image.metadata()->path = path;
+                return image;
+            },
+            get_context(executor));
+    }
+
+    AsyncTask<Image> async_read_image(const void* buffer, size_t size,
+                                      const Executor& executor,
+                                      std::stop_token stop_token)
+    {
+        return run_async<Image>(
+            [buffer, size, stop_token]
+            {
+                throw_if_stop_requested(stop_token);
+                ImageReader reader(buffer, size);
+                return read_image(reader, stop_token);
+            },
+            get_context(executor));
+    }
+
+    AsyncTask<void> async_write_png(std::filesystem::path path,
+                                    const ImageView& image,
+                                    const PngWriteOptions& options,
+                                    const ExecutionContext& context,
+                                    std::stop_token stop_token)
+    {
+        return run_async<void>(
+            [path = std::move(path), image, options, context, stop_token]
+            {
+                throw_if_stop_requested(stop_token);
+                try
+                {
+                    FileSink sink(path);
+                    write_png(sink, image, options, context, stop_token);
+                }
+                catch (const OperationCancelled&)
+                {
+                    std::error_code ec;
+                    std::filesystem::remove(path, ec);
+                    throw;
+                }
+            },
+            context);
+    }
+
+    AsyncTask<void> async_write_png(std::ostream& stream,
+                                    const ImageView& image,
+                                    const PngWriteOptions& options,
+                                    const ExecutionContext& context,
+                                    std::stop_token stop_token)
+    {
+        return run_async<void>(
+            [&stream, image, options, context, stop_token]
+            {
+                StreamSink sink(stream);
+                write_png(sink, image, options, context, stop_token);
+            },
+            context);
+    }
+}
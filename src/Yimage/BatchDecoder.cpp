@@ -0,0 +1,230 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-19.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "Yimage/BatchDecoder.hpp"
+
+#include <algorithm>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include "Yimage/ReadImage.hpp"
+#include "ThreadPool.hpp"
+
+namespace Yimage
+{
+    size_t BatchDecoderOptions::max_pending() const
+    {
+        return max_pending_;
+    }
+
+    BatchDecoderOptions& BatchDecoderOptions::max_pending(size_t value)
+    {
+        max_pending_ = value;
+        return *this;
+    }
+
+    bool BatchDecoderOptions::ordered() const
+    {
+        return ordered_;
+    }
+
+    BatchDecoderOptions& BatchDecoderOptions::ordered(bool value)
+    {
+        ordered_ = value;
+        return *this;
+    }
+
+    struct BatchDecoder::Data
+    {
+        Data(std::vector<std::filesystem::path> paths,
+             std::vector<std::pair<const void*, size_t>> buffers,
+             const BatchDecoderOptions& options,
+             const ExecutionContext& context)
+            : paths(std::move(paths)),
+              buffers(std::move(buffers)),
+              count(this->paths.size() + this->buffers.size()),
+              ordered(options.ordered()),
+              context(context)
+        {
+            // Without an executor, the tasks run on the internal pool,
+            // and the calling thread doesn't take part.
+            max_tasks = std::max<size_t>(context.max_threads(), 1);
+            if (!context.executor())
+                max_tasks = std::min(max_tasks, get_thread_pool().thread_count());
+            max_pending = options.max_pending();
+            if (max_pending == 0)
+                max_pending = 2 * max_tasks;
+
+            start_tasks();
+        }
+
+        ~Data()
+        {
+            std::unique_lock lock(mutex);
+            stop = true;
+            task_condition.wait(lock, [this] {return active_tasks == 0;});
+        }
+
+        /**
+         * @brief Submits new tasks if there are images that can be
+         *      started and fewer than max_tasks tasks are running.
+         */
+        void start_tasks()
+        {
+            size_t new_tasks = 0;
+            {
+                std::lock_guard lock(mutex);
+                auto available = std::min(count - next_read,
+                                          max_pending - std::min(pending, max_pending));
+                while (active_tasks < max_tasks && new_tasks < available)
+                {
+                    ++active_tasks;
+                    ++new_tasks;
+                }
+            }
+
+            // The executor may run the task on this thread, so the mutex
+            // can't be locked here.
+            for (size_t i = 0; i < new_tasks; ++i)
+                submit_task(context, [this] {run_task();});
+        }
+
+        /**
+         * @brief Decodes images until they are all started or
+         *      max_pending images are waiting to be delivered.
+         */
+        void run_task()
+        {
+            while (true)
+            {
+                size_t index;
+                {
+                    std::lock_guard lock(mutex);
+                    if (stop || next_read == count || pending >= max_pending)
+                    {
+                        // Notify while the mutex is locked, the destructor
+                        // can destroy the condition as soon as it's unlocked.
+                        --active_tasks;
+                        task_condition.notify_all();
+                        return;
+                    }
+                    index = next_read++;
+                    ++pending;
+                }
+
+                add_result(decode(index));
+            }
+        }
+
+        BatchResult decode(size_t index)
+        {
+            BatchResult result;
+            result.index = index;
+            try
+            {
+                if (index < paths.size())
+                {
+                    result.image = read_image(paths[index]);
+                }
+                else
+                {
+                    auto [buffer, size] = buffers[index - paths.size()];
+                    result.image = read_image(buffer, size);
+                }
+            }
+            catch (...)
+            {
+                result.error = std::current_exception();
+            }
+            return result;
+        }
+
+        void add_result(BatchResult result)
+        {
+            {
+                std::lock_guard lock(mutex);
+                auto index = result.index;
+                results.emplace(index, std::move(result));
+            }
+            result_condition.notify_all();
+        }
+
+        std::optional<BatchResult> next()
+        {
+            std::unique_lock lock(mutex);
+            while (delivered != count)
+            {
+                auto it = ordered ? results.find(delivered) : results.begin();
+                if (it != results.end())
+                {
+                    auto result = std::move(it->second);
+                    results.erase(it);
+                    ++delivered;
+                    --pending;
+                    lock.unlock();
+                    start_tasks();
+                    return result;
+                }
+                result_condition.wait(lock);
+            }
+            return {};
+        }
+
+        std::vector<std::filesystem::path> paths;
+        std::vector<std::pair<const void*, size_t>> buffers;
+        size_t count;
+        bool ordered;
+        ExecutionContext context;
+        size_t max_tasks;
+        size_t max_pending;
+
+        std::mutex mutex;
+        std::condition_variable result_condition;
+        std::condition_variable task_condition;
+        std::map<size_t, BatchResult> results;
+        size_t next_read = 0;
+        // Images that have been started, but not yet delivered.
+        size_t pending = 0;
+        size_t delivered = 0;
+        size_t active_tasks = 0;
+        bool stop = false;
+    };
+
+    BatchDecoder::BatchDecoder(std::vector<std::filesystem::path> paths,
+                               const BatchDecoderOptions& options,
+                               const ExecutionContext& context)
+        : data_(std::make_unique<Data>(std::move(paths),
+                                       std::vector<std::pair<const void*, size_t>>(),
+                                       options, context))
+    {}
+
+    BatchDecoder::BatchDecoder(std::vector<std::pair<const void*, size_t>> buffers,
+                               const BatchDecoderOptions& options,
+                               const ExecutionContext& context)
+        : data_(std::make_unique<Data>(std::vector<std::filesystem::path>(),
+                                       std::move(buffers),
+                                       options, context))
+    {}
+
+    BatchDecoder::~BatchDecoder() = default;
+
+    size_t BatchDecoder::size() const
+    {
+        return data_->count;
+    }
+
+    std::optional<BatchResult> BatchDecoder::next()
+    {
+        return data_->next();
+    }
+
+    void BatchDecoder::run(const std::function<void(BatchResult&)>& callback)
+    {
+        while (auto result = next())
+            callback(*result);
+    }
+}
@@ -0,0 +1,50 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-19.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "ChannelLayout.hpp"
+
+#include <string>
+#include "Yimage/YimageException.hpp"
+
+namespace Yimage
+{
+    ChannelLayout get_channel_layout(PixelType type)
+    {
+        switch (type)
+        {
+        case PixelType::MONO_8:
+            return {1, SIZE_MAX, 8};
+        case PixelType::MONO_16:
+            return {1, SIZE_MAX, 16};
+        case PixelType::MONO_FLOAT_32:
+            return {1, SIZE_MAX, 32};
+        case PixelType::ALPHA_MONO_8:
+            return {2, 0, 8};
+        case PixelType::ALPHA_MONO_16:
+            return {2, 0, 16};
+        case PixelType::MONO_ALPHA_8:
+            return {2, 1, 8};
+        case PixelType::MONO_ALPHA_16:
+            return {2, 1, 16};
+        case PixelType::RGB_8:
+            return {3, SIZE_MAX, 8};
+        case PixelType::RGB_16:
+            return {3, SIZE_MAX, 16};
+        case PixelType::ARGB_8:
+            return {4, 0, 8};
+        case PixelType::ARGB_16:
+            return {4, 0, 16};
+        case PixelType::RGBA_8:
+            return {4, 3, 8};
+        case PixelType::RGBA_16:
+            return {4, 3, 16};
+        default:
+            YIMAGE_THROW("Unsupported pixel type: "
+                         + std::to_string(int(type)));
+        }
+    }
+}
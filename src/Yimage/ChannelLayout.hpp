@@ -0,0 +1,29 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-19.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <cstdint>
+#include "Yimage/PixelType.hpp"
+
+namespace Yimage
+{
+    struct ChannelLayout
+    {
+        size_t channels = 0;
+        size_t alpha_index = SIZE_MAX;
+        /**
+         * @brief The size of each channel in bits.
+         */
+        size_t channel_size = 0;
+    };
+
+    /**
+     * @brief Returns the channel layout of pixel types with at least
+     *      8 bits per channel. Throws an exception for other pixel types.
+     */
+    ChannelLayout get_channel_layout(PixelType type);
+}
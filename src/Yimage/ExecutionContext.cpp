@@ -0,0 +1,183 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-19.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "Yimage/ExecutionContext.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include "ThreadPool.hpp"
+
+namespace Yimage
+{
+    size_t ExecutionContext::thread_count() const
+    {
+        return thread_count_;
+    }
+
+    ExecutionContext& ExecutionContext::thread_count(size_t value)
+    {
+        thread_count_ = value;
+        return *this;
+    }
+
+    const Executor& ExecutionContext::executor() const
+    {
+        return executor_;
+    }
+
+    ExecutionContext& ExecutionContext::executor(Executor value)
+    {
+        executor_ = std::move(value);
+        return *this;
+    }
+
+    size_t ExecutionContext::grain_size() const
+    {
+        return grain_size_;
+    }
+
+    ExecutionContext& ExecutionContext::grain_size(size_t value)
+    {
+        grain_size_ = value;
+        return *this;
+    }
+
+    ParallelismHint ExecutionContext::parallelism() const
+    {
+        return parallelism_;
+    }
+
+    ExecutionContext& ExecutionContext::parallelism(ParallelismHint value)
+    {
+        parallelism_ = value;
+        return *this;
+    }
+
+    size_t ExecutionContext::max_threads() const
+    {
+        if (parallelism_ == ParallelismHint::SEQUENTIAL)
+            return 1;
+        if (thread_count_ != 0)
+            return thread_count_;
+        return std::max(std::thread::hardware_concurrency(), 1u);
+    }
+
+    namespace
+    {
+        std::mutex default_context_mutex;
+
+        ExecutionContext& get_default_context()
+        {
+            static ExecutionContext context;
+            return context;
+        }
+    }
+
+    ExecutionContext default_execution_context()
+    {
+        std::lock_guard lock(default_context_mutex);
+        return get_default_context();
+    }
+
+    void set_default_execution_context(ExecutionContext context)
+    {
+        std::lock_guard lock(default_context_mutex);
+        get_default_context() = std::move(context);
+    }
+
+    namespace
+    {
+        struct ParallelState
+        {
+            ParallelState(size_t count, std::function<void(size_t)> func)
+                : count(count),
+                  func(std::move(func))
+            {}
+
+            void run()
+            {
+                for (auto i = next++; i < count; i = next++)
+                {
+                    try
+                    {
+                        func(i);
+                    }
+                    catch (...)
+                    {
+                        std::lock_guard lock(mutex);
+                        if (!error)
+                            error = std::current_exception();
+                    }
+
+                    if (++done == count)
+                    {
+                        std::lock_guard lock(mutex);
+                        condition.notify_all();
+                    }
+                }
+            }
+
+            void wait()
+            {
+                std::unique_lock lock(mutex);
+                condition.wait(lock, [this] {return done == count;});
+            }
+
+            const size_t count;
+            std::function<void(size_t)> func;
+            std::atomic<size_t> next = 0;
+            std::atomic<size_t> done = 0;
+            std::mutex mutex;
+            std::condition_variable condition;
+            std::exception_ptr error;
+        };
+    }
+
+    void submit_task(const ExecutionContext& context,
+                     std::function<void()> task)
+    {
+        if (context.executor())
+            context.executor()(std::move(task));
+        else
+            get_thread_pool().submit(std::move(task));
+    }
+
+    void run_parallel(size_t count,
+                      const std::function<void(size_t)>& func,
+                      const ExecutionContext& context)
+    {
+        if (count == 0)
+            return;
+
+        auto threads = std::min(count, context.max_threads());
+        if (!context.executor())
+            threads = std::min(threads, get_thread_pool().thread_count() + 1);
+
+        if (threads <= 1)
+        {
+            for (size_t i = 0; i < count; ++i)
+                func(i);
+            return;
+        }
+
+        // Helpers that start after all indices have been taken return
+        // immediately, but they still need the state to be alive.
+        auto state = std::make_shared<ParallelState>(count, func);
+        for (size_t i = 1; i < threads; ++i)
+            submit_task(context, [state] {state->run();});
+
+        state->run();
+        state->wait();
+
+        if (state->error)
+            std::rethrow_exception(state->error);
+    }
+}
@@ -8,20 +8,153 @@
 #include "Yimage/ImageAlgorithms.hpp"
 
 #include <algorithm>
+#include <cstring>
 #include <vector>
 #include "ColorBytes.hpp"
 #include "Yimage/YimageException.hpp"
 
 namespace Yimage
 {
-    void fill_rgba8(const MutableImageView& image, Rgba8 rgba)
+    namespace
     {
-        fill_rgba8(image, &rgba, 1);
+        void fill_pattern(const std::vector<uint8_t>& pattern, size_t offset,
+                          unsigned char* beg, unsigned char* end)
+        {
+            auto src_it = pattern.begin() + ptrdiff_t(offset);
+            while (std::distance(src_it, pattern.end())
+                   <= std::distance(beg, end))
+            {
+                beg = std::copy(src_it, pattern.end(), beg);
+                src_it = pattern.begin();
+            }
+            std::copy(src_it, src_it + (end - beg), beg);
+        }
+
+        void copy_pixels(const ImageView& src, const MutableImageView& dst)
+        {
+            if (src.is_contiguous() && dst.is_contiguous())
+            {
+                std::copy(src.data(), src.data() + src.size(), dst.data());
+                return;
+            }
+
+            for (size_t i = 0; i < src.height(); ++i)
+            {
+                auto [i_b, i_e] = src.row(i);
+                auto [m_b, m_e] = dst.row(i);
+                std::copy(i_b, i_e, m_b);
+            }
+        }
+
+        /**
+         * @brief The destination bytes of all 256 possible indices.
+         */
+        struct PaletteTable
+        {
+            PaletteTable(const Rgba8* palette, size_t palette_size,
+                         PixelType pixel_type)
+            {
+                pixel_size = get_color_bytes(Rgba8(), pixel_type).size;
+                bytes.resize(256 * pixel_size);
+                for (size_t i = 0; i < 256; ++i)
+                {
+                    auto color = i < palette_size ? palette[i] : Rgba8();
+                    auto cb = get_color_bytes(color, pixel_type);
+                    std::copy(cb.bytes, cb.bytes + cb.size,
+                              bytes.data() + i * pixel_size);
+                }
+            }
+
+            std::vector<uint8_t> bytes;
+            size_t pixel_size = 0;
+        };
+
+        /**
+         * @brief Expands @a count pixels starting at pixel @a x in @a src.
+         *
+         * Pixels narrower than a byte are packed with the leftmost pixel
+         * in the most significant bits. PIXEL_SIZE is the size of the
+         * destination pixels, or 0 if it's only known at runtime.
+         */
+        template <size_t BITS, size_t PIXEL_SIZE>
+        void expand_indices(const uint8_t* src, size_t x, size_t count,
+                            const PaletteTable& table, uint8_t* dst)
+        {
+            constexpr size_t PER_BYTE = 8 / BITS;
+            constexpr unsigned MASK = (1u << BITS) - 1;
+            const auto pixel_size = PIXEL_SIZE ? PIXEL_SIZE : table.pixel_size;
+            const auto* lut = table.bytes.data();
+
+            auto put = [&](unsigned index)
+            {
+                std::memcpy(dst, lut + index * pixel_size,
+                            PIXEL_SIZE ? PIXEL_SIZE : pixel_size);
+                dst += pixel_size;
+            };
+
+            if constexpr (BITS == 8)
+            {
+                for (size_t i = 0; i < count; ++i)
+                    put(src[x + i]);
+            }
+            else
+            {
+                src += x / PER_BYTE;
+                if (auto first = x % PER_BYTE; first != 0)
+                {
+                    // The region starts in the middle of a byte.
+                    auto n = std::min(count, PER_BYTE - first);
+                    for (size_t i = first; i < first + n; ++i)
+                        put((*src >> (8 - BITS - i * BITS)) & MASK);
+                    ++src;
+                    count -= n;
+                }
+                for (; count >= PER_BYTE; count -= PER_BYTE)
+                {
+                    const unsigned byte = *src++;
+                    for (unsigned i = 0; i < PER_BYTE; ++i)
+                        put((byte >> (8 - BITS - i * BITS)) & MASK);
+                }
+                for (size_t i = 0; i < count; ++i)
+                    put((*src >> (8 - BITS - i * BITS)) & MASK);
+            }
+        }
+
+        template <size_t BITS>
+        void expand_region(const ImageView& src, const PaletteTable& table,
+                           const MutableImageView& dst, const ImageRegion& r)
+        {
+            for (size_t y = r.y; y < r.y + r.height; ++y)
+            {
+                auto src_row = src.row(y).first;
+                auto dst_ptr = dst.pixel_pointer(r.x, y);
+                switch (table.pixel_size)
+                {
+                case 3:
+                    expand_indices<BITS, 3>(src_row, r.x, r.width, table, dst_ptr);
+                    break;
+                case 4:
+                    expand_indices<BITS, 4>(src_row, r.x, r.width, table, dst_ptr);
+                    break;
+                default:
+                    expand_indices<BITS, 0>(src_row, r.x, r.width, table, dst_ptr);
+                    break;
+                }
+            }
+        }
+    }
+
+    void fill_rgba8(const MutableImageView& image, Rgba8 rgba,
+                    const ExecutionContext& context)
+    {
+        fill_rgba8(image, &rgba, 1, context);
     }
 
-    void fill_rgba8(const MutableImageView& image, const Rgba8* rgba, size_t num_rgba)
+    void fill_rgba8(const MutableImageView& image,
+                    const Rgba8* rgba, size_t num_rgba,
+                    const ExecutionContext& context)
     {
-        if (!image)
+        if (!image || num_rgba == 0)
             return;
 
         std::vector<uint8_t> bytes;
@@ -31,42 +164,50 @@ namespace Yimage
             bytes.insert(bytes.end(), cb.bytes, cb.bytes + cb.size);
         }
 
-        auto src_it = bytes.begin();
-        for (size_t y = 0; y < image.height(); ++y)
-        {
-            auto [beg, end] = image.row(y);
-            while (std::distance(src_it, bytes.end())
-                   <= std::distance(beg, end))
-            {
-                beg = std::copy(src_it, bytes.end(), beg);
-                src_it = bytes.begin();
-            }
-            if (beg != end)
+        // The colors are repeated as if the rows had no gaps between them,
+        // i.e. the color at the start of each tile row depends on its
+        // distance from the first pixel in the image.
+        const auto pixel_size = image.pixel_size() / 8;
+        const auto row_size = image.width() * pixel_size;
+        for_each_tile(
+            image.width(), image.height(), image.pixel_size(),
+            [&](const ImageRegion& r)
             {
-                std::copy(src_it, src_it + (end - beg), beg);
-                std::advance(src_it, end - beg);
-            }
-        }
+                for (size_t y = r.y; y < r.y + r.height; ++y)
+                {
+                    auto offset = (y * row_size + r.x * pixel_size)
+                                  % bytes.size();
+                    auto beg = image.pixel_pointer(r.x, y);
+                    fill_pattern(bytes, offset, beg, beg + r.width * pixel_size);
+                }
+            },
+            context);
     }
 
-    void flip_vertically(MutableImageView image)
+    void flip_vertically(MutableImageView image, const ExecutionContext& context)
     {
         if (image.height() <= 1)
             return;
 
-        std::vector<unsigned char> buffer(image.row_size());
-        auto buf_beg = buffer.data();
-        for (size_t i = 0, n = image.height(); i < n / 2; ++i)
-        {
-            auto [src_beg, src_end] = image.row(i);
-            auto buf_end = std::copy(src_beg, src_end, buf_beg);
-            auto [btm_beg, btm_end] = image.row(n - i - 1);
-            std::copy(btm_beg, btm_end, src_beg);
-            std::copy(buf_beg, buf_end, btm_beg);
-        }
+        const auto n = image.height();
+        for_each_tile(
+            image.width(), n / 2, image.pixel_size(),
+            [&](const ImageRegion& r)
+            {
+                auto first = r.x * image.pixel_size() / 8;
+                auto last = (r.x + r.width) * image.pixel_size() / 8;
+                for (size_t y = r.y; y < r.y + r.height; ++y)
+                {
+                    auto top = image.row(y).first;
+                    auto bottom = image.row(n - y - 1).first;
+                    std::swap_ranges(top + first, top + last, bottom + first);
+                }
+            },
+            context);
     }
 
-    void paste(ImageView src, MutableImageView dst, ptrdiff_t x, ptrdiff_t y)
+    void paste(ImageView src, MutableImageView dst, ptrdiff_t x, ptrdiff_t y,
+               const ExecutionContext& context)
     {
         if (src.pixel_type() != dst.pixel_type())
             YIMAGE_THROW("Source and destination images can't have different pixel types.");
@@ -88,17 +229,53 @@ namespace Yimage
         src = src.subimage(0, 0, width, height);
         dst = dst.subimage(0, 0, width, height);
 
-        if (src.is_contiguous() && dst.is_contiguous())
-        {
-            std::copy(src.data(), src.data() + src.size(), dst.data());
+        for_each_tile(src, dst, copy_pixels, context);
+    }
+
+    void expand_palette(const ImageView& src, const MutableImageView& dst,
+                        const ExecutionContext& context)
+    {
+        auto metadata = src.metadata();
+        if (!metadata || metadata->palette.empty())
+            YIMAGE_THROW("The source image has no palette.");
+        expand_palette(src, metadata->palette.data(), metadata->palette.size(),
+                       dst, context);
+    }
+
+    void expand_palette(const ImageView& src,
+                        const Rgba8* palette, size_t palette_size,
+                        const MutableImageView& dst,
+                        const ExecutionContext& context)
+    {
+        if (!is_indexed(src.pixel_type()))
+            YIMAGE_THROW("The source image doesn't have an indexed pixel type.");
+        if (src.width() != dst.width() || src.height() != dst.height())
+            YIMAGE_THROW("Source and destination images must have the same size.");
+        if (!src)
             return;
-        }
 
-        for (size_t i = 0; i < src.height(); ++i)
+        const PaletteTable table(palette, palette_size, dst.pixel_type());
+        void (*expand)(const ImageView&, const PaletteTable&,
+                       const MutableImageView&, const ImageRegion&);
+        switch (src.pixel_type())
         {
-            auto [i_b, i_e] = src.row(i);
-            auto [m_b, m_e] = dst.row(i);
-            std::copy(i_b, i_e, m_b);
+        case PixelType::INDEXED_1: expand = expand_region<1>; break;
+        case PixelType::INDEXED_2: expand = expand_region<2>; break;
+        case PixelType::INDEXED_4: expand = expand_region<4>; break;
+        default: expand = expand_region<8>; break;
         }
+
+        for_each_tile(
+            dst.width(), dst.height(), dst.pixel_size(),
+            [&](const ImageRegion& r) {expand(src, table, dst, r);},
+            context);
+    }
+
+    Image expand_palette(const ImageView& src, PixelType pixel_type,
+                         const ExecutionContext& context)
+    {
+        Image image(pixel_type, src.width(), src.height());
+        expand_palette(src, image.mutable_view(), context);
+        return image;
     }
 }
@@ -0,0 +1,343 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-19.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "Yimage/ImagePyramid.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <string>
+#include "Yimage/ImageAlgorithms.hpp"
+#include "Yimage/YimageException.hpp"
+#include "ChannelLayout.hpp"
+
+namespace Yimage
+{
+    namespace
+    {
+        float srgb_to_linear(float value)
+        {
+            if (value <= 0.04045f)
+                return value / 12.92f;
+            return std::pow((value + 0.055f) / 1.055f, 2.4f);
+        }
+
+        float linear_to_srgb(float value)
+        {
+            if (value <= 0.0031308f)
+                return value * 12.92f;
+            return 1.055f * std::pow(value, 1.0f / 2.4f) - 0.055f;
+        }
+
+        constexpr size_t LINEAR_TO_SRGB8_STEPS = 16384;
+
+        struct Srgb8Tables
+        {
+            Srgb8Tables()
+            {
+                for (size_t i = 0; i < to_linear.size(); ++i)
+                    to_linear[i] = srgb_to_linear(float(i) / 255.0f);
+                for (size_t i = 0; i < to_srgb.size(); ++i)
+                {
+                    auto v = linear_to_srgb(float(i) / (to_srgb.size() - 1));
+                    to_srgb[i] = uint8_t(std::lround(v * 255.0f));
+                }
+            }
+
+            std::array<float, 256> to_linear;
+            std::array<uint8_t, LINEAR_TO_SRGB8_STEPS> to_srgb;
+        };
+
+        const Srgb8Tables& get_srgb8_tables()
+        {
+            static Srgb8Tables tables;
+            return tables;
+        }
+
+        template <typename T>
+        struct BoxAverage
+        {
+            T operator()(size_t, T a, T b, T c, T d) const
+            {
+                return T((uint32_t(a) + b + c + d + 2) / 4);
+            }
+        };
+
+        struct SrgbAverage8
+        {
+            uint8_t operator()(size_t channel,
+                               uint8_t a, uint8_t b,
+                               uint8_t c, uint8_t d) const
+            {
+                if (channel == alpha_index)
+                    return BoxAverage<uint8_t>()(channel, a, b, c, d);
+
+                auto& lin = tables.to_linear;
+                auto value = (lin[a] + lin[b] + lin[c] + lin[d]) * 0.25f;
+                auto steps = float(tables.to_srgb.size() - 1);
+                return tables.to_srgb[size_t(value * steps + 0.5f)];
+            }
+
+            const Srgb8Tables& tables;
+            size_t alpha_index;
+        };
+
+        struct SrgbAverage16
+        {
+            uint16_t operator()(size_t channel,
+                                uint16_t a, uint16_t b,
+                                uint16_t c, uint16_t d) const
+            {
+                if (channel == alpha_index)
+                    return BoxAverage<uint16_t>()(channel, a, b, c, d);
+
+                constexpr float MAX = 65535.0f;
+                auto value = (srgb_to_linear(a / MAX)
+                              + srgb_to_linear(b / MAX)
+                              + srgb_to_linear(c / MAX)
+                              + srgb_to_linear(d / MAX)) * 0.25f;
+                return uint16_t(std::lround(linear_to_srgb(value) * MAX));
+            }
+
+            size_t alpha_index;
+        };
+
+        struct FloatAverage
+        {
+            float operator()(size_t, float a, float b, float c, float d) const
+            {
+                float sum = 0;
+                int count = 0;
+                for (auto value : {a, b, c, d})
+                {
+                    if (std::isnan(value) || (no_data && value == *no_data))
+                        continue;
+                    sum += value;
+                    ++count;
+                }
+                if (count == 0)
+                    return no_data.value_or(std::numeric_limits<float>::quiet_NaN());
+                return sum / float(count);
+            }
+
+            std::optional<float> no_data;
+        };
+
+        /**
+         * @brief Averages 2x2 blocks in @a src into the pixels in
+         *      @a region of @a dst. The last row and column are repeated
+         *      when @a src has an odd width or height.
+         */
+        template <typename T, typename Average>
+        void downscale(const ImageView& src, const MutableImageView& dst,
+                       const ImageRegion& region,
+                       size_t channels, Average average)
+        {
+            const auto last_x = src.width() - 1;
+            const auto last_y = src.height() - 1;
+            for (size_t y = region.y; y < region.y + region.height; ++y)
+            {
+                auto row0 = reinterpret_cast<const T*>(
+                    src.row(std::min(2 * y, last_y)).first);
+                auto row1 = reinterpret_cast<const T*>(
+                    src.row(std::min(2 * y + 1, last_y)).first);
+                auto out = reinterpret_cast<T*>(dst.pixel_pointer(region.x, y));
+                for (size_t x = region.x; x < region.x + region.width; ++x)
+                {
+                    auto i0 = std::min(2 * x, last_x) * channels;
+                    auto i1 = std::min(2 * x + 1, last_x) * channels;
+                    for (size_t c = 0; c < channels; ++c)
+                    {
+                        *out++ = average(c, row0[i0 + c], row0[i1 + c],
+                                         row1[i0 + c], row1[i1 + c]);
+                    }
+                }
+            }
+        }
+
+        void downscale(const ImageView& src, const MutableImageView& dst,
+                       const ImageRegion& region,
+                       PyramidFilter filter, std::optional<float> no_data)
+        {
+            auto layout = get_channel_layout(src.pixel_type());
+            if (src.pixel_type() == PixelType::MONO_FLOAT_32)
+            {
+                downscale<float>(src, dst, region, layout.channels,
+                                 FloatAverage{no_data});
+            }
+            else if (layout.channel_size == 8)
+            {
+                if (filter == PyramidFilter::SRGB_BOX)
+                {
+                    downscale<uint8_t>(src, dst, region, layout.channels,
+                                       SrgbAverage8{get_srgb8_tables(),
+                                                    layout.alpha_index});
+                }
+                else
+                {
+                    downscale<uint8_t>(src, dst, region, layout.channels,
+                                       BoxAverage<uint8_t>());
+                }
+            }
+            else if (filter == PyramidFilter::SRGB_BOX)
+            {
+                downscale<uint16_t>(src, dst, region, layout.channels,
+                                    SrgbAverage16{layout.alpha_index});
+            }
+            else
+            {
+                downscale<uint16_t>(src, dst, region, layout.channels,
+                                    BoxAverage<uint16_t>());
+            }
+        }
+    }
+
+    ImagePyramid::ImagePyramid() = default;
+
+    ImagePyramid::ImagePyramid(PixelType pixel_type,
+                               size_t width, size_t height,
+                               size_t levels)
+        : pixel_type_(pixel_type)
+    {
+        auto pixel_size = get_pixel_size(pixel_type);
+        if (pixel_size % 8 != 0)
+            YIMAGE_THROW("Pixel sizes less than 8 bits are not supported.");
+
+        auto max_levels = get_max_pyramid_levels(width, height);
+        if (max_levels == 0)
+            YIMAGE_THROW("Image size is 0 bytes.");
+        if (levels == 0 || levels > max_levels)
+            levels = max_levels;
+
+        levels_.reserve(levels);
+        for (size_t i = 0; i < levels; ++i)
+        {
+            levels_.push_back({size_, width, height});
+            size_ += width * height * pixel_size / 8;
+            width = (width + 1) / 2;
+            height = (height + 1) / 2;
+        }
+        buffer_.reset(new unsigned char[size_]);
+    }
+
+    ImagePyramid::ImagePyramid(const ImagePyramid& rhs)
+        : pixel_type_(rhs.pixel_type_),
+          size_(rhs.size_),
+          levels_(rhs.levels_)
+    {
+        if (size_)
+        {
+            buffer_.reset(new unsigned char[size_]);
+            std::copy_n(rhs.data(), size_, data());
+        }
+    }
+
+    ImagePyramid::ImagePyramid(ImagePyramid&& rhs) noexcept = default;
+
+    ImagePyramid::~ImagePyramid() = default;
+
+    ImagePyramid& ImagePyramid::operator=(const ImagePyramid& rhs)
+    {
+        if (&rhs == this)
+            return *this;
+
+        *this = ImagePyramid(rhs);
+        return *this;
+    }
+
+    ImagePyramid& ImagePyramid::operator=(ImagePyramid&& rhs) noexcept = default;
+
+    ImagePyramid::operator bool() const
+    {
+        return bool(buffer_);
+    }
+
+    size_t ImagePyramid::level_count() const
+    {
+        return levels_.size();
+    }
+
+    ImageView ImagePyramid::level(size_t index) const
+    {
+        auto& level = levels_.at(index);
+        return {buffer_.get() + level.offset, pixel_type_,
+                level.width, level.height};
+    }
+
+    MutableImageView ImagePyramid::mutable_level(size_t index)
+    {
+        auto& level = levels_.at(index);
+        return {buffer_.get() + level.offset, pixel_type_,
+                level.width, level.height};
+    }
+
+    const unsigned char* ImagePyramid::data() const
+    {
+        return buffer_.get();
+    }
+
+    unsigned char* ImagePyramid::data()
+    {
+        return buffer_.get();
+    }
+
+    size_t ImagePyramid::size() const
+    {
+        return size_;
+    }
+
+    PixelType ImagePyramid::pixel_type() const
+    {
+        return pixel_type_;
+    }
+
+    size_t get_max_pyramid_levels(size_t width, size_t height)
+    {
+        if (width == 0 || height == 0)
+            return 0;
+
+        size_t levels = 1;
+        while (width > 1 || height > 1)
+        {
+            width = (width + 1) / 2;
+            height = (height + 1) / 2;
+            ++levels;
+        }
+        return levels;
+    }
+
+    ImagePyramid build_pyramid(const ImageView& image,
+                               size_t levels,
+                               PyramidFilter filter,
+                               std::optional<float> no_data,
+                               const ExecutionContext& context)
+    {
+        // Fail early for unsupported pixel types.
+        get_channel_layout(image.pixel_type());
+
+        ImagePyramid pyramid(image.pixel_type(),
+                             image.width(), image.height(),
+                             levels);
+        paste(image, pyramid.mutable_level(0), 0, 0, context);
+        for (size_t i = 1; i < pyramid.level_count(); ++i)
+        {
+            auto src = pyramid.level(i - 1);
+            auto dst = pyramid.mutable_level(i);
+            // The tiles are based on the source level as it's four times
+            // larger than the destination.
+            for_each_tile(
+                dst.width(), dst.height(), src.pixel_size() * 4,
+                [&](const ImageRegion& region)
+                {
+                    downscale(src, dst, region, filter, no_data);
+                },
+                context);
+        }
+        return pyramid;
+    }
+}
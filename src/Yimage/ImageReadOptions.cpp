@@ -0,0 +1,28 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-19.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "Yimage/ImageReadOptions.hpp"
+
+namespace Yimage
+{
+    size_t ImageReadOptions::min_width() const
+    {
+        return min_width_;
+    }
+
+    size_t ImageReadOptions::min_height() const
+    {
+        return min_height_;
+    }
+
+    ImageReadOptions& ImageReadOptions::min_size(size_t width, size_t height)
+    {
+        min_width_ = width;
+        min_height_ = height;
+        return *this;
+    }
+}
@@ -0,0 +1,122 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-19.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "Yimage/ImageReader.hpp"
+
+#include "Yimage/ReadImage.hpp"
+#include "Yimage/YimageException.hpp"
+#include "ImageReaderBackend.hpp"
+#include "YimageVersion.hpp"
+
+namespace Yimage
+{
+    namespace
+    {
+        std::unique_ptr<ImageReaderBackend>
+        make_backend(std::unique_ptr<ImageSource> source)
+        {
+            switch (get_image_format(*source))
+            {
+#ifdef YIMAGE_JPEG
+            case ImageFormat::JPEG:
+                return make_jpeg_reader_backend(std::move(source));
+#endif
+#ifdef YIMAGE_PNG
+            case ImageFormat::PNG:
+                return make_png_reader_backend(std::move(source));
+#endif
+#ifdef YIMAGE_TIFF
+            case ImageFormat::TIFF:
+                return make_tiff_reader_backend(std::move(source));
+#endif
+            case ImageFormat::UNKNOWN:
+            default:
+                YIMAGE_THROW("Unrecognized image format.");
+            }
+        }
+    }
+
+    ImageReader::ImageReader() = default;
+
+    ImageReader::ImageReader(const std::filesystem::path& path)
+    {
+        open(path);
+    }
+
+    ImageReader::ImageReader(const void* buffer, size_t size)
+    {
+        open(buffer, size);
+    }
+
+    ImageReader::ImageReader(std::unique_ptr<ImageSource> source)
+    {
+        open(std::move(source));
+    }
+
+    ImageReader::ImageReader(ImageReader&& rhs) noexcept = default;
+
+    ImageReader::~ImageReader() = default;
+
+    ImageReader& ImageReader::operator=(ImageReader&& rhs) noexcept = default;
+
+    ImageReader::operator bool() const
+    {
+        return bool(backend_);
+    }
+
+    void ImageReader::open(const std::filesystem::path& path)
+    {
+        open(open_image_source(path));
+    }
+
+    void ImageReader::open(const void* buffer, size_t size)
+    {
+        open(std::make_unique<MemorySource>(buffer, size));
+    }
+
+    void ImageReader::open(std::unique_ptr<ImageSource> source)
+    {
+        close();
+        backend_ = make_backend(std::move(source));
+    }
+
+    void ImageReader::close()
+    {
+        backend_.reset();
+        current_row_ = 0;
+    }
+
+    const ImageInfo& ImageReader::info() const
+    {
+        if (!backend_)
+            YIMAGE_THROW("The image reader isn't open.");
+        return backend_->info();
+    }
+
+    size_t ImageReader::current_row() const
+    {
+        return current_row_;
+    }
+
+    void ImageReader::read_rows(const MutableImageView& band)
+    {
+        auto& image_info = info();
+        if (band.width() != image_info.width
+            || band.pixel_type() != image_info.pixel_type)
+        {
+            YIMAGE_THROW("The band must have the same width and pixel type as the image.");
+        }
+        if (band.height() > image_info.height - current_row_)
+            YIMAGE_THROW("Attempt to read past the end of the image.");
+
+        if (band.height() == 0)
+            return;
+
+        backend_->read_rows(band);
+        current_row_ += band.height();
+    }
+}
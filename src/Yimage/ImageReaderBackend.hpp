@@ -0,0 +1,41 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-19.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <memory>
+#include "Yimage/ImageSource.hpp"
+#include "Yimage/MutableImageView.hpp"
+#include "Yimage/ProbeImage.hpp"
+
+namespace Yimage
+{
+    class ImageReaderBackend
+    {
+    public:
+        virtual ~ImageReaderBackend() = default;
+
+        [[nodiscard]]
+        virtual const ImageInfo& info() const = 0;
+
+        /**
+         * @brief Decodes the next band.height() rows into @a band.
+         *
+         * ImageReader has already verified that @a band matches the
+         * image and that there are enough rows left.
+         */
+        virtual void read_rows(const MutableImageView& band) = 0;
+    };
+
+    std::unique_ptr<ImageReaderBackend>
+    make_png_reader_backend(std::unique_ptr<ImageSource> source);
+
+    std::unique_ptr<ImageReaderBackend>
+    make_jpeg_reader_backend(std::unique_ptr<ImageSource> source);
+
+    std::unique_ptr<ImageReaderBackend>
+    make_tiff_reader_backend(std::unique_ptr<ImageSource> source);
+}
@@ -0,0 +1,317 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-19.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "Yimage/ImageSink.hpp"
+
+#include <algorithm>
+#include <ostream>
+#include <utility>
+#include "Yimage/YimageException.hpp"
+
+#ifdef _WIN32
+    #define WIN32_LEAN_AND_MEAN
+    #define NOMINMAX
+    #include <windows.h>
+#else
+    #include <cerrno>
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+namespace Yimage
+{
+    void ImageSink::flush()
+    {}
+
+    void ImageSink::reserve(size_t)
+    {}
+
+    VectorSink::VectorSink(std::vector<unsigned char>& buffer)
+        : buffer_(&buffer)
+    {}
+
+    void VectorSink::write(const void* data, size_t size)
+    {
+        auto bytes = static_cast<const unsigned char*>(data);
+        buffer_->insert(buffer_->end(), bytes, bytes + size);
+    }
+
+    void VectorSink::reserve(size_t size)
+    {
+        buffer_->reserve(buffer_->size() + size);
+    }
+
+    ArenaSink::ArenaSink(std::pmr::memory_resource* arena)
+        : buffer_(arena)
+    {}
+
+    void ArenaSink::write(const void* data, size_t size)
+    {
+        auto bytes = static_cast<const unsigned char*>(data);
+        buffer_.insert(buffer_.end(), bytes, bytes + size);
+    }
+
+    void ArenaSink::reserve(size_t size)
+    {
+        buffer_.reserve(buffer_.size() + size);
+    }
+
+    std::span<const unsigned char> ArenaSink::data() const
+    {
+        return buffer_;
+    }
+
+    std::pmr::vector<unsigned char> ArenaSink::release()
+    {
+        std::pmr::vector<unsigned char> result(buffer_.get_allocator());
+        std::swap(result, buffer_);
+        return result;
+    }
+
+    size_t FileSinkOptions::buffer_size() const
+    {
+        return buffer_size_;
+    }
+
+    FileSinkOptions& FileSinkOptions::buffer_size(size_t value)
+    {
+        buffer_size_ = value;
+        return *this;
+    }
+
+    bool FileSinkOptions::preallocate() const
+    {
+        return preallocate_;
+    }
+
+    FileSinkOptions& FileSinkOptions::preallocate(bool value)
+    {
+        preallocate_ = value;
+        return *this;
+    }
+
+    FileSync FileSinkOptions::sync() const
+    {
+        return sync_;
+    }
+
+    FileSinkOptions& FileSinkOptions::sync(FileSync value)
+    {
+        sync_ = value;
+        return *this;
+    }
+
+    bool FileSinkOptions::drop_cache() const
+    {
+        return drop_cache_;
+    }
+
+    FileSinkOptions& FileSinkOptions::drop_cache(bool value)
+    {
+        drop_cache_ = value;
+        return *this;
+    }
+
+    void FileSink::write(const void* data, size_t size)
+    {
+        auto bytes = static_cast<const unsigned char*>(data);
+        const auto capacity = options_.buffer_size();
+        if (size <= capacity - buffer_used_)
+        {
+            if (!buffer_)
+                buffer_.reset(new unsigned char[capacity]);
+            std::copy_n(bytes, size, buffer_.get() + buffer_used_);
+            buffer_used_ += size;
+            return;
+        }
+
+        write_buffer();
+        if (size >= capacity)
+        {
+            write_file(bytes, size);
+            return;
+        }
+
+        if (!buffer_)
+            buffer_.reset(new unsigned char[capacity]);
+        std::copy_n(bytes, size, buffer_.get());
+        buffer_used_ = size;
+    }
+
+    void FileSink::write_buffer()
+    {
+        if (buffer_used_ == 0)
+            return;
+        // Empty the buffer first, the destructor must not write the
+        // same bytes again if write_file throws.
+        auto size = std::exchange(buffer_used_, 0);
+        write_file(buffer_.get(), size);
+    }
+
+#ifdef _WIN32
+    FileSink::FileSink(const std::filesystem::path& path,
+                       const FileSinkOptions& options)
+        : options_(options)
+    {
+        handle_ = CreateFileW(path.c_str(), GENERIC_WRITE, 0, nullptr,
+                              CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (handle_ == INVALID_HANDLE_VALUE)
+        {
+            handle_ = nullptr;
+            YIMAGE_THROW("Can not create " + path.string());
+        }
+    }
+
+    FileSink::~FileSink()
+    {
+        if (!handle_)
+            return;
+        try
+        {
+            write_buffer();
+        }
+        catch (...)
+        {
+        }
+        CloseHandle(handle_);
+    }
+
+    void FileSink::write_file(const unsigned char* data, size_t size)
+    {
+        while (size != 0)
+        {
+            DWORD n = 0;
+            auto request = DWORD(std::min<size_t>(size, MAXDWORD));
+            if (!WriteFile(handle_, data, request, &n, nullptr))
+                YIMAGE_THROW("Error while writing file.");
+            data += n;
+            size -= n;
+            file_size_ += n;
+        }
+    }
+
+    void FileSink::flush()
+    {
+        write_buffer();
+        if (options_.sync() != FileSync::NONE && !FlushFileBuffers(handle_))
+            YIMAGE_THROW("Error while flushing file.");
+    }
+
+    void FileSink::reserve(size_t)
+    {}
+#else
+    FileSink::FileSink(const std::filesystem::path& path,
+                       const FileSinkOptions& options)
+        : options_(options)
+    {
+        fd_ = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC,
+                     0666);
+        if (fd_ == -1)
+            YIMAGE_THROW("Can not create " + path.string());
+    }
+
+    FileSink::~FileSink()
+    {
+        if (fd_ == -1)
+            return;
+        try
+        {
+            write_buffer();
+        }
+        catch (...)
+        {
+        }
+        ::close(fd_);
+    }
+
+    void FileSink::write_file(const unsigned char* data, size_t size)
+    {
+        while (size != 0)
+        {
+            auto n = ::write(fd_, data, size);
+            if (n == -1)
+            {
+                if (errno == EINTR)
+                    continue;
+                YIMAGE_THROW("Error while writing file.");
+            }
+            data += n;
+            size -= size_t(n);
+            file_size_ += uint64_t(n);
+        }
+    }
+
+    void FileSink::flush()
+    {
+        write_buffer();
+
+#ifdef __linux__
+        // Release the preallocated blocks beyond the end of the file.
+        if (preallocated_)
+        {
+            if (::ftruncate(fd_, off_t(file_size_)) == -1)
+                YIMAGE_THROW("Error while truncating file.");
+            preallocated_ = false;
+        }
+#endif
+
+        int result = 0;
+        switch (options_.sync())
+        {
+        case FileSync::NONE:
+            break;
+        case FileSync::DATA:
+#if defined(__APPLE__)
+            result = ::fsync(fd_);
+#else
+            result = ::fdatasync(fd_);
+#endif
+            break;
+        case FileSync::FULL:
+            result = ::fsync(fd_);
+            break;
+        }
+        if (result == -1)
+            YIMAGE_THROW("Error while syncing file.");
+
+#ifdef POSIX_FADV_DONTNEED
+        if (options_.drop_cache())
+            ::posix_fadvise(fd_, 0, 0, POSIX_FADV_DONTNEED);
+#endif
+    }
+
+    void FileSink::reserve([[maybe_unused]] size_t size)
+    {
+#ifdef __linux__
+        // This is only a hint, file systems that don't support
+        // fallocate are ignored.
+        if (options_.preallocate() && size != 0
+            && ::fallocate(fd_, FALLOC_FL_KEEP_SIZE, off_t(file_size_ + buffer_used_),
+                           off_t(size)) == 0)
+        {
+            preallocated_ = true;
+        }
+#endif
+    }
+#endif
+
+    StreamSink::StreamSink(std::ostream& stream)
+        : stream_(&stream)
+    {}
+
+    void StreamSink::write(const void* data, size_t size)
+    {
+        stream_->write(static_cast<const char*>(data), std::streamsize(size));
+        if (!*stream_)
+            YIMAGE_THROW("Error while writing to stream.");
+    }
+
+    void StreamSink::flush()
+    {
+        stream_->flush();
+    }
+}
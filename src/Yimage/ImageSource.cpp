@@ -0,0 +1,243 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-19.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "Yimage/ImageSource.hpp"
+
+#include <algorithm>
+#include <istream>
+#include <limits>
+#include "Yimage/YimageException.hpp"
+#include "MemoryMappedFile.hpp"
+
+#ifdef _WIN32
+    #define WIN32_LEAN_AND_MEAN
+    #define NOMINMAX
+    #include <windows.h>
+#else
+    #include <cerrno>
+    #include <fcntl.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace Yimage
+{
+    namespace
+    {
+        size_t read_span(std::span<const unsigned char> data,
+                         uint64_t offset, void* buffer, size_t size)
+        {
+            if (offset >= data.size())
+                return 0;
+            auto n = std::min<uint64_t>(size, data.size() - offset);
+            std::copy_n(data.data() + offset, n,
+                        static_cast<unsigned char*>(buffer));
+            return size_t(n);
+        }
+    }
+
+    std::span<const unsigned char> ImageSource::data() const
+    {
+        return {};
+    }
+
+    MemorySource::MemorySource(const void* buffer, size_t size)
+        : data_(static_cast<const unsigned char*>(buffer), size)
+    {}
+
+    size_t MemorySource::read(uint64_t offset, void* buffer, size_t size)
+    {
+        return read_span(data_, offset, buffer, size);
+    }
+
+    uint64_t MemorySource::size() const
+    {
+        return data_.size();
+    }
+
+    std::span<const unsigned char> MemorySource::data() const
+    {
+        return data_;
+    }
+
+#ifdef _WIN32
+    FileSource::FileSource(const std::filesystem::path& path)
+    {
+        handle_ = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ,
+                              nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (handle_ == INVALID_HANDLE_VALUE)
+        {
+            handle_ = nullptr;
+            YIMAGE_THROW("Can not open file: " + path.string());
+        }
+
+        LARGE_INTEGER size;
+        if (GetFileSizeEx(handle_, &size))
+            size_ = uint64_t(size.QuadPart);
+    }
+
+    FileSource::~FileSource()
+    {
+        if (handle_)
+            CloseHandle(handle_);
+    }
+
+    size_t FileSource::read(uint64_t offset, void* buffer, size_t size)
+    {
+        size_t total = 0;
+        while (total < size)
+        {
+            OVERLAPPED overlapped = {};
+            auto pos = offset + total;
+            overlapped.Offset = DWORD(pos);
+            overlapped.OffsetHigh = DWORD(pos >> 32);
+            auto request = DWORD(std::min<size_t>(size - total, MAXDWORD));
+            DWORD n = 0;
+            if (!ReadFile(handle_, static_cast<char*>(buffer) + total,
+                          request, &n, &overlapped))
+            {
+                if (GetLastError() == ERROR_HANDLE_EOF)
+                    break;
+                YIMAGE_THROW("Error while reading file.");
+            }
+            if (n == 0)
+                break;
+            total += n;
+        }
+        return total;
+    }
+#else
+    FileSource::FileSource(const std::filesystem::path& path)
+    {
+        fd_ = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd_ == -1)
+            YIMAGE_THROW("Can not open file: " + path.string());
+
+        struct stat info = {};
+        if (fstat(fd_, &info) == 0 && S_ISREG(info.st_mode))
+            size_ = uint64_t(info.st_size);
+        else
+            size_ = std::numeric_limits<uint64_t>::max();
+    }
+
+    FileSource::~FileSource()
+    {
+        if (fd_ != -1)
+            ::close(fd_);
+    }
+
+    size_t FileSource::read(uint64_t offset, void* buffer, size_t size)
+    {
+        size_t total = 0;
+        while (total < size)
+        {
+            auto n = ::pread(fd_, static_cast<char*>(buffer) + total,
+                             size - total, off_t(offset + total));
+            if (n == -1)
+            {
+                if (errno == EINTR)
+                    continue;
+                YIMAGE_THROW("Error while reading file.");
+            }
+            if (n == 0)
+                break;
+            total += size_t(n);
+        }
+        return total;
+    }
+#endif
+
+    uint64_t FileSource::size() const
+    {
+        return size_;
+    }
+
+    MappedFileSource::MappedFileSource(const std::filesystem::path& path)
+        : mapping_(std::make_unique<MemoryMappedFile>(path))
+    {
+        if (!*mapping_)
+            YIMAGE_THROW("Can not map file: " + path.string());
+    }
+
+    MappedFileSource::MappedFileSource(std::unique_ptr<MemoryMappedFile> mapping)
+        : mapping_(std::move(mapping))
+    {}
+
+    MappedFileSource::~MappedFileSource() = default;
+
+    size_t MappedFileSource::read(uint64_t offset, void* buffer, size_t size)
+    {
+        return read_span(data(), offset, buffer, size);
+    }
+
+    uint64_t MappedFileSource::size() const
+    {
+        return mapping_->size();
+    }
+
+    std::span<const unsigned char> MappedFileSource::data() const
+    {
+        return {static_cast<const unsigned char*>(mapping_->data()),
+                mapping_->size()};
+    }
+
+    StreamSource::StreamSource(std::istream& stream)
+        : stream_(&stream),
+          start_(0)
+    {
+        auto pos = stream.tellg();
+        if (pos != std::istream::pos_type(-1))
+            start_ = uint64_t(std::streamoff(pos));
+    }
+
+    size_t StreamSource::read(uint64_t offset, void* buffer, size_t size)
+    {
+        // Sequential reads don't seek, so that streams that can't seek
+        // work with the PNG and JPEG decoders.
+        if (offset != position_)
+        {
+            stream_->clear();
+            stream_->seekg(std::streamoff(start_ + offset));
+            if (!*stream_)
+                return 0;
+            position_ = offset;
+        }
+
+        stream_->read(static_cast<char*>(buffer), std::streamsize(size));
+        auto n = size_t(stream_->gcount());
+        position_ += n;
+        return n;
+    }
+
+    uint64_t StreamSource::size() const
+    {
+        stream_->clear();
+        auto pos = stream_->tellg();
+        stream_->seekg(0, std::ios::end);
+        auto end = stream_->tellg();
+        stream_->seekg(pos);
+        if (pos == std::istream::pos_type(-1)
+            || end == std::istream::pos_type(-1))
+        {
+            stream_->clear();
+            return std::numeric_limits<uint64_t>::max();
+        }
+        return uint64_t(std::streamoff(end)) - start_;
+    }
+
+    std::unique_ptr<ImageSource> open_image_source(const std::filesystem::path& path)
+    {
+        auto mapping = std::make_unique<MemoryMappedFile>(path);
+        if (*mapping)
+        {
+            return std::unique_ptr<ImageSource>(
+                new MappedFileSource(std::move(mapping)));
+        }
+        return std::make_unique<FileSource>(path);
+    }
+}
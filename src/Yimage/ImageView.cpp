@@ -80,7 +80,7 @@ namespace Yimage
         for (size_t i = 0; i < a.height(); ++i)
         {
             auto [ab, ae] = a.row(i);
-            auto [bb, be] = a.row(i);
+            auto [bb, be] = b.row(i);
             if (!std::equal(ab, ae, bb, be))
                 return false;
         }
@@ -98,11 +98,40 @@ namespace Yimage
         return uint8_t(((pixel >> shift) & mask) * delta);
     }
 
+    namespace
+    {
+        template <size_t BITS>
+        constexpr uint8_t get_index(uint8_t pixel, size_t index)
+        {
+            constexpr auto pixels = 8 / BITS;
+            auto shift = BITS * (pixels - 1 - (index % pixels));
+            constexpr auto mask = uint8_t((1 << BITS) - 1);
+            return uint8_t((pixel >> shift) & mask);
+        }
+
+        Rgba8 get_palette_color(const ImageView& image, size_t index)
+        {
+            auto metadata = image.metadata();
+            if (!metadata || index >= metadata->palette.size())
+                YIMAGE_THROW("The palette has no color with index "
+                             + std::to_string(index));
+            return metadata->palette[index];
+        }
+    }
+
     Rgba8 get_rgba8(const ImageView& image, size_t x, size_t y)
     {
         auto ptr = image.pixel_pointer(x, y);
         switch (image.pixel_type())
         {
+        case PixelType::INDEXED_1:
+            return get_palette_color(image, get_index<1>(*ptr, x));
+        case PixelType::INDEXED_2:
+            return get_palette_color(image, get_index<2>(*ptr, x));
+        case PixelType::INDEXED_4:
+            return get_palette_color(image, get_index<4>(*ptr, x));
+        case PixelType::INDEXED_8:
+            return get_palette_color(image, *ptr);
         case PixelType::MONO_1:
         {
             auto v = get_bits<1>(*ptr, x);
@@ -0,0 +1,147 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-19.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "Yimage/ImageWriter.hpp"
+
+#include "Yimage/WriteImage.hpp"
+#include "Yimage/YimageException.hpp"
+#include "ImageWriterBackend.hpp"
+#include "YimageVersion.hpp"
+
+namespace Yimage
+{
+    namespace
+    {
+        std::unique_ptr<ImageWriterBackend>
+        make_backend(ImageSink& sink, const ImageInfo& info,
+                     const PngWriteOptions& png_options)
+        {
+            switch (info.format)
+            {
+#ifdef YIMAGE_PNG
+            case ImageFormat::PNG:
+                return make_png_writer_backend(sink, info, png_options);
+#endif
+            case ImageFormat::JPEG:
+                YIMAGE_THROW("Writing JPEG images is not supported.");
+            case ImageFormat::TIFF:
+                YIMAGE_THROW("Writing TIFF images is not supported.");
+            case ImageFormat::UNKNOWN:
+            default:
+                YIMAGE_THROW("Unsupported image format.");
+            }
+        }
+    }
+
+    ImageWriter::ImageWriter() = default;
+
+    ImageWriter::ImageWriter(const std::filesystem::path& path,
+                             const ImageInfo& info,
+                             const PngWriteOptions& png_options)
+    {
+        open(path, info, png_options);
+    }
+
+    ImageWriter::ImageWriter(std::ostream& stream, const ImageInfo& info,
+                             const PngWriteOptions& png_options)
+    {
+        open(stream, info, png_options);
+    }
+
+    ImageWriter::ImageWriter(ImageSink& sink, const ImageInfo& info,
+                             const PngWriteOptions& png_options)
+    {
+        open(sink, info, png_options);
+    }
+
+    ImageWriter::ImageWriter(ImageWriter&& rhs) noexcept = default;
+
+    ImageWriter::~ImageWriter() = default;
+
+    ImageWriter& ImageWriter::operator=(ImageWriter&& rhs) noexcept = default;
+
+    ImageWriter::operator bool() const
+    {
+        return bool(backend_);
+    }
+
+    void ImageWriter::open(const std::filesystem::path& path,
+                           const ImageInfo& info,
+                           const PngWriteOptions& png_options)
+    {
+        auto file_info = info;
+        if (file_info.format == ImageFormat::UNKNOWN)
+            file_info.format = get_image_format_from_extension(path);
+        open(std::make_unique<FileSink>(path), file_info, png_options);
+    }
+
+    void ImageWriter::open(std::ostream& stream, const ImageInfo& info,
+                           const PngWriteOptions& png_options)
+    {
+        open(std::make_unique<StreamSink>(stream), info, png_options);
+    }
+
+    void ImageWriter::open(ImageSink& sink, const ImageInfo& info,
+                           const PngWriteOptions& png_options)
+    {
+        close();
+        backend_ = make_backend(sink, info, png_options);
+        sink_ = &sink;
+    }
+
+    void ImageWriter::open(std::unique_ptr<ImageSink> sink,
+                           const ImageInfo& info,
+                           const PngWriteOptions& png_options)
+    {
+        open(*sink, info, png_options);
+        own_sink_ = std::move(sink);
+    }
+
+    void ImageWriter::close()
+    {
+        backend_.reset();
+        sink_ = nullptr;
+        own_sink_.reset();
+        current_row_ = 0;
+    }
+
+    const ImageInfo& ImageWriter::info() const
+    {
+        if (!backend_)
+            YIMAGE_THROW("The image writer isn't open.");
+        return backend_->info();
+    }
+
+    size_t ImageWriter::current_row() const
+    {
+        return current_row_;
+    }
+
+    void ImageWriter::write_rows(const ImageView& band)
+    {
+        auto& image_info = info();
+        if (band.width() != image_info.width
+            || band.pixel_type() != image_info.pixel_type)
+        {
+            YIMAGE_THROW("The band must have the same width and pixel type as the image.");
+        }
+        if (band.height() > image_info.height - current_row_)
+            YIMAGE_THROW("Attempt to write past the end of the image.");
+
+        if (band.height() == 0)
+            return;
+
+        backend_->write_rows(band);
+        current_row_ += band.height();
+
+        if (current_row_ == image_info.height)
+        {
+            backend_->finish();
+            sink_->flush();
+        }
+    }
+}
@@ -0,0 +1,44 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-19.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <memory>
+#include "Yimage/ImageSink.hpp"
+#include "Yimage/ImageView.hpp"
+#include "Yimage/ProbeImage.hpp"
+#include "Yimage/Png/PngWriteOptions.hpp"
+
+namespace Yimage
+{
+    class ImageWriterBackend
+    {
+    public:
+        virtual ~ImageWriterBackend() = default;
+
+        [[nodiscard]]
+        virtual const ImageInfo& info() const = 0;
+
+        /**
+         * @brief Encodes the rows in @a band.
+         *
+         * ImageWriter has already verified that @a band matches the
+         * image and that there is room for its rows.
+         */
+        virtual void write_rows(const ImageView& band) = 0;
+
+        /**
+         * @brief Writes whatever must follow the last row.
+         *
+         * ImageWriter calls this as soon as the last row has been written.
+         */
+        virtual void finish() = 0;
+    };
+
+    std::unique_ptr<ImageWriterBackend>
+    make_png_writer_backend(ImageSink& sink, const ImageInfo& info,
+                            const PngWriteOptions& options);
+}
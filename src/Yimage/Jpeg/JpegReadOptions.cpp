@@ -0,0 +1,71 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-19.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "Yimage/Jpeg/JpegReadOptions.hpp"
+
+#include <numeric>
+
+namespace Yimage
+{
+    unsigned JpegReadOptions::scale_num() const
+    {
+        return scale_num_;
+    }
+
+    JpegReadOptions& JpegReadOptions::scale_num(unsigned value)
+    {
+        scale_num_ = value;
+        return *this;
+    }
+
+    unsigned JpegReadOptions::scale_denom() const
+    {
+        return scale_denom_;
+    }
+
+    JpegReadOptions& JpegReadOptions::scale_denom(unsigned value)
+    {
+        scale_denom_ = value;
+        return *this;
+    }
+
+    size_t JpegReadOptions::min_width() const
+    {
+        return min_width_;
+    }
+
+    size_t JpegReadOptions::min_height() const
+    {
+        return min_height_;
+    }
+
+    JpegReadOptions& JpegReadOptions::min_size(size_t width, size_t height)
+    {
+        min_width_ = width;
+        min_height_ = height;
+        return *this;
+    }
+
+    std::pair<unsigned, unsigned>
+    get_jpeg_scale(size_t width, size_t height,
+                   size_t min_width, size_t min_height)
+    {
+        // libjpeg rounds the scaled size up.
+        unsigned m = 1;
+        for (; m < 8; ++m)
+        {
+            if ((width * m + 7) / 8 >= min_width
+                && (height * m + 7) / 8 >= min_height)
+            {
+                break;
+            }
+        }
+
+        auto gcd = std::gcd(m, 8u);
+        return {m / gcd, 8 / gcd};
+    }
+}
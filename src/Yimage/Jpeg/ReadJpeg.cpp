@@ -8,9 +8,12 @@
 #include "Yimage/Jpeg/ReadJpeg.hpp"
 
 #include <algorithm>
+#include <vector>
 #include <jpeglib.h>
+#include <jerror.h>
+#include "Yimage/Jpeg/JpegDecoder.hpp"
 #include "Yimage/YimageException.hpp"
-#include "../FileUtilities.hpp"
+#include "../ImageReaderBackend.hpp"
 
 namespace Yimage
 {
@@ -24,12 +27,104 @@ namespace Yimage
                                   + std::string(msg));
         }
 
+        /**
+         * @brief A libjpeg source manager that reads from an ImageSource.
+         */
+        struct JpegSourceManager
+        {
+            jpeg_source_mgr mgr = {};
+            ImageSource* source = nullptr;
+            uint64_t offset = 0;
+            std::vector<JOCTET> buffer;
+        };
+
         struct JpegData
         {
             jpeg_error_mgr error_mgr = {};
             jpeg_decompress_struct info = {};
+            JpegSourceManager source_mgr;
         };
 
+        JpegSourceManager& get_source_manager(j_decompress_ptr cinfo)
+        {
+            // mgr is the first member of JpegSourceManager.
+            return *reinterpret_cast<JpegSourceManager*>(cinfo->src);
+        }
+
+        void init_source(j_decompress_ptr)
+        {}
+
+        boolean fill_input_buffer(j_decompress_ptr cinfo)
+        {
+            auto& src = get_source_manager(cinfo);
+            if (src.buffer.empty())
+                src.buffer.resize(64 * 1024);
+            auto n = src.source->read(src.offset, src.buffer.data(),
+                                      src.buffer.size());
+            src.offset += n;
+            if (n == 0)
+            {
+                // Insert a fake EOI marker, like libjpeg's own sources.
+                WARNMS(cinfo, JWRN_JPEG_EOF);
+                src.buffer[0] = 0xFF;
+                src.buffer[1] = JPEG_EOI;
+                n = 2;
+            }
+            src.mgr.next_input_byte = src.buffer.data();
+            src.mgr.bytes_in_buffer = n;
+            return TRUE;
+        }
+
+        void skip_input_data(j_decompress_ptr cinfo, long num_bytes)
+        {
+            if (num_bytes <= 0)
+                return;
+
+            auto& src = get_source_manager(cinfo);
+            auto n = size_t(num_bytes);
+            if (n <= src.mgr.bytes_in_buffer)
+            {
+                src.mgr.next_input_byte += n;
+                src.mgr.bytes_in_buffer -= n;
+            }
+            else
+            {
+                // Skip the remaining bytes without reading them.
+                src.offset += n - src.mgr.bytes_in_buffer;
+                src.mgr.bytes_in_buffer = 0;
+            }
+        }
+
+        void term_source(j_decompress_ptr)
+        {}
+
+        void set_source(JpegData& data, ImageSource& source)
+        {
+            auto& src = data.source_mgr;
+            src.source = &source;
+            src.offset = 0;
+            src.mgr.init_source = init_source;
+            src.mgr.fill_input_buffer = fill_input_buffer;
+            src.mgr.skip_input_data = skip_input_data;
+            src.mgr.resync_to_restart = jpeg_resync_to_restart;
+            src.mgr.term_source = term_source;
+            src.mgr.next_input_byte = nullptr;
+            src.mgr.bytes_in_buffer = 0;
+
+            // Data that is already in memory is used directly, the source
+            // is only read from if libjpeg asks for bytes beyond the end.
+            // jpeg_mem_src isn't used as libjpeg-turbo refuses to replace
+            // a source manager it didn't create itself.
+            if (auto bytes = source.data(); !bytes.empty())
+            {
+                src.offset = bytes.size();
+                src.mgr.next_input_byte = bytes.data();
+                src.mgr.bytes_in_buffer = bytes.size();
+            }
+
+            data.info.src = &src.mgr;
+        }
+
         void create_decompress(JpegData& data)
         {
             data.info.err = jpeg_std_error(&data.error_mgr);
@@ -37,48 +132,102 @@ namespace Yimage
             jpeg_create_decompress(&data.info);
         }
 
-        Image read_image(JpegData& data)
+        PixelType get_pixel_type(const jpeg_decompress_struct& info)
         {
-            jpeg_read_header(&data.info, TRUE);
-            jpeg_calc_output_dimensions(&data.info);
-            auto row_size = data.info.output_width
-                            * data.info.output_components;
-            auto* buffer = (*data.info.mem->alloc_sarray)
-                (j_common_ptr(&data.info), JPOOL_IMAGE, row_size, 1);
-            jpeg_start_decompress(&data.info);
-
-            Image image(data.info.output_components == 3
-                                  ? PixelType::RGB_8
-                                  : PixelType::MONO_8,
-                        data.info.output_width,
-                        data.info.output_height);
-
-            auto* dst = image.data();
+            switch (info.output_components)
+            {
+            case 1:
+                return PixelType::MONO_8;
+            case 3:
+                return PixelType::RGB_8;
+            default:
+                YIMAGE_THROW("Unsupported number of JPEG color components: "
+                             + std::to_string(info.output_components));
+            }
+        }
 
+        void read_pixels(JpegData& data, const MutableImageView& dst)
+        {
+            // Read a few scanlines at a time straight into the destination.
+            constexpr JDIMENSION MAX_ROWS = 8;
+            JSAMPROW rows[MAX_ROWS];
             while (data.info.output_scanline < data.info.output_height)
             {
-                jpeg_read_scanlines(&data.info, buffer, 1);
-                std::copy_n(buffer[0], row_size, dst);
-                dst += row_size;
+                auto y = data.info.output_scanline;
+                auto count = std::min(MAX_ROWS, data.info.output_height - y);
+                for (JDIMENSION i = 0; i < count; ++i)
+                    rows[i] = dst.row(y + i).first;
+                jpeg_read_scanlines(&data.info, rows, count);
             }
 
             jpeg_finish_decompress(&data.info);
-            jpeg_destroy_decompress(&data.info);
+        }
+
+        void apply_read_options(jpeg_decompress_struct& info,
+                                const JpegReadOptions& options)
+        {
+            // jpeg_read_header has reset the scale to 1/1.
+            if (options.min_width() != 0 || options.min_height() != 0)
+            {
+                auto [num, denom] = get_jpeg_scale(info.image_width,
+                                                   info.image_height,
+                                                   options.min_width(),
+                                                   options.min_height());
+                info.scale_num = num;
+                info.scale_denom = denom;
+            }
+            else
+            {
+                info.scale_num = options.scale_num();
+                info.scale_denom = options.scale_denom();
+            }
+        }
+
+        Image read_image(JpegData& data, const JpegReadOptions& options)
+        {
+            jpeg_read_header(&data.info, TRUE);
+            apply_read_options(data.info, options);
+            jpeg_start_decompress(&data.info);
+
+            Image image(get_pixel_type(data.info),
+                        data.info.output_width,
+                        data.info.output_height);
+
+            read_pixels(data, image.mutable_view());
 
             image.set_metadata(std::make_unique<ImageMetadata>(ImageFormat::JPEG));
 
             return image;
         }
+
+        void read_image_into(JpegData& data, const MutableImageView& dst,
+                             const JpegReadOptions& options)
+        {
+            jpeg_read_header(&data.info, TRUE);
+            apply_read_options(data.info, options);
+            jpeg_start_decompress(&data.info);
+
+            if (dst.pixel_type() != get_pixel_type(data.info)
+                || dst.width() != data.info.output_width
+                || dst.height() != data.info.output_height)
+            {
+                YIMAGE_THROW("The destination must have the same size and pixel type as the image.");
+            }
+
+            read_pixels(data, dst);
+        }
     }
 
-    Image read_jpeg(FILE* file)
+    Image read_jpeg(FILE* file, const JpegReadOptions& options)
     {
         JpegData data = {};
         try
         {
             create_decompress(data);
             jpeg_stdio_src(&data.info, file);
-            return read_image(data);
+            auto image = read_image(data, options);
+            jpeg_destroy_decompress(&data.info);
+            return image;
         }
         catch (std::exception&)
         {
@@ -87,41 +236,43 @@ namespace Yimage
         }
     }
 
-    namespace
+    Image read_jpeg(ImageSource& source, const JpegReadOptions& options)
     {
-#ifdef _WIN32
-        FILE* my_fopen(const std::filesystem::path& path)
-        {
-            return _wfopen(path.c_str(), L"rb");
-        }
-#else
-        FILE* my_fopen(const std::filesystem::path& path)
-        {
-            return fopen(path.c_str(), "rb");
-        }
-#endif
+        return JpegDecoder(options).read(source);
+    }
+
+    Image read_jpeg(std::istream& stream, const JpegReadOptions& options)
+    {
+        StreamSource source(stream);
+        return read_jpeg(source, options);
     }
 
-    Image read_jpeg(const std::filesystem::path& path)
+    Image read_jpeg(const std::filesystem::path& path,
+                    const JpegReadOptions& options)
     {
-        UniqueFile file(my_fopen(path));
-        if (!file)
-            YIMAGE_THROW("Could not open file: " + path.string());
-        auto img = read_jpeg(file.get());
+        auto img = read_jpeg(*open_image_source(path), options);
         if (auto metadata = img.metadata())
             metadata->path = path;
         return img;
     }
 
-    Image read_jpeg(const void* buffer, size_t size)
+    Image read_jpeg(const void* buffer, size_t size,
+                    const JpegReadOptions& options)
+    {
+        MemorySource source(buffer, size);
+        return read_jpeg(source, options);
+    }
+
+    void read_jpeg_into(FILE* file, const MutableImageView& dst,
+                        const JpegReadOptions& options)
     {
         JpegData data = {};
         try
         {
             create_decompress(data);
-            const auto* uc_buffer = static_cast<const unsigned char*>(buffer);
-            jpeg_mem_src(&data.info, uc_buffer, size);
-            return read_image(data);
+            jpeg_stdio_src(&data.info, file);
+            read_image_into(data, dst, options);
+            jpeg_destroy_decompress(&data.info);
         }
         catch (std::exception&)
         {
@@ -129,4 +280,193 @@ namespace Yimage
             throw;
         }
     }
+
+    void read_jpeg_into(ImageSource& source, const MutableImageView& dst,
+                        const JpegReadOptions& options)
+    {
+        JpegDecoder(options).read_into(source, dst);
+    }
+
+    void read_jpeg_into(std::istream& stream, const MutableImageView& dst,
+                        const JpegReadOptions& options)
+    {
+        StreamSource source(stream);
+        read_jpeg_into(source, dst, options);
+    }
+
+    void read_jpeg_into(const std::filesystem::path& path,
+                        const MutableImageView& dst,
+                        const JpegReadOptions& options)
+    {
+        read_jpeg_into(*open_image_source(path), dst, options);
+    }
+
+    void read_jpeg_into(const void* buffer, size_t size,
+                        const MutableImageView& dst,
+                        const JpegReadOptions& options)
+    {
+        MemorySource source(buffer, size);
+        read_jpeg_into(source, dst, options);
+    }
+
+    struct JpegDecoder::Data
+    {
+        Data()
+        {
+            create_decompress(jpeg);
+        }
+
+        Data(const Data&) = delete;
+
+        ~Data()
+        {
+            jpeg_destroy_decompress(&jpeg.info);
+        }
+
+        Data& operator=(const Data&) = delete;
+
+        JpegData jpeg;
+        JpegReadOptions options;
+    };
+
+    JpegDecoder::JpegDecoder()
+        : data_(std::make_unique<Data>())
+    {}
+
+    JpegDecoder::JpegDecoder(const JpegReadOptions& options)
+        : data_(std::make_unique<Data>())
+    {
+        data_->options = options;
+    }
+
+    JpegDecoder::JpegDecoder(JpegDecoder&& rhs) noexcept = default;
+
+    JpegDecoder::~JpegDecoder() = default;
+
+    JpegDecoder& JpegDecoder::operator=(JpegDecoder&& rhs) noexcept = default;
+
+    const JpegReadOptions& JpegDecoder::options() const
+    {
+        return data_->options;
+    }
+
+    JpegDecoder& JpegDecoder::options(const JpegReadOptions& value)
+    {
+        data_->options = value;
+        return *this;
+    }
+
+    Image JpegDecoder::read(ImageSource& source)
+    {
+        try
+        {
+            set_source(data_->jpeg, source);
+            return read_image(data_->jpeg, data_->options);
+        }
+        catch (std::exception&)
+        {
+            // Returns the decompressor to its initial state, but keeps
+            // the permanent memory pool.
+            jpeg_abort_decompress(&data_->jpeg.info);
+            throw;
+        }
+    }
+
+    Image JpegDecoder::read(const void* buffer, size_t size)
+    {
+        MemorySource source(buffer, size);
+        return read(source);
+    }
+
+    void JpegDecoder::read_into(ImageSource& source, const MutableImageView& dst)
+    {
+        try
+        {
+            set_source(data_->jpeg, source);
+            read_image_into(data_->jpeg, dst, data_->options);
+        }
+        catch (std::exception&)
+        {
+            jpeg_abort_decompress(&data_->jpeg.info);
+            throw;
+        }
+    }
+
+    void JpegDecoder::read_into(const void* buffer, size_t size,
+                                const MutableImageView& dst)
+    {
+        MemorySource source(buffer, size);
+        read_into(source, dst);
+    }
+
+    namespace
+    {
+        class JpegReaderBackend : public ImageReaderBackend
+        {
+        public:
+            explicit JpegReaderBackend(std::unique_ptr<ImageSource> source)
+                : source_(std::move(source))
+            {
+                try
+                {
+                    create_decompress(data_);
+                    set_source(data_, *source_);
+
+                    jpeg_read_header(&data_.info, TRUE);
+                    jpeg_start_decompress(&data_.info);
+                    info_ = {ImageFormat::JPEG,
+                             data_.info.output_width,
+                             data_.info.output_height,
+                             get_pixel_type(data_.info)};
+                }
+                catch (std::exception&)
+                {
+                    jpeg_destroy_decompress(&data_.info);
+                    throw;
+                }
+            }
+
+            JpegReaderBackend(const JpegReaderBackend&) = delete;
+
+            ~JpegReaderBackend() override
+            {
+                jpeg_destroy_decompress(&data_.info);
+            }
+
+            JpegReaderBackend& operator=(const JpegReaderBackend&) = delete;
+
+            [[nodiscard]]
+            const ImageInfo& info() const override
+            {
+                return info_;
+            }
+
+            void read_rows(const MutableImageView& band) override
+            {
+                constexpr size_t MAX_ROWS = 8;
+                JSAMPROW rows[MAX_ROWS];
+                for (size_t y = 0; y < band.height();)
+                {
+                    auto count = std::min(MAX_ROWS, band.height() - y);
+                    for (size_t i = 0; i < count; ++i)
+                        rows[i] = band.row(y + i).first;
+                    auto n = jpeg_read_scanlines(&data_.info, rows,
+                                                 JDIMENSION(count));
+                    if (n == 0)
+                        YIMAGE_THROW("Could not read JPEG scanlines.");
+                    y += n;
+                }
+            }
+        private:
+            std::unique_ptr<ImageSource> source_;
+            JpegData data_ = {};
+            ImageInfo info_;
+        };
+    }
+
+    std::unique_ptr<ImageReaderBackend>
+    make_jpeg_reader_backend(std::unique_ptr<ImageSource> source)
+    {
+        return std::make_unique<JpegReaderBackend>(std::move(source));
+    }
 }
@@ -0,0 +1,112 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-19.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "MemoryMappedFile.hpp"
+
+#include <cstdint>
+#include <utility>
+
+#ifdef _WIN32
+    #define WIN32_LEAN_AND_MEAN
+    #define NOMINMAX
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace Yimage
+{
+#ifdef _WIN32
+    MemoryMappedFile::MemoryMappedFile(const std::filesystem::path& path)
+    {
+        auto file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ,
+                                nullptr, OPEN_EXISTING,
+                                FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+            return;
+
+        LARGE_INTEGER size;
+        if (GetFileSizeEx(file, &size) && size.QuadPart > 0
+            && uint64_t(size.QuadPart) <= SIZE_MAX)
+        {
+            auto mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY,
+                                              0, 0, nullptr);
+            if (mapping)
+            {
+                data_ = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+                if (data_)
+                    size_ = size_t(size.QuadPart);
+                // The view keeps the mapping alive.
+                CloseHandle(mapping);
+            }
+        }
+        CloseHandle(file);
+    }
+
+    void MemoryMappedFile::unmap()
+    {
+        if (data_)
+            UnmapViewOfFile(data_);
+        data_ = nullptr;
+        size_ = 0;
+    }
+#else
+    MemoryMappedFile::MemoryMappedFile(const std::filesystem::path& path)
+    {
+        auto fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd == -1)
+            return;
+
+        struct stat info = {};
+        if (fstat(fd, &info) == 0 && S_ISREG(info.st_mode) && info.st_size > 0
+            && uint64_t(info.st_size) <= SIZE_MAX)
+        {
+            auto size = size_t(info.st_size);
+            auto data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (data != MAP_FAILED)
+            {
+                data_ = data;
+                size_ = size;
+            }
+        }
+        // The mapping stays valid after the file is closed.
+        ::close(fd);
+    }
+
+    void MemoryMappedFile::unmap()
+    {
+        if (data_)
+            munmap(data_, size_);
+        data_ = nullptr;
+        size_ = 0;
+    }
+#endif
+
+    MemoryMappedFile::MemoryMappedFile(MemoryMappedFile&& rhs) noexcept
+        : data_(std::exchange(rhs.data_, nullptr)),
+          size_(std::exchange(rhs.size_, 0))
+    {}
+
+    MemoryMappedFile::~MemoryMappedFile()
+    {
+        unmap();
+    }
+
+    MemoryMappedFile& MemoryMappedFile::operator=(MemoryMappedFile&& rhs) noexcept
+    {
+        if (this != &rhs)
+        {
+            unmap();
+            data_ = std::exchange(rhs.data_, nullptr);
+            size_ = std::exchange(rhs.size_, 0);
+        }
+        return *this;
+    }
+}
@@ -0,0 +1,60 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-19.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <cstddef>
+#include <filesystem>
+
+namespace Yimage
+{
+    /**
+     * @brief A read-only memory mapping of an entire file.
+     *
+     * The mapping is empty if the file can't be opened or mapped, for
+     * instance because it is empty or isn't a regular file. Callers are
+     * expected to fall back to ordinary file I/O in that case.
+     */
+    class MemoryMappedFile
+    {
+    public:
+        MemoryMappedFile() = default;
+
+        explicit MemoryMappedFile(const std::filesystem::path& path);
+
+        MemoryMappedFile(const MemoryMappedFile&) = delete;
+
+        MemoryMappedFile(MemoryMappedFile&& rhs) noexcept;
+
+        ~MemoryMappedFile();
+
+        MemoryMappedFile& operator=(const MemoryMappedFile&) = delete;
+
+        MemoryMappedFile& operator=(MemoryMappedFile&& rhs) noexcept;
+
+        explicit operator bool() const
+        {
+            return data_ != nullptr;
+        }
+
+        [[nodiscard]]
+        const void* data() const
+        {
+            return data_;
+        }
+
+        [[nodiscard]]
+        size_t size() const
+        {
+            return size_;
+        }
+    private:
+        void unmap();
+
+        void* data_ = nullptr;
+        size_t size_ = 0;
+    };
+}
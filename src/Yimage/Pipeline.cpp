@@ -0,0 +1,892 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-19.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "Yimage/Pipeline.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "Yimage/YimageException.hpp"
+#include "ChannelLayout.hpp"
+#include "ColorBytes.hpp"
+
+namespace Yimage
+{
+    namespace
+    {
+        constexpr size_t BAND_SIZE = 64 * 1024;
+
+        size_t get_band_height(size_t width, PixelType pixel_type)
+        {
+            auto row_size = (width * get_pixel_size(pixel_type) + 7) / 8;
+            return std::max<size_t>(BAND_SIZE / std::max<size_t>(row_size, 1), 1);
+        }
+
+        /**
+         * @brief Reads rows from the stage before the current one, either
+         *      directly from its view or through a band-sized buffer.
+         */
+        class UpstreamReader
+        {
+        public:
+            explicit UpstreamReader(std::unique_ptr<PipelineStage> stage)
+                : stage_(std::move(stage)),
+                  view_(stage_->view())
+            {}
+
+            [[nodiscard]]
+            const PipelineStage& stage() const
+            {
+                return *stage_;
+            }
+
+            [[nodiscard]]
+            const ImageView& view() const
+            {
+                return view_;
+            }
+
+            /**
+             * @brief Returns the next rows, at least one and at most
+             *      @a max_rows.
+             */
+            ImageView read(size_t max_rows)
+            {
+                auto rows = std::min(max_rows, stage_->height() - row_);
+                if (rows == 0)
+                    YIMAGE_THROW("Attempt to read past the end of the image.");
+
+                if (view_)
+                {
+                    auto result = view_.subimage(0, row_, SIZE_MAX, rows);
+                    row_ += rows;
+                    return result;
+                }
+
+                if (!buffer_)
+                {
+                    buffer_ = Image(stage_->pixel_type(), stage_->width(),
+                                    get_band_height(stage_->width(),
+                                                    stage_->pixel_type()));
+                }
+
+                rows = std::min(rows, buffer_.height());
+                auto band = buffer_.mutable_subimage(0, 0, SIZE_MAX, rows);
+                stage_->read_rows(band);
+                row_ += rows;
+                return ImageView(band);
+            }
+
+            void skip(size_t rows)
+            {
+                while (rows != 0)
+                    rows -= read(rows).height();
+            }
+        private:
+            std::unique_ptr<PipelineStage> stage_;
+            ImageView view_;
+            Image buffer_;
+            size_t row_ = 0;
+        };
+
+        class ViewStage : public PipelineStage
+        {
+        public:
+            explicit ViewStage(const ImageView& view)
+                : view_(view)
+            {}
+
+            [[nodiscard]]
+            size_t width() const override
+            {
+                return view_.width();
+            }
+
+            [[nodiscard]]
+            size_t height() const override
+            {
+                return view_.height();
+            }
+
+            [[nodiscard]]
+            PixelType pixel_type() const override
+            {
+                return view_.pixel_type();
+            }
+
+            [[nodiscard]]
+            const std::vector<Rgba8>& palette() const override
+            {
+                if (auto metadata = view_.metadata())
+                    return metadata->palette;
+                return PipelineStage::palette();
+            }
+
+            void read_rows(const MutableImageView& band) override
+            {
+                auto row_bytes = view_.width() * view_.pixel_size() / 8;
+                for (size_t i = 0; i < band.height(); ++i)
+                {
+                    auto src = view_.row(row_++).first;
+                    std::copy_n(src, row_bytes, band.row(i).first);
+                }
+            }
+
+            [[nodiscard]]
+            ImageView view() const override
+            {
+                return view_;
+            }
+        private:
+            ImageView view_;
+            size_t row_ = 0;
+        };
+
+        class ReaderStage : public PipelineStage
+        {
+        public:
+            explicit ReaderStage(ImageReader reader)
+                : reader_(std::move(reader))
+            {
+                if (!reader_)
+                    YIMAGE_THROW("The image reader isn't open.");
+            }
+
+            [[nodiscard]]
+            size_t width() const override
+            {
+                return reader_.info().width;
+            }
+
+            [[nodiscard]]
+            size_t height() const override
+            {
+                return reader_.info().height;
+            }
+
+            [[nodiscard]]
+            PixelType pixel_type() const override
+            {
+                return reader_.info().pixel_type;
+            }
+
+            [[nodiscard]]
+            const std::vector<Rgba8>& palette() const override
+            {
+                return reader_.info().palette;
+            }
+
+            void read_rows(const MutableImageView& band) override
+            {
+                reader_.read_rows(band);
+            }
+        private:
+            ImageReader reader_;
+        };
+
+        /**
+         * @brief Base class for stages where each output row only depends
+         *      on the corresponding input row.
+         */
+        class RowStage : public PipelineStage
+        {
+        public:
+            explicit RowStage(std::unique_ptr<PipelineStage> upstream)
+                : upstream_(std::move(upstream))
+            {}
+
+            [[nodiscard]]
+            size_t width() const override
+            {
+                return upstream_.stage().width();
+            }
+
+            [[nodiscard]]
+            size_t height() const override
+            {
+                return upstream_.stage().height();
+            }
+
+            [[nodiscard]]
+            PixelType pixel_type() const override
+            {
+                return upstream_.stage().pixel_type();
+            }
+
+            [[nodiscard]]
+            const std::vector<Rgba8>& palette() const override
+            {
+                return upstream_.stage().palette();
+            }
+
+            void read_rows(const MutableImageView& band) override
+            {
+                for (size_t y = 0; y < band.height();)
+                {
+                    auto src = upstream_.read(band.height() - y);
+                    for (size_t i = 0; i < src.height(); ++i)
+                        transform_row(src.row(i).first, band.row(y + i).first);
+                    y += src.height();
+                }
+            }
+        protected:
+            virtual void transform_row(const unsigned char* src,
+                                       unsigned char* dst) = 0;
+
+            UpstreamReader upstream_;
+        };
+
+        bool has_8_bit_channels(PixelType type)
+        {
+            switch (type)
+            {
+            case PixelType::MONO_1:
+            case PixelType::MONO_2:
+            case PixelType::MONO_4:
+            case PixelType::MONO_8:
+            case PixelType::ALPHA_MONO_8:
+            case PixelType::MONO_ALPHA_8:
+            case PixelType::RGB_8:
+            case PixelType::ARGB_8:
+            case PixelType::RGBA_8:
+                return true;
+            default:
+                return false;
+            }
+        }
+
+        class ConvertStage : public RowStage
+        {
+        public:
+            ConvertStage(std::unique_ptr<PipelineStage> upstream,
+                         PixelType pixel_type)
+                : RowStage(std::move(upstream)),
+                  pixel_type_(pixel_type),
+                  pixel_size_(get_pixel_size(pixel_type) / 8)
+            {
+                auto src_type = upstream_.stage().pixel_type();
+                if (!has_8_bit_channels(src_type))
+                {
+                    YIMAGE_THROW("Can not convert from pixel type "
+                                 + std::to_string(int(src_type)));
+                }
+                if (!has_8_bit_channels(pixel_type)
+                    || get_pixel_size(pixel_type) < 8)
+                {
+                    YIMAGE_THROW("Can not convert to pixel type "
+                                 + std::to_string(int(pixel_type)));
+                }
+            }
+
+            [[nodiscard]]
+            PixelType pixel_type() const override
+            {
+                return pixel_type_;
+            }
+
+            [[nodiscard]]
+            const std::vector<Rgba8>& palette() const override
+            {
+                // The destination types aren't indexed.
+                return PipelineStage::palette();
+            }
+        protected:
+            void transform_row(const unsigned char* src,
+                               unsigned char* dst) override
+            {
+                ImageView src_row(src, upstream_.stage().pixel_type(),
+                                  width(), 1);
+                for (size_t x = 0; x < src_row.width(); ++x)
+                {
+                    auto bytes = get_color_bytes(get_rgba8(src_row, x, 0),
+                                                 pixel_type_);
+                    dst = std::copy_n(bytes.bytes, pixel_size_, dst);
+                }
+            }
+        private:
+            PixelType pixel_type_;
+            size_t pixel_size_;
+        };
+
+        class CropStage : public RowStage
+        {
+        public:
+            CropStage(std::unique_ptr<PipelineStage> upstream,
+                      size_t x, size_t y, size_t width, size_t height)
+                : RowStage(std::move(upstream))
+            {
+                auto& src = upstream_.stage();
+                x_ = std::min(x, src.width());
+                y_ = std::min(y, src.height());
+                width_ = std::min(width, src.width() - x_);
+                height_ = std::min(height, src.height() - y_);
+
+                auto pixel_size = get_pixel_size(src.pixel_type());
+                if ((x_ * pixel_size) % 8 != 0)
+                    YIMAGE_THROW("The crop rectangle must start on a byte boundary.");
+                offset_ = x_ * pixel_size / 8;
+                row_bytes_ = width_ * pixel_size / 8;
+            }
+
+            [[nodiscard]]
+            size_t width() const override
+            {
+                return width_;
+            }
+
+            [[nodiscard]]
+            size_t height() const override
+            {
+                return height_;
+            }
+
+            void read_rows(const MutableImageView& band) override
+            {
+                if (!started_)
+                {
+                    upstream_.skip(y_);
+                    started_ = true;
+                }
+                RowStage::read_rows(band);
+            }
+
+            [[nodiscard]]
+            ImageView view() const override
+            {
+                if (auto view = upstream_.view())
+                    return view.subimage(x_, y_, width_, height_);
+                return {};
+            }
+        protected:
+            void transform_row(const unsigned char* src,
+                               unsigned char* dst) override
+            {
+                std::copy_n(src + offset_, row_bytes_, dst);
+            }
+        private:
+            size_t x_ = 0;
+            size_t y_ = 0;
+            size_t width_ = 0;
+            size_t height_ = 0;
+            size_t offset_ = 0;
+            size_t row_bytes_ = 0;
+            bool started_ = false;
+        };
+
+        class FlipHorizontallyStage : public RowStage
+        {
+        public:
+            explicit FlipHorizontallyStage(std::unique_ptr<PipelineStage> upstream)
+                : RowStage(std::move(upstream)),
+                  pixel_size_(get_pixel_size(pixel_type()) / 8)
+            {
+                if (get_pixel_size(pixel_type()) % 8 != 0)
+                    YIMAGE_THROW("Pixel sizes less than 8 bits are not supported.");
+            }
+        protected:
+            void transform_row(const unsigned char* src,
+                               unsigned char* dst) override
+            {
+                auto src_pixel = src + width() * pixel_size_;
+                for (size_t x = 0; x < width(); ++x)
+                {
+                    src_pixel -= pixel_size_;
+                    dst = std::copy_n(src_pixel, pixel_size_, dst);
+                }
+            }
+        private:
+            size_t pixel_size_;
+        };
+
+        class LutStage : public RowStage
+        {
+        public:
+            LutStage(std::unique_ptr<PipelineStage> upstream,
+                     const std::array<uint8_t, 256>& lut)
+                : RowStage(std::move(upstream)),
+                  lut_(lut),
+                  layout_(get_channel_layout(pixel_type()))
+            {
+                if (layout_.channel_size != 8)
+                    YIMAGE_THROW("LUTs require pixel types with 8 bits per channel.");
+            }
+        protected:
+            void transform_row(const unsigned char* src,
+                               unsigned char* dst) override
+            {
+                auto n = width() * layout_.channels;
+                for (size_t i = 0; i < n; ++i)
+                {
+                    if (i % layout_.channels == layout_.alpha_index)
+                        dst[i] = src[i];
+                    else
+                        dst[i] = lut_[src[i]];
+                }
+            }
+        private:
+            std::array<uint8_t, 256> lut_;
+            ChannelLayout layout_;
+        };
+
+        class FlipVerticallyStage : public PipelineStage
+        {
+        public:
+            explicit FlipVerticallyStage(std::unique_ptr<PipelineStage> upstream)
+                : upstream_(std::move(upstream))
+            {}
+
+            [[nodiscard]]
+            size_t width() const override
+            {
+                return upstream_.stage().width();
+            }
+
+            [[nodiscard]]
+            size_t height() const override
+            {
+                return upstream_.stage().height();
+            }
+
+            [[nodiscard]]
+            PixelType pixel_type() const override
+            {
+                return upstream_.stage().pixel_type();
+            }
+
+            [[nodiscard]]
+            const std::vector<Rgba8>& palette() const override
+            {
+                return upstream_.stage().palette();
+            }
+
+            void read_rows(const MutableImageView& band) override
+            {
+                auto src = upstream_.view();
+                if (!src)
+                {
+                    // The last row is needed first, so everything must
+                    // be read before anything can be returned.
+                    if (!image_)
+                    {
+                        image_ = Image(pixel_type(), width(), height());
+                        for (size_t y = 0; y < height();)
+                        {
+                            auto rows = upstream_.read(height() - y);
+                            for (size_t i = 0; i < rows.height(); ++i, ++y)
+                            {
+                                auto [b, e] = rows.row(i);
+                                std::copy(b, e, image_.row(y).first);
+                            }
+                        }
+                    }
+                    src = image_.view();
+                }
+
+                for (size_t i = 0; i < band.height(); ++i)
+                {
+                    auto [b, e] = src.row(height() - 1 - row_++);
+                    std::copy(b, e, band.row(i).first);
+                }
+            }
+        private:
+            UpstreamReader upstream_;
+            Image image_;
+            size_t row_ = 0;
+        };
+
+        /**
+         * @brief The source pixels that contribute to a destination pixel
+         *      along one axis, and their weights.
+         */
+        struct Contribution
+        {
+            size_t first = 0;
+            std::vector<float> weights;
+        };
+
+        std::vector<Contribution>
+        make_contributions(size_t src_size, size_t dst_size)
+        {
+            std::vector<Contribution> result(dst_size);
+            auto scale = double(src_size) / double(dst_size);
+            for (size_t i = 0; i < dst_size; ++i)
+            {
+                auto& c = result[i];
+                if (scale <= 1)
+                {
+                    auto pos = std::clamp((double(i) + 0.5) * scale - 0.5,
+                                          0.0, double(src_size - 1));
+                    c.first = size_t(pos);
+                    auto t = float(pos - double(c.first));
+                    if (t > 0)
+                        c.weights = {1 - t, t};
+                    else
+                        c.weights = {1};
+                }
+                else
+                {
+                    auto start = double(i) * scale;
+                    auto end = double(i + 1) * scale;
+                    c.first = size_t(start);
+                    auto last = std::min(size_t(std::ceil(end)), src_size);
+                    for (auto j = c.first; j < last; ++j)
+                    {
+                        auto overlap = std::min(end, double(j + 1))
+                                       - std::max(start, double(j));
+                        c.weights.push_back(float(overlap / scale));
+                    }
+                }
+            }
+            return result;
+        }
+
+        template <typename T>
+        void resample_row(const unsigned char* src, float* dst,
+                          const std::vector<Contribution>& contributions,
+                          size_t channels)
+        {
+            auto values = reinterpret_cast<const T*>(src);
+            for (auto& c : contributions)
+            {
+                for (size_t ch = 0; ch < channels; ++ch)
+                {
+                    auto value = values + c.first * channels + ch;
+                    float sum = 0;
+                    for (auto weight : c.weights)
+                    {
+                        sum += weight * float(*value);
+                        value += channels;
+                    }
+                    *dst++ = sum;
+                }
+            }
+        }
+
+        template <typename T>
+        void store_row(const float* src, unsigned char* dst, size_t count)
+        {
+            auto values = reinterpret_cast<T*>(dst);
+            for (size_t i = 0; i < count; ++i)
+            {
+                if constexpr (std::is_floating_point_v<T>)
+                {
+                    values[i] = src[i];
+                }
+                else
+                {
+                    constexpr auto max = float(std::numeric_limits<T>::max());
+                    values[i] = T(std::clamp(src[i] + 0.5f, 0.0f, max));
+                }
+            }
+        }
+
+        /**
+         * @brief Resizes the image with separate horizontal and vertical
+         *      passes.
+         *
+         * Each source row is resampled horizontally as soon as it has
+         * been read, and only the rows needed by the current destination
+         * row are kept.
+         */
+        class ResizeStage : public PipelineStage
+        {
+        public:
+            ResizeStage(std::unique_ptr<PipelineStage> upstream,
+                        size_t width, size_t height)
+                : upstream_(std::move(upstream)),
+                  width_(width),
+                  height_(height),
+                  layout_(get_channel_layout(upstream_.stage().pixel_type()))
+            {
+                auto& src = upstream_.stage();
+                if (width_ == 0 || height_ == 0 || src.width() == 0 || src.height() == 0)
+                    YIMAGE_THROW("Can not resize empty images.");
+
+                columns_ = make_contributions(src.width(), width_);
+                rows_ = make_contributions(src.height(), height_);
+                size_t max_rows = 0;
+                for (auto& c : rows_)
+                    max_rows = std::max(max_rows, c.weights.size());
+                row_values_ = width_ * layout_.channels;
+                cache_.resize(max_rows * row_values_);
+                cache_rows_ = max_rows;
+                sum_.resize(row_values_);
+            }
+
+            [[nodiscard]]
+            size_t width() const override
+            {
+                return width_;
+            }
+
+            [[nodiscard]]
+            size_t height() const override
+            {
+                return height_;
+            }
+
+            [[nodiscard]]
+            PixelType pixel_type() const override
+            {
+                return upstream_.stage().pixel_type();
+            }
+
+            [[nodiscard]]
+            const std::vector<Rgba8>& palette() const override
+            {
+                return upstream_.stage().palette();
+            }
+
+            void read_rows(const MutableImageView& band) override
+            {
+                for (size_t i = 0; i < band.height(); ++i)
+                {
+                    auto& c = rows_[row_++];
+                    while (next_src_row_ < c.first + c.weights.size())
+                        read_source_row();
+
+                    std::fill(sum_.begin(), sum_.end(), 0.0f);
+                    for (size_t j = 0; j < c.weights.size(); ++j)
+                    {
+                        auto cached = cached_row(c.first + j);
+                        auto weight = c.weights[j];
+                        for (size_t k = 0; k < row_values_; ++k)
+                            sum_[k] += weight * cached[k];
+                    }
+                    store(band.row(i).first);
+                }
+            }
+        private:
+            float* cached_row(size_t src_row)
+            {
+                return cache_.data() + (src_row % cache_rows_) * row_values_;
+            }
+
+            void read_source_row()
+            {
+                if (chunk_row_ == chunk_.height())
+                {
+                    chunk_ = upstream_.read(upstream_.stage().height()
+                                            - next_src_row_);
+                    chunk_row_ = 0;
+                }
+
+                auto src = chunk_.row(chunk_row_++).first;
+                auto dst = cached_row(next_src_row_++);
+                if (layout_.channel_size == 8)
+                    resample_row<uint8_t>(src, dst, columns_, layout_.channels);
+                else if (layout_.channel_size == 16)
+                    resample_row<uint16_t>(src, dst, columns_, layout_.channels);
+                else
+                    resample_row<float>(src, dst, columns_, layout_.channels);
+            }
+
+            void store(unsigned char* dst)
+            {
+                if (layout_.channel_size == 8)
+                    store_row<uint8_t>(sum_.data(), dst, row_values_);
+                else if (layout_.channel_size == 16)
+                    store_row<uint16_t>(sum_.data(), dst, row_values_);
+                else
+                    store_row<float>(sum_.data(), dst, row_values_);
+            }
+
+            UpstreamReader upstream_;
+            size_t width_;
+            size_t height_;
+            ChannelLayout layout_;
+            std::vector<Contribution> columns_;
+            std::vector<Contribution> rows_;
+            size_t row_values_ = 0;
+            std::vector<float> cache_;
+            size_t cache_rows_ = 0;
+            std::vector<float> sum_;
+            ImageView chunk_;
+            size_t chunk_row_ = 0;
+            size_t next_src_row_ = 0;
+            size_t row_ = 0;
+        };
+    }
+
+    const std::vector<Rgba8>& PipelineStage::palette() const
+    {
+        static const std::vector<Rgba8> empty;
+        return empty;
+    }
+
+    ImageView PipelineStage::view() const
+    {
+        return {};
+    }
+
+    Pipeline::Pipeline(const ImageView& image)
+        : stage_(std::make_unique<ViewStage>(image))
+    {}
+
+    Pipeline::Pipeline(std::unique_ptr<PipelineStage> source)
+        : stage_(std::move(source))
+    {
+        if (!stage_)
+            YIMAGE_THROW("The pipeline source can not be null.");
+    }
+
+    Pipeline::Pipeline(ImageReader reader)
+        : stage_(std::make_unique<ReaderStage>(std::move(reader)))
+    {}
+
+    Pipeline::Pipeline(Pipeline&& rhs) noexcept = default;
+
+    Pipeline::~Pipeline() = default;
+
+    Pipeline& Pipeline::operator=(Pipeline&& rhs) noexcept = default;
+
+    size_t Pipeline::width() const
+    {
+        return stage().width();
+    }
+
+    size_t Pipeline::height() const
+    {
+        return stage().height();
+    }
+
+    PixelType Pipeline::pixel_type() const
+    {
+        return stage().pixel_type();
+    }
+
+    const std::vector<Rgba8>& Pipeline::palette() const
+    {
+        return stage().palette();
+    }
+
+    Pipeline& Pipeline::convert(PixelType pixel_type)
+    {
+        if (pixel_type != stage().pixel_type())
+            stage_ = std::make_unique<ConvertStage>(std::move(stage_), pixel_type);
+        return *this;
+    }
+
+    Pipeline& Pipeline::crop(size_t x, size_t y, size_t width, size_t height)
+    {
+        stage();
+        stage_ = std::make_unique<CropStage>(std::move(stage_),
+                                             x, y, width, height);
+        return *this;
+    }
+
+    Pipeline& Pipeline::flip_horizontally()
+    {
+        stage();
+        stage_ = std::make_unique<FlipHorizontallyStage>(std::move(stage_));
+        return *this;
+    }
+
+    Pipeline& Pipeline::flip_vertically()
+    {
+        stage();
+        stage_ = std::make_unique<FlipVerticallyStage>(std::move(stage_));
+        return *this;
+    }
+
+    Pipeline& Pipeline::resize(size_t width, size_t height)
+    {
+        if (width != stage().width() || height != stage().height())
+        {
+            stage_ = std::make_unique<ResizeStage>(std::move(stage_),
+                                                   width, height);
+        }
+        return *this;
+    }
+
+    Pipeline& Pipeline::apply_lut(const std::array<uint8_t, 256>& lut)
+    {
+        stage();
+        stage_ = std::make_unique<LutStage>(std::move(stage_), lut);
+        return *this;
+    }
+
+    size_t Pipeline::band_height() const
+    {
+        return band_height_;
+    }
+
+    Pipeline& Pipeline::band_height(size_t rows)
+    {
+        band_height_ = rows;
+        return *this;
+    }
+
+    void Pipeline::run(const std::function<void(const ImageView&)>& sink)
+    {
+        auto stage = release();
+        auto rows = band_height_;
+        if (rows == 0)
+            rows = get_band_height(stage->width(), stage->pixel_type());
+
+        if (auto view = stage->view())
+        {
+            for (size_t y = 0; y < view.height(); y += rows)
+                sink(view.subimage(0, y, SIZE_MAX, rows));
+            return;
+        }
+
+        Image band(stage->pixel_type(), stage->width(),
+                   std::min(rows, stage->height()));
+        for (size_t y = 0; y < stage->height(); y += rows)
+        {
+            auto n = std::min(rows, stage->height() - y);
+            auto view = band.mutable_subimage(0, 0, SIZE_MAX, n);
+            stage->read_rows(view);
+            sink(ImageView(view));
+        }
+    }
+
+    void Pipeline::run(const MutableImageView& image)
+    {
+        if (image.width() != width() || image.height() != height()
+            || image.pixel_type() != pixel_type())
+        {
+            YIMAGE_THROW("The image doesn't match the pipeline's size and pixel type.");
+        }
+
+        auto stage = release();
+        if (image)
+            stage->read_rows(image);
+    }
+
+    Image Pipeline::to_image()
+    {
+        Image image(pixel_type(), width(), height());
+        std::unique_ptr<ImageMetadata> metadata;
+        if (!palette().empty())
+        {
+            metadata = std::make_unique<ImageMetadata>();
+            metadata->palette = palette();
+        }
+        run(image.mutable_view());
+        if (metadata)
+            image.set_metadata(std::move(metadata));
+        return image;
+    }
+
+    std::unique_ptr<PipelineStage> Pipeline::release()
+    {
+        stage();
+        return std::move(stage_);
+    }
+
+    PipelineStage& Pipeline::stage() const
+    {
+        if (!stage_)
+            YIMAGE_THROW("The pipeline has already been run.");
+        return *stage_;
+    }
+}
@@ -14,12 +14,16 @@ namespace Yimage
         switch (type)
         {
         case PixelType::MONO_1:
+        case PixelType::INDEXED_1:
             return 1;
         case PixelType::MONO_2:
+        case PixelType::INDEXED_2:
             return 2;
         case PixelType::MONO_4:
+        case PixelType::INDEXED_4:
             return 4;
         case PixelType::MONO_8:
+        case PixelType::INDEXED_8:
             return 8;
         case PixelType::MONO_16:
         case PixelType::ALPHA_MONO_8:
@@ -42,4 +46,18 @@ namespace Yimage
             return 0;
         }
     }
+
+    bool is_indexed(PixelType type)
+    {
+        switch (type)
+        {
+        case PixelType::INDEXED_1:
+        case PixelType::INDEXED_2:
+        case PixelType::INDEXED_4:
+        case PixelType::INDEXED_8:
+            return true;
+        default:
+            return false;
+        }
+    }
 }
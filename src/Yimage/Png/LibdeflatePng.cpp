@@ -0,0 +1,153 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-19.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "LibdeflatePng.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+#include <libdeflate.h>
+#include "Yimage/YimageException.hpp"
+#include "ParallelPngEncoder.hpp"
+#include "PngFilters.hpp"
+
+namespace Yimage
+{
+    PngInflater::PngInflater() = default;
+
+    PngInflater::PngInflater(PngInflater&& rhs) noexcept
+        : decompressor_(std::exchange(rhs.decompressor_, nullptr)),
+          buffer_(std::move(rhs.buffer_))
+    {}
+
+    PngInflater::~PngInflater()
+    {
+        if (decompressor_)
+            libdeflate_free_decompressor(decompressor_);
+    }
+
+    PngInflater& PngInflater::operator=(PngInflater&& rhs) noexcept
+    {
+        std::swap(decompressor_, rhs.decompressor_);
+        std::swap(buffer_, rhs.buffer_);
+        return *this;
+    }
+
+    std::span<unsigned char>
+    PngInflater::inflate(std::span<const unsigned char> data, size_t size,
+                         bool verify_checksum)
+    {
+        if (!decompressor_)
+        {
+            decompressor_ = libdeflate_alloc_decompressor();
+            if (!decompressor_)
+                YIMAGE_THROW("Can not create libdeflate decompressor.");
+        }
+
+        buffer_.resize(size);
+        libdeflate_result result;
+        if (verify_checksum)
+        {
+            result = libdeflate_zlib_decompress(decompressor_,
+                                                data.data(), data.size(),
+                                                buffer_.data(), size, nullptr);
+        }
+        else if (data.size() < 2)
+        {
+            result = LIBDEFLATE_BAD_DATA;
+        }
+        else
+        {
+            // Skip the two byte zlib header, the raw deflate stream ends
+            // before the Adler-32 checksum.
+            result = libdeflate_deflate_decompress(decompressor_,
+                                                   data.data() + 2,
+                                                   data.size() - 2,
+                                                   buffer_.data(), size,
+                                                   nullptr);
+        }
+
+        if (result != LIBDEFLATE_SUCCESS)
+            YIMAGE_THROW("The PNG image data is corrupt or incomplete.");
+        return buffer_;
+    }
+
+    namespace
+    {
+        // The approximate number of filtered bytes in each band.
+        constexpr size_t BAND_SIZE = 256 * 1024;
+
+        // libpng writes 8 KB IDAT chunks, larger chunks are faster to
+        // read.
+        constexpr size_t IDAT_SIZE = 1024 * 1024;
+
+        struct CompressorDeleter
+        {
+            void operator()(libdeflate_compressor* compressor) const
+            {
+                libdeflate_free_compressor(compressor);
+            }
+        };
+    }
+
+    bool write_png_libdeflate(ImageSink& sink, const ImageView& img,
+                              const PngMetadata& metadata,
+                              const PngWriteOptions& options,
+                              const ExecutionContext& context)
+    {
+        if (metadata.interlace_type != PNG_INTERLACE_NONE || !img)
+            return false;
+
+        const auto row_size = (img.width() * img.pixel_size() + 7) / 8;
+        const auto bpp = std::max<size_t>(img.pixel_size() / 8, 1);
+        const auto filters = get_png_filters(metadata, options);
+
+        std::vector<unsigned char> filtered(img.height() * (row_size + 1));
+        const auto rows_per_band = std::max<size_t>(BAND_SIZE / (row_size + 1), 1);
+        const auto band_count = (img.height() + rows_per_band - 1) / rows_per_band;
+        run_parallel(band_count,
+                     [&](size_t index)
+                     {
+                         RowFilter filter(filters, row_size, bpp);
+                         auto y0 = index * rows_per_band;
+                         auto y1 = std::min(y0 + rows_per_band, img.height());
+                         for (auto y = y0; y < y1; ++y)
+                         {
+                             auto prev = y == 0 ? nullptr : img.row(y - 1).first;
+                             filter.filter(img.row(y).first, prev,
+                                           filtered.data() + y * (row_size + 1));
+                         }
+                     },
+                     context);
+
+        // libdeflate has levels up to 12, but 1 to 9 are close to zlib's.
+        auto level = options.compression_level().value_or(6);
+        if (level < 0)
+            level = 6;
+        std::unique_ptr<libdeflate_compressor, CompressorDeleter> compressor(
+            libdeflate_alloc_compressor(std::min(level, 12)));
+        if (!compressor)
+            YIMAGE_THROW("Can not create libdeflate compressor.");
+
+        std::vector<unsigned char> compressed(libdeflate_zlib_compress_bound(
+            compressor.get(), filtered.size()));
+        auto size = libdeflate_zlib_compress(compressor.get(),
+                                             filtered.data(), filtered.size(),
+                                             compressed.data(), compressed.size());
+        if (size == 0)
+            YIMAGE_THROW("libdeflate failed to compress the image.");
+
+        write_png_header(sink, metadata);
+        for (size_t i = 0; i < size; i += IDAT_SIZE)
+        {
+            write_png_chunk(sink, "IDAT", compressed.data() + i,
+                            std::min(IDAT_SIZE, size - i));
+        }
+        write_png_chunk(sink, "IEND", nullptr, 0);
+        return true;
+    }
+}
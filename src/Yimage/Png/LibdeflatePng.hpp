@@ -0,0 +1,73 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-19.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <span>
+#include <vector>
+#include "Yimage/ExecutionContext.hpp"
+#include "Yimage/ImageSink.hpp"
+#include "Yimage/ImageView.hpp"
+#include "Yimage/Png/PngMetadata.hpp"
+#include "Yimage/Png/PngWriteOptions.hpp"
+
+struct libdeflate_decompressor;
+
+namespace Yimage
+{
+    /**
+     * @brief Inflates the zlib stream in a PNG image's IDAT chunks
+     *      with a single call to libdeflate.
+     *
+     * The decompressor and the output buffer are kept between images.
+     */
+    class PngInflater
+    {
+    public:
+        PngInflater();
+
+        PngInflater(PngInflater&& rhs) noexcept;
+
+        ~PngInflater();
+
+        PngInflater& operator=(PngInflater&& rhs) noexcept;
+
+        /**
+         * @brief Returns the @a size bytes the zlib stream in @a data
+         *      inflates to. The result is valid until the next call.
+         *
+         * Throws an exception if the stream doesn't inflate to exactly
+         * @a size bytes.
+         *
+         * @param verify_checksum Whether the stream's Adler-32 checksum
+         *      is verified.
+         */
+        std::span<unsigned char>
+        inflate(std::span<const unsigned char> data, size_t size,
+                bool verify_checksum);
+    private:
+        libdeflate_decompressor* decompressor_ = nullptr;
+        std::vector<unsigned char> buffer_;
+    };
+
+    /**
+     * @brief Writes @a img as a PNG image where all the rows are
+     *      filtered first, on several threads if @a context allows it,
+     *      and then compressed with a single call to libdeflate.
+     *
+     * Only the IHDR, PLTE and tRNS chunks are written from @a metadata.
+     * The rows of @a img must already be in PNG's byte order. The
+     * compression strategy, window size and memory level in @a options
+     * are ignored.
+     *
+     * @return false, and nothing is written, if @a metadata is
+     *      interlaced or @a img is empty.
+     */
+    bool write_png_libdeflate(ImageSink& sink, const ImageView& img,
+                              const PngMetadata& metadata,
+                              const PngWriteOptions& options,
+                              const ExecutionContext& context);
+}
@@ -0,0 +1,336 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-19.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "ParallelPngEncoder.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include <zlib.h>
+#include "Yimage/YimageException.hpp"
+#include "PngFilters.hpp"
+
+namespace Yimage
+{
+    namespace
+    {
+        // The approximate number of filtered bytes in each band.
+        constexpr size_t BAND_SIZE = 256 * 1024;
+
+        struct DeflateSettings
+        {
+            int level = 6;
+            int strategy = Z_DEFAULT_STRATEGY;
+            int window_bits = 15;
+            int memory_level = 8;
+            int filters = PNG_ALL_FILTERS;
+        };
+
+        // Uses the same defaults as libpng.
+        DeflateSettings get_settings(const PngMetadata& metadata,
+                                     const PngWriteOptions& options)
+        {
+            DeflateSettings result;
+            result.filters = get_png_filters(metadata, options);
+            result.level = options.compression_level().value_or(6);
+            if (result.level == Z_DEFAULT_COMPRESSION)
+                result.level = 6;
+            result.strategy = options.compression_strategy().value_or(
+                result.filters == PNG_FILTER_NONE ? Z_DEFAULT_STRATEGY : Z_FILTERED);
+            // Raw deflate streams don't accept a window size of 256 bytes.
+            result.window_bits = std::clamp(options.window_bits().value_or(15), 9, 15);
+            result.memory_level = options.memory_level().value_or(8);
+            return result;
+        }
+
+        struct Band
+        {
+            std::vector<unsigned char> filtered;
+            std::vector<unsigned char> output;
+            uLong adler = 1;
+        };
+
+        class BandEncoder
+        {
+        public:
+            BandEncoder(const ImageView& img, const DeflateSettings& settings,
+                        size_t rows_per_band)
+                : img_(img),
+                  settings_(settings),
+                  rows_per_band_(rows_per_band),
+                  row_size_((img.width() * img.pixel_size() + 7) / 8),
+                  bpp_(std::max<size_t>(img.pixel_size() / 8, 1))
+            {
+                // The rows before a band are filtered again to produce
+                // its dictionary.
+                auto window_size = size_t(1) << settings.window_bits;
+                dictionary_rows_ = (window_size + row_size_) / (row_size_ + 1);
+            }
+
+            [[nodiscard]]
+            size_t band_count() const
+            {
+                return (img_.height() + rows_per_band_ - 1) / rows_per_band_;
+            }
+
+            void encode(size_t index, Band& band) const
+            {
+                auto y0 = index * rows_per_band_;
+                auto y1 = std::min(y0 + rows_per_band_, img_.height());
+                RowFilter filter(settings_.filters, row_size_, bpp_);
+
+                z_stream stream = {};
+                if (deflateInit2(&stream, settings_.level, Z_DEFLATED,
+                                 -settings_.window_bits, settings_.memory_level,
+                                 settings_.strategy) != Z_OK)
+                {
+                    YIMAGE_THROW("Can not initialize zlib.");
+                }
+
+                try
+                {
+                    if (y0 != 0)
+                    {
+                        auto yd = y0 - std::min(y0, dictionary_rows_);
+                        filter_rows(filter, yd, y0, band.filtered);
+                        auto window_size = size_t(1) << settings_.window_bits;
+                        auto dict_size = std::min(window_size, band.filtered.size());
+                        deflateSetDictionary(
+                            &stream,
+                            band.filtered.data() + band.filtered.size() - dict_size,
+                            uInt(dict_size));
+                    }
+
+                    filter_rows(filter, y0, y1, band.filtered);
+                    band.adler = adler32(1, band.filtered.data(),
+                                         uInt(band.filtered.size()));
+                    deflate_band(stream, band, y1 == img_.height());
+                }
+                catch (...)
+                {
+                    deflateEnd(&stream);
+                    throw;
+                }
+                deflateEnd(&stream);
+            }
+        private:
+            void filter_rows(RowFilter& filter, size_t y0, size_t y1,
+                             std::vector<unsigned char>& out) const
+            {
+                out.resize((y1 - y0) * (row_size_ + 1));
+                auto dst = out.data();
+                for (size_t y = y0; y < y1; ++y)
+                {
+                    auto prev = y == 0 ? nullptr : img_.row(y - 1).first;
+                    filter.filter(img_.row(y).first, prev, dst);
+                    dst += row_size_ + 1;
+                }
+            }
+
+            static void deflate_band(z_stream& stream, Band& band, bool last)
+            {
+                band.output.resize(deflateBound(&stream, uLong(band.filtered.size())) + 16);
+                stream.next_in = band.filtered.data();
+                stream.avail_in = uInt(band.filtered.size());
+                stream.next_out = band.output.data();
+                stream.avail_out = uInt(band.output.size());
+
+                auto flush = last ? Z_FINISH : Z_SYNC_FLUSH;
+                while (true)
+                {
+                    auto result = deflate(&stream, flush);
+                    if (result == Z_STREAM_END
+                        || (result == Z_OK && !last && stream.avail_out != 0))
+                    {
+                        break;
+                    }
+                    if (result != Z_OK && result != Z_BUF_ERROR)
+                        YIMAGE_THROW("zlib failed to compress the image.");
+
+                    auto used = band.output.size() - stream.avail_out;
+                    band.output.resize(band.output.size() * 2);
+                    stream.next_out = band.output.data() + used;
+                    stream.avail_out = uInt(band.output.size() - used);
+                }
+                band.output.resize(band.output.size() - stream.avail_out);
+            }
+
+            const ImageView& img_;
+            DeflateSettings settings_;
+            size_t rows_per_band_;
+            size_t row_size_;
+            size_t bpp_;
+            size_t dictionary_rows_;
+        };
+
+        // The same two bytes deflateInit2 would have written.
+        std::array<unsigned char, 2> get_zlib_header(const DeflateSettings& settings)
+        {
+            unsigned cmf = unsigned(settings.window_bits - 8) << 4 | Z_DEFLATED;
+            unsigned level_flags = 3;
+            if (settings.strategy >= Z_HUFFMAN_ONLY || settings.level < 2)
+                level_flags = 0;
+            else if (settings.level < 6)
+                level_flags = 1;
+            else if (settings.level == 6)
+                level_flags = 2;
+            unsigned flg = level_flags << 6;
+            flg += 31 - (cmf * 256 + flg) % 31;
+            return {uint8_t(cmf), uint8_t(flg)};
+        }
+    }
+
+    int get_png_filters(const PngMetadata& metadata,
+                        const PngWriteOptions& options)
+    {
+        int result = PNG_ALL_FILTERS;
+        if (auto filters = options.filters())
+        {
+            // Like png_set_filter, accept a single filter value too.
+            if (*filters >= PNG_FILTER_VALUE_NONE
+                && *filters < PNG_FILTER_VALUE_LAST)
+            {
+                result = PNG_FILTER_NONE << *filters;
+            }
+            else
+            {
+                result = *filters & PNG_ALL_FILTERS;
+            }
+        }
+        else if (metadata.bit_depth < 8
+                 || metadata.color_type == PNG_COLOR_TYPE_PALETTE)
+        {
+            result = PNG_FILTER_NONE;
+        }
+
+        return result == 0 ? PNG_FILTER_NONE : result;
+    }
+
+    void write_png_chunk(ImageSink& sink, const char* type,
+                         const unsigned char* data, size_t size)
+    {
+        unsigned char header[8];
+        png_save_uint_32(header, png_uint_32(size));
+        std::memcpy(header + 4, type, 4);
+        sink.write(header, 8);
+        if (size != 0)
+            sink.write(data, size);
+
+        auto crc = crc32(0, header + 4, 4);
+        crc = crc32(crc, data, uInt(size));
+        unsigned char trailer[4];
+        png_save_uint_32(trailer, png_uint_32(crc));
+        sink.write(trailer, 4);
+    }
+
+    void write_png_header(ImageSink& sink, const PngMetadata& metadata)
+    {
+        const unsigned char signature[] = {137, 80, 78, 71, 13, 10, 26, 10};
+        sink.write(signature, sizeof(signature));
+
+        unsigned char ihdr[13];
+        png_save_uint_32(ihdr, metadata.width);
+        png_save_uint_32(ihdr + 4, metadata.height);
+        ihdr[8] = uint8_t(metadata.bit_depth);
+        ihdr[9] = uint8_t(metadata.color_type);
+        ihdr[10] = PNG_COMPRESSION_TYPE_BASE;
+        ihdr[11] = PNG_FILTER_TYPE_BASE;
+        ihdr[12] = PNG_INTERLACE_NONE;
+        write_png_chunk(sink, "IHDR", ihdr, sizeof(ihdr));
+
+        if (metadata.color_type != PNG_COLOR_TYPE_PALETTE)
+            return;
+
+        const auto& palette = metadata.palette;
+        std::vector<unsigned char> buffer(palette.size() * 3);
+        for (size_t i = 0; i < palette.size(); ++i)
+        {
+            buffer[i * 3] = palette[i].r;
+            buffer[i * 3 + 1] = palette[i].g;
+            buffer[i * 3 + 2] = palette[i].b;
+        }
+        write_png_chunk(sink, "PLTE", buffer.data(), buffer.size());
+
+        // The tRNS chunk can leave out the opaque colors at the end.
+        auto alpha_count = palette.size();
+        while (alpha_count != 0 && palette[alpha_count - 1].a == 0xFF)
+            --alpha_count;
+        if (alpha_count == 0)
+            return;
+
+        buffer.resize(alpha_count);
+        for (size_t i = 0; i < alpha_count; ++i)
+            buffer[i] = palette[i].a;
+        write_png_chunk(sink, "tRNS", buffer.data(), buffer.size());
+    }
+
+    bool write_png_parallel(ImageSink& sink, const ImageView& img,
+                            const PngMetadata& metadata,
+                            const PngWriteOptions& options,
+                            const ExecutionContext& context)
+    {
+        if (metadata.interlace_type != PNG_INTERLACE_NONE || !img)
+            return false;
+
+        auto threads = context.max_threads();
+        if (threads <= 1)
+            return false;
+
+        const auto row_size = (img.width() * img.pixel_size() + 7) / 8 + 1;
+        auto band_size = BAND_SIZE;
+        if (context.parallelism() == ParallelismHint::MAXIMUM)
+        {
+            // Make sure there's at least one band per thread.
+            band_size = std::min(band_size, row_size * img.height() / threads);
+        }
+        auto rows_per_band = std::max<size_t>(band_size / row_size, 1);
+        if (rows_per_band >= img.height())
+            return false;
+
+        auto settings = get_settings(metadata, options);
+        BandEncoder encoder(img, settings, rows_per_band);
+
+        write_png_header(sink, metadata);
+
+        // Bands are encoded a few at a time to limit the memory use.
+        const auto band_count = encoder.band_count();
+        std::vector<Band> bands(std::min(band_count, 2 * threads));
+        uLong adler = 1;
+        for (size_t first = 0; first < band_count; first += bands.size())
+        {
+            auto count = std::min(bands.size(), band_count - first);
+            run_parallel(count,
+                         [&](size_t i) {encoder.encode(first + i, bands[i]);},
+                         context);
+
+            for (size_t i = 0; i < count; ++i)
+            {
+                auto& band = bands[i];
+                adler = adler32_combine(adler, band.adler,
+                                        z_off_t(band.filtered.size()));
+                if (first + i == 0)
+                {
+                    auto header = get_zlib_header(settings);
+                    band.output.insert(band.output.begin(),
+                                       header.begin(), header.end());
+                }
+                if (first + i == band_count - 1)
+                {
+                    unsigned char trailer[4];
+                    png_save_uint_32(trailer, png_uint_32(adler));
+                    band.output.insert(band.output.end(), trailer, trailer + 4);
+                }
+                write_png_chunk(sink, "IDAT", band.output.data(), band.output.size());
+            }
+        }
+
+        write_png_chunk(sink, "IEND", nullptr, 0);
+        return true;
+    }
+}
@@ -0,0 +1,58 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-19.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include "Yimage/ExecutionContext.hpp"
+#include "Yimage/ImageSink.hpp"
+#include "Yimage/ImageView.hpp"
+#include "Yimage/Png/PngMetadata.hpp"
+#include "Yimage/Png/PngWriteOptions.hpp"
+
+namespace Yimage
+{
+    /**
+     * @brief Returns the PNG_FILTER_* flags for the filters the encoder
+     *      chooses between, with the same defaults as libpng.
+     */
+    [[nodiscard]]
+    int get_png_filters(const PngMetadata& metadata,
+                        const PngWriteOptions& options);
+
+    /**
+     * @brief Writes a PNG chunk with its length and CRC.
+     */
+    void write_png_chunk(ImageSink& sink, const char* type,
+                         const unsigned char* data, size_t size);
+
+    /**
+     * @brief Writes the PNG signature and the IHDR chunk, followed by
+     *      the PLTE and tRNS chunks for indexed images.
+     */
+    void write_png_header(ImageSink& sink, const PngMetadata& metadata);
+
+    /**
+     * @brief Writes @a img as a PNG image where bands of rows are
+     *      filtered and compressed on separate threads.
+     *
+     * Each band is compressed as an independent raw deflate stream
+     * that ends with a sync flush and uses the end of the previous
+     * band as its dictionary. The streams are concatenated into a
+     * single zlib stream with the Adler-32 checksums combined, so
+     * the result is an ordinary PNG file.
+     *
+     * Only the IHDR chunk is written from @a metadata. The rows of
+     * @a img must already be in PNG's byte order.
+     *
+     * @return false, and nothing is written, if @a metadata is
+     *      interlaced or @a img is too small to be split into more
+     *      than one band for the number of threads in @a context.
+     */
+    bool write_png_parallel(ImageSink& sink, const ImageView& img,
+                            const PngMetadata& metadata,
+                            const PngWriteOptions& options,
+                            const ExecutionContext& context);
+}
@@ -0,0 +1,432 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-19.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "PngFilters.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) \
+    || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define YIMAGE_PNG_SSE2
+    #include <emmintrin.h>
+#endif
+
+namespace Yimage
+{
+    namespace
+    {
+        unsigned char paeth(int a, int b, int c)
+        {
+            auto p = a + b - c;
+            auto pa = std::abs(p - a);
+            auto pb = std::abs(p - b);
+            auto pc = std::abs(p - c);
+            if (pa <= pb && pa <= pc)
+                return uint8_t(a);
+            if (pb <= pc)
+                return uint8_t(b);
+            return uint8_t(c);
+        }
+
+#ifdef YIMAGE_PNG_SSE2
+        __m128i load(const unsigned char* p)
+        {
+            return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        }
+
+        void store(unsigned char* p, __m128i v)
+        {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v);
+        }
+
+        template <size_t BPP>
+        __m128i load_pixel(const unsigned char* p)
+        {
+            int32_t value = 0;
+            std::memcpy(&value, p, BPP);
+            return _mm_cvtsi32_si128(value);
+        }
+
+        template <size_t BPP>
+        void store_pixel(unsigned char* p, __m128i v)
+        {
+            auto value = _mm_cvtsi128_si32(v);
+            std::memcpy(p, &value, BPP);
+        }
+
+        __m128i select(__m128i mask, __m128i a, __m128i b)
+        {
+            return _mm_or_si128(_mm_and_si128(mask, a),
+                                _mm_andnot_si128(mask, b));
+        }
+
+        __m128i abs_epi16(__m128i v)
+        {
+            return _mm_max_epi16(v, _mm_sub_epi16(_mm_setzero_si128(), v));
+        }
+
+        // The floor of (a + b) / 2, _mm_avg_epu8 rounds up.
+        __m128i floor_avg_epu8(__m128i a, __m128i b)
+        {
+            auto odd = _mm_and_si128(_mm_xor_si128(a, b), _mm_set1_epi8(1));
+            return _mm_sub_epi8(_mm_avg_epu8(a, b), odd);
+        }
+
+        /**
+         * @brief The Paeth predictor for eight 16-bit values, with the
+         *      same tie-breaking as paeth().
+         */
+        __m128i paeth_epi16(__m128i a, __m128i b, __m128i c)
+        {
+            auto pa = _mm_sub_epi16(b, c);
+            auto pb = _mm_sub_epi16(a, c);
+            auto pc = abs_epi16(_mm_add_epi16(pa, pb));
+            pa = abs_epi16(pa);
+            pb = abs_epi16(pb);
+            auto smallest = _mm_min_epi16(pc, _mm_min_epi16(pa, pb));
+            return select(_mm_cmpeq_epi16(pa, smallest), a,
+                          select(_mm_cmpeq_epi16(pb, smallest), b, c));
+        }
+
+        __m128i paeth_epu8(__m128i a, __m128i b, __m128i c)
+        {
+            auto zero = _mm_setzero_si128();
+            auto lo = paeth_epi16(_mm_unpacklo_epi8(a, zero),
+                                  _mm_unpacklo_epi8(b, zero),
+                                  _mm_unpacklo_epi8(c, zero));
+            auto hi = paeth_epi16(_mm_unpackhi_epi8(a, zero),
+                                  _mm_unpackhi_epi8(b, zero),
+                                  _mm_unpackhi_epi8(c, zero));
+            return _mm_packus_epi16(lo, hi);
+        }
+#endif
+
+        void filter_sub(const unsigned char* row, size_t size, size_t bpp,
+                        unsigned char* out)
+        {
+            size_t i = std::min(bpp, size);
+            std::memcpy(out, row, i);
+#ifdef YIMAGE_PNG_SSE2
+            for (; i + 16 <= size; i += 16)
+                store(out + i, _mm_sub_epi8(load(row + i), load(row + i - bpp)));
+#endif
+            for (; i < size; ++i)
+                out[i] = uint8_t(row[i] - row[i - bpp]);
+        }
+
+        void filter_up(const unsigned char* row, const unsigned char* prev,
+                       size_t size, unsigned char* out)
+        {
+            size_t i = 0;
+#ifdef YIMAGE_PNG_SSE2
+            for (; i + 16 <= size; i += 16)
+                store(out + i, _mm_sub_epi8(load(row + i), load(prev + i)));
+#endif
+            for (; i < size; ++i)
+                out[i] = uint8_t(row[i] - prev[i]);
+        }
+
+        void filter_avg(const unsigned char* row, const unsigned char* prev,
+                        size_t size, size_t bpp, unsigned char* out)
+        {
+            size_t i = 0;
+            for (; i < std::min(bpp, size); ++i)
+                out[i] = uint8_t(row[i] - prev[i] / 2);
+#ifdef YIMAGE_PNG_SSE2
+            for (; i + 16 <= size; i += 16)
+            {
+                auto avg = floor_avg_epu8(load(row + i - bpp), load(prev + i));
+                store(out + i, _mm_sub_epi8(load(row + i), avg));
+            }
+#endif
+            for (; i < size; ++i)
+                out[i] = uint8_t(row[i] - (row[i - bpp] + prev[i]) / 2);
+        }
+
+        void filter_paeth(const unsigned char* row, const unsigned char* prev,
+                          size_t size, size_t bpp, unsigned char* out)
+        {
+            size_t i = 0;
+            for (; i < std::min(bpp, size); ++i)
+                out[i] = uint8_t(row[i] - prev[i]);
+#ifdef YIMAGE_PNG_SSE2
+            for (; i + 16 <= size; i += 16)
+            {
+                auto predicted = paeth_epu8(load(row + i - bpp), load(prev + i),
+                                            load(prev + i - bpp));
+                store(out + i, _mm_sub_epi8(load(row + i), predicted));
+            }
+#endif
+            for (; i < size; ++i)
+                out[i] = uint8_t(row[i] - paeth(row[i - bpp], prev[i],
+                                                prev[i - bpp]));
+        }
+
+        // libpng's heuristic: the sum of the filtered bytes interpreted
+        // as signed values.
+        size_t get_filter_cost(const unsigned char* filtered, size_t size)
+        {
+            size_t sum = 0;
+            size_t i = 0;
+#ifdef YIMAGE_PNG_SSE2
+            auto zero = _mm_setzero_si128();
+            auto sums = zero;
+            for (; i + 16 <= size; i += 16)
+            {
+                auto v = load(filtered + i);
+                auto abs = _mm_min_epu8(v, _mm_sub_epi8(zero, v));
+                sums = _mm_add_epi64(sums, _mm_sad_epu8(abs, zero));
+            }
+            sum = size_t(uint32_t(_mm_cvtsi128_si32(sums)))
+                  + size_t(uint32_t(_mm_cvtsi128_si32(_mm_srli_si128(sums, 8))));
+#endif
+            for (; i < size; ++i)
+                sum += filtered[i] < 128 ? filtered[i] : 256 - filtered[i];
+            return sum;
+        }
+
+        void unfilter_up(const unsigned char* src, const unsigned char* prev,
+                         size_t size, unsigned char* dst)
+        {
+            size_t i = 0;
+#ifdef YIMAGE_PNG_SSE2
+            for (; i + 16 <= size; i += 16)
+                store(dst + i, _mm_add_epi8(load(src + i), load(prev + i)));
+#endif
+            for (; i < size; ++i)
+                dst[i] = uint8_t(src[i] + prev[i]);
+        }
+
+        void unfilter_sub(const unsigned char* src, size_t size, size_t bpp,
+                          unsigned char* dst)
+        {
+            std::memmove(dst, src, std::min(bpp, size));
+            for (size_t i = bpp; i < size; ++i)
+                dst[i] = uint8_t(src[i] + dst[i - bpp]);
+        }
+
+        void unfilter_avg(const unsigned char* src, const unsigned char* prev,
+                          size_t size, size_t bpp, unsigned char* dst)
+        {
+            size_t i = 0;
+            if (prev)
+            {
+                for (; i < std::min(bpp, size); ++i)
+                    dst[i] = uint8_t(src[i] + prev[i] / 2);
+                for (; i < size; ++i)
+                    dst[i] = uint8_t(src[i] + (dst[i - bpp] + prev[i]) / 2);
+            }
+            else
+            {
+                for (; i < std::min(bpp, size); ++i)
+                    dst[i] = src[i];
+                for (; i < size; ++i)
+                    dst[i] = uint8_t(src[i] + dst[i - bpp] / 2);
+            }
+        }
+
+        void unfilter_paeth(const unsigned char* src, const unsigned char* prev,
+                            size_t size, size_t bpp, unsigned char* dst)
+        {
+            size_t i = 0;
+            for (; i < std::min(bpp, size); ++i)
+                dst[i] = uint8_t(src[i] + prev[i]);
+            for (; i < size; ++i)
+            {
+                dst[i] = uint8_t(src[i] + paeth(dst[i - bpp], prev[i],
+                                                prev[i - bpp]));
+            }
+        }
+
+#ifdef YIMAGE_PNG_SSE2
+        // The pixels depend on each other from left to right in the
+        // last three filters, so the SIMD versions do one pixel at a
+        // time with the pixel's bytes in separate lanes.
+
+        template <size_t BPP>
+        void unfilter_sub(const unsigned char* src, size_t size,
+                          unsigned char* dst)
+        {
+            auto a = _mm_setzero_si128();
+            for (size_t i = 0; i < size; i += BPP)
+            {
+                a = _mm_add_epi8(load_pixel<BPP>(src + i), a);
+                store_pixel<BPP>(dst + i, a);
+            }
+        }
+
+        template <size_t BPP>
+        void unfilter_avg(const unsigned char* src, const unsigned char* prev,
+                          size_t size, unsigned char* dst)
+        {
+            auto a = _mm_setzero_si128();
+            for (size_t i = 0; i < size; i += BPP)
+            {
+                auto avg = floor_avg_epu8(a, load_pixel<BPP>(prev + i));
+                a = _mm_add_epi8(load_pixel<BPP>(src + i), avg);
+                store_pixel<BPP>(dst + i, a);
+            }
+        }
+
+        template <size_t BPP>
+        void unfilter_paeth(const unsigned char* src, const unsigned char* prev,
+                            size_t size, unsigned char* dst)
+        {
+            auto zero = _mm_setzero_si128();
+            auto a = zero;
+            auto c = zero;
+            for (size_t i = 0; i < size; i += BPP)
+            {
+                auto b = _mm_unpacklo_epi8(load_pixel<BPP>(prev + i), zero);
+                auto d = _mm_unpacklo_epi8(load_pixel<BPP>(src + i), zero);
+                a = _mm_add_epi16(d, paeth_epi16(a, b, c));
+                a = _mm_and_si128(a, _mm_set1_epi16(0xFF));
+                store_pixel<BPP>(dst + i, _mm_packus_epi16(a, a));
+                c = b;
+            }
+        }
+#endif
+    }
+
+    void apply_filter(int filter,
+                      const unsigned char* row,
+                      const unsigned char* prev,
+                      size_t size, size_t bpp,
+                      unsigned char* out)
+    {
+        *out++ = uint8_t(filter);
+        switch (filter)
+        {
+        case PNG_FILTER_VALUE_NONE:
+            std::memcpy(out, row, size);
+            break;
+        case PNG_FILTER_VALUE_SUB:
+            filter_sub(row, size, bpp, out);
+            break;
+        case PNG_FILTER_VALUE_UP:
+            filter_up(row, prev, size, out);
+            break;
+        case PNG_FILTER_VALUE_AVG:
+            filter_avg(row, prev, size, bpp, out);
+            break;
+        case PNG_FILTER_VALUE_PAETH:
+            filter_paeth(row, prev, size, bpp, out);
+            break;
+        default:
+            break;
+        }
+    }
+
+    bool unfilter_row(int filter,
+                      const unsigned char* src,
+                      const unsigned char* prev,
+                      size_t size, size_t bpp,
+                      unsigned char* dst)
+    {
+        // Without a previous row, Up is the same as None and Paeth
+        // the same as Sub.
+        if (!prev)
+        {
+            if (filter == PNG_FILTER_VALUE_UP)
+                filter = PNG_FILTER_VALUE_NONE;
+            else if (filter == PNG_FILTER_VALUE_PAETH)
+                filter = PNG_FILTER_VALUE_SUB;
+        }
+
+        switch (filter)
+        {
+        case PNG_FILTER_VALUE_NONE:
+            if (dst != src)
+                std::memcpy(dst, src, size);
+            return true;
+        case PNG_FILTER_VALUE_UP:
+            unfilter_up(src, prev, size, dst);
+            return true;
+#ifdef YIMAGE_PNG_SSE2
+        case PNG_FILTER_VALUE_SUB:
+            if (bpp == 3)
+                unfilter_sub<3>(src, size, dst);
+            else if (bpp == 4)
+                unfilter_sub<4>(src, size, dst);
+            else
+                unfilter_sub(src, size, bpp, dst);
+            return true;
+        case PNG_FILTER_VALUE_AVG:
+            if (prev && bpp == 3)
+                unfilter_avg<3>(src, prev, size, dst);
+            else if (prev && bpp == 4)
+                unfilter_avg<4>(src, prev, size, dst);
+            else
+                unfilter_avg(src, prev, size, bpp, dst);
+            return true;
+        case PNG_FILTER_VALUE_PAETH:
+            if (bpp == 3)
+                unfilter_paeth<3>(src, prev, size, dst);
+            else if (bpp == 4)
+                unfilter_paeth<4>(src, prev, size, dst);
+            else
+                unfilter_paeth(src, prev, size, bpp, dst);
+            return true;
+#else
+        case PNG_FILTER_VALUE_SUB:
+            unfilter_sub(src, size, bpp, dst);
+            return true;
+        case PNG_FILTER_VALUE_AVG:
+            unfilter_avg(src, prev, size, bpp, dst);
+            return true;
+        case PNG_FILTER_VALUE_PAETH:
+            unfilter_paeth(src, prev, size, bpp, dst);
+            return true;
+#endif
+        default:
+            return false;
+        }
+    }
+
+    RowFilter::RowFilter(int filters, size_t row_size, size_t bpp)
+        : row_size_(row_size),
+          bpp_(bpp),
+          zeros_(row_size)
+    {
+        for (int i = 0; i < PNG_FILTER_VALUE_LAST; ++i)
+        {
+            if (filters & (PNG_FILTER_NONE << i))
+                candidates_.push_back(i);
+        }
+        if (candidates_.size() > 1)
+            scratch_.resize(row_size + 1);
+    }
+
+    void RowFilter::filter(const unsigned char* row, const unsigned char* prev,
+                           unsigned char* out)
+    {
+        if (!prev)
+            prev = zeros_.data();
+
+        if (candidates_.size() == 1)
+        {
+            apply_filter(candidates_[0], row, prev, row_size_, bpp_, out);
+            return;
+        }
+
+        auto best_cost = SIZE_MAX;
+        for (auto candidate : candidates_)
+        {
+            apply_filter(candidate, row, prev, row_size_, bpp_,
+                         scratch_.data());
+            auto cost = get_filter_cost(scratch_.data() + 1, row_size_);
+            if (cost < best_cost)
+            {
+                best_cost = cost;
+                std::memcpy(out, scratch_.data(), row_size_ + 1);
+            }
+        }
+    }
+}
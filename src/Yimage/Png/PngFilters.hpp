@@ -0,0 +1,71 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-19.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <cstddef>
+#include <vector>
+#include <png.h>
+
+namespace Yimage
+{
+    /**
+     * @brief Applies one of PNG's five filters to @a row and writes
+     *      the filter type followed by the filtered bytes to @a out.
+     *
+     * @param prev The previous row. Must not be nullptr.
+     * @param size The number of bytes in @a row.
+     * @param bpp The number of bytes per pixel, rounded up to 1.
+     */
+    void apply_filter(int filter,
+                      const unsigned char* row,
+                      const unsigned char* prev,
+                      size_t size, size_t bpp,
+                      unsigned char* out);
+
+    /**
+     * @brief Reverses the filter in a row of a PNG image.
+     *
+     * @param filter The filter type byte that precedes the row in the
+     *      image data.
+     * @param src The @a size filtered bytes that follow the filter type.
+     * @param prev The previous unfiltered row, or nullptr for the first
+     *      row of the image or of an Adam7 pass.
+     * @param dst Receives the unfiltered row. May be the same as @a src.
+     * @return false if @a filter isn't a valid filter type.
+     */
+    bool unfilter_row(int filter,
+                      const unsigned char* src,
+                      const unsigned char* prev,
+                      size_t size, size_t bpp,
+                      unsigned char* dst);
+
+    /**
+     * @brief Chooses the filter for each row among a set of filters
+     *      with libpng's heuristic, the lowest sum of the filtered bytes
+     *      interpreted as signed values.
+     */
+    class RowFilter
+    {
+    public:
+        RowFilter(int filters, size_t row_size, size_t bpp);
+
+        /**
+         * @brief Filters @a row and writes the result, which is one
+         *      byte longer than the row, to @a out.
+         *
+         * @param prev The previous row, or nullptr for the first row.
+         */
+        void filter(const unsigned char* row, const unsigned char* prev,
+                    unsigned char* out);
+    private:
+        size_t row_size_;
+        size_t bpp_;
+        std::vector<int> candidates_;
+        std::vector<unsigned char> zeros_;
+        std::vector<unsigned char> scratch_;
+    };
+}
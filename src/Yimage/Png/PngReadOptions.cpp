@@ -0,0 +1,27 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-19.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "Yimage/Png/PngReadOptions.hpp"
+
+namespace Yimage
+{
+    PngReadOptions PngReadOptions::trusted()
+    {
+        return PngReadOptions().verify_checksums(false);
+    }
+
+    bool PngReadOptions::verify_checksums() const
+    {
+        return verify_checksums_;
+    }
+
+    PngReadOptions& PngReadOptions::verify_checksums(bool value)
+    {
+        verify_checksums_ = value;
+        return *this;
+    }
+}
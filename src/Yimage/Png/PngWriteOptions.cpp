@@ -0,0 +1,126 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-19.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "Yimage/Png/PngWriteOptions.hpp"
+
+#include <png.h>
+
+namespace Yimage
+{
+    PngWriteOptions PngWriteOptions::fastest()
+    {
+        return PngWriteOptions()
+            .compression_level(1)
+            .filters(PNG_FILTER_SUB)
+            .buffer_size(64 * 1024);
+    }
+
+    PngWriteOptions PngWriteOptions::balanced()
+    {
+        return PngWriteOptions()
+            .compression_level(6)
+            .filters(PNG_ALL_FILTERS);
+    }
+
+    PngWriteOptions PngWriteOptions::smallest()
+    {
+        return PngWriteOptions()
+            .compression_level(9)
+            .window_bits(15)
+            .memory_level(9)
+            .filters(PNG_ALL_FILTERS)
+            .buffer_size(64 * 1024);
+    }
+
+    const std::optional<int>& PngWriteOptions::compression_level() const
+    {
+        return compression_level_;
+    }
+
+    PngWriteOptions& PngWriteOptions::compression_level(std::optional<int> value)
+    {
+        compression_level_ = value;
+        return *this;
+    }
+
+    const std::optional<int>& PngWriteOptions::compression_strategy() const
+    {
+        return compression_strategy_;
+    }
+
+    PngWriteOptions& PngWriteOptions::compression_strategy(std::optional<int> value)
+    {
+        compression_strategy_ = value;
+        return *this;
+    }
+
+    const std::optional<int>& PngWriteOptions::window_bits() const
+    {
+        return window_bits_;
+    }
+
+    PngWriteOptions& PngWriteOptions::window_bits(std::optional<int> value)
+    {
+        window_bits_ = value;
+        return *this;
+    }
+
+    const std::optional<int>& PngWriteOptions::memory_level() const
+    {
+        return memory_level_;
+    }
+
+    PngWriteOptions& PngWriteOptions::memory_level(std::optional<int> value)
+    {
+        memory_level_ = value;
+        return *this;
+    }
+
+    const std::optional<int>& PngWriteOptions::filters() const
+    {
+        return filters_;
+    }
+
+    PngWriteOptions& PngWriteOptions::filters(std::optional<int> value)
+    {
+        filters_ = value;
+        return *this;
+    }
+
+    const std::optional<size_t>& PngWriteOptions::buffer_size() const
+    {
+        return buffer_size_;
+    }
+
+    PngWriteOptions& PngWriteOptions::buffer_size(std::optional<size_t> value)
+    {
+        buffer_size_ = value;
+        return *this;
+    }
+
+    const std::optional<QuantizeOptions>& PngWriteOptions::quantize() const
+    {
+        return quantize_;
+    }
+
+    PngWriteOptions& PngWriteOptions::quantize(std::optional<QuantizeOptions> value)
+    {
+        quantize_ = value;
+        return *this;
+    }
+
+    bool PngWriteOptions::interlaced() const
+    {
+        return interlaced_;
+    }
+
+    PngWriteOptions& PngWriteOptions::interlaced(bool value)
+    {
+        interlaced_ = value;
+        return *this;
+    }
+}
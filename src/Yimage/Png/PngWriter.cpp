@@ -9,6 +9,7 @@
 
 #include <ostream>
 #include <utility>
+#include <vector>
 #include "Yimage/YimageException.hpp"
 
 namespace Yimage
@@ -53,21 +54,64 @@ namespace Yimage
             return (info.width * get_pixel_size(info, transform) + 7) / 8;
         }
 
+        void set_palette(png_structp png_ptr, png_infop info_ptr,
+                         const std::vector<Rgba8>& palette)
+        {
+            std::vector<png_color> colors(palette.size());
+            for (size_t i = 0; i < palette.size(); ++i)
+                colors[i] = {palette[i].r, palette[i].g, palette[i].b};
+            png_set_PLTE(png_ptr, info_ptr, colors.data(), int(colors.size()));
+
+            // The tRNS chunk can leave out the opaque colors at the end.
+            auto alpha_count = palette.size();
+            while (alpha_count != 0 && palette[alpha_count - 1].a == 0xFF)
+                --alpha_count;
+            if (alpha_count == 0)
+                return;
+
+            std::vector<png_byte> alphas(alpha_count);
+            for (size_t i = 0; i < alpha_count; ++i)
+                alphas[i] = palette[i].a;
+            png_set_tRNS(png_ptr, info_ptr, alphas.data(), int(alpha_count),
+                         nullptr);
+        }
+
         extern "C" {
 
         void user_write_data(png_structp png_ptr,
                              png_bytep data,
                              png_size_t length)
         {
-            auto stream = static_cast<std::ostream*>(png_get_io_ptr(png_ptr));
-            stream->write(reinterpret_cast<const char*>(data),
-                          std::streamsize(length));
+            auto sink = static_cast<ImageSink*>(png_get_io_ptr(png_ptr));
+            // png_error must not be called from the catch block, it
+            // longjmps past the end of the exception handling.
+            bool failed = false;
+            try
+            {
+                sink->write(data, length);
+            }
+            catch (std::exception&)
+            {
+                failed = true;
+            }
+            if (failed)
+                png_error(png_ptr, "Could not write PNG data.");
         }
 
         void user_flush_data(png_structp png_ptr)
         {
-            auto stream = static_cast<std::ostream*>(png_get_io_ptr(png_ptr));
-            stream->flush();
+            auto sink = static_cast<ImageSink*>(png_get_io_ptr(png_ptr));
+            bool failed = false;
+            try
+            {
+                sink->flush();
+            }
+            catch (std::exception&)
+            {
+                failed = true;
+            }
+            if (failed)
+                png_error(png_ptr, "Could not flush PNG data.");
         }
 
         }
@@ -75,22 +119,30 @@ namespace Yimage
 
     PngWriter::PngWriter() = default;
 
-    PngWriter::PngWriter(std::ostream& stream, PngMetadata  info, PngTransform transform)
+    PngWriter::PngWriter(std::ostream& stream, PngMetadata info, PngTransform transform,
+                         const PngWriteOptions& options)
+        : stream_sink_(std::make_unique<StreamSink>(stream)),
+          metadata_(std::move(info)),
+          transform_(transform),
+          options_(options)
+    {
+        create(*stream_sink_);
+    }
+
+    PngWriter::PngWriter(ImageSink& sink, PngMetadata info, PngTransform transform,
+                         const PngWriteOptions& options)
         : metadata_(std::move(info)),
-          transform_(transform)
+          transform_(transform),
+          options_(options)
     {
-        png_ptr_ = png_create_write_struct(PNG_LIBPNG_VER_STRING, nullptr, nullptr, nullptr);
-        if (!png_ptr_)
-            YIMAGE_THROW("Can not create PNG struct.");
-        info_ptr_ = png_create_info_struct(png_ptr_);
-        if (!info_ptr_)
-            YIMAGE_THROW("Can not create PNG info struct.");
-        png_set_write_fn(png_ptr_, &stream, user_write_data, user_flush_data);
+        create(sink);
     }
 
     PngWriter::PngWriter(PngWriter&& obj) noexcept
-        : metadata_(std::move(obj.metadata_)),
+        : stream_sink_(std::move(obj.stream_sink_)),
+          metadata_(std::move(obj.metadata_)),
           transform_(obj.transform_),
+          options_(obj.options_),
           png_ptr_(nullptr),
           info_ptr_(nullptr)
     {
@@ -102,7 +154,10 @@ namespace Yimage
     {
         if (png_ptr_)
         {
-            png_write_flush(png_ptr_);
+            // Errors can't be reported from the destructor, a failed
+            // flush only jumps back here.
+            if (!setjmp(png_jmpbuf(png_ptr_)))
+                png_write_flush(png_ptr_);
             png_destroy_write_struct(&png_ptr_, &info_ptr_);
         }
     }
@@ -113,8 +168,10 @@ namespace Yimage
             return *this;
         if (png_ptr_)
             png_destroy_write_struct(&png_ptr_, &info_ptr_);
+        stream_sink_ = std::move(obj.stream_sink_);
         metadata_ = std::move(obj.metadata_);
         transform_ = obj.transform_;
+        options_ = obj.options_;
         png_ptr_ = obj.png_ptr_;
         obj.png_ptr_ = nullptr;
         info_ptr_ = obj.info_ptr_;
@@ -122,6 +179,19 @@ namespace Yimage
         return *this;
     }
 
+    void PngWriter::create(ImageSink& sink)
+    {
+        png_ptr_ = png_create_write_struct(PNG_LIBPNG_VER_STRING, nullptr, nullptr, nullptr);
+        if (!png_ptr_)
+            YIMAGE_THROW("Can not create PNG struct.");
+        info_ptr_ = png_create_info_struct(png_ptr_);
+        if (!info_ptr_)
+            YIMAGE_THROW("Can not create PNG info struct.");
+        png_set_write_fn(png_ptr_, &sink, user_write_data, user_flush_data);
+        if (options_.interlaced())
+            metadata_.interlace_type = PNG_INTERLACE_ADAM7;
+    }
+
     PngWriter::operator bool() const
     {
         return png_ptr_ && info_ptr_;
@@ -140,6 +210,8 @@ namespace Yimage
                      metadata_.bit_depth, metadata_.color_type,
                      metadata_.interlace_type, metadata_.compression_method,
                      metadata_.filter_method);
+        if (metadata_.color_type == PNG_COLOR_TYPE_PALETTE)
+            set_palette(png_ptr_, info_ptr_, metadata_.palette);
         if (metadata_.gamma)
             png_set_gAMA(png_ptr_, info_ptr_, *metadata_.gamma);
 
@@ -152,6 +224,19 @@ namespace Yimage
         if (transform_.invert_alpha())
             png_set_invert_alpha(png_ptr_);
 
+        if (auto level = options_.compression_level())
+            png_set_compression_level(png_ptr_, *level);
+        if (auto strategy = options_.compression_strategy())
+            png_set_compression_strategy(png_ptr_, *strategy);
+        if (auto bits = options_.window_bits())
+            png_set_compression_window_bits(png_ptr_, *bits);
+        if (auto level = options_.memory_level())
+            png_set_compression_mem_level(png_ptr_, *level);
+        if (auto filters = options_.filters())
+            png_set_filter(png_ptr_, PNG_FILTER_TYPE_BASE, *filters);
+        if (auto size = options_.buffer_size())
+            png_set_compression_buffer_size(png_ptr_, *size);
+
         if (setjmp(png_jmpbuf(png_ptr_)))
         {
             png_destroy_write_struct(&png_ptr_, &info_ptr_);
@@ -159,6 +244,8 @@ namespace Yimage
         }
 
         png_write_info(png_ptr_, info_ptr_);
+        if (metadata_.interlace_type != PNG_INTERLACE_NONE)
+            png_set_interlace_handling(png_ptr_);
     }
 
     void PngWriter::write(const void* image, size_t size)
@@ -188,22 +275,36 @@ namespace Yimage
         if (row_size != get_row_size(metadata_, transform_))
             YIMAGE_THROW("Incorrect row size.");
 
+        // Each Adam7 pass picks its pixels from all the rows.
+        int passes = 1;
+        if (metadata_.interlace_type != PNG_INTERLACE_NONE)
+        {
+            if (count != metadata_.height)
+                YIMAGE_THROW("Interlaced images must be written all at once.");
+            passes = 7;
+        }
+
         assert_is_valid();
         if (setjmp(png_jmpbuf(png_ptr_)))
         {
             png_destroy_write_struct(&png_ptr_, &info_ptr_);
             YIMAGE_THROW("Error while writing PNG rows.");
         }
-        png_write_rows(
-            png_ptr_,
-            reinterpret_cast<unsigned char**>(const_cast<void**>(rows)),
-            count);
+        for (int i = 0; i < passes; ++i)
+        {
+            png_write_rows(
+                png_ptr_,
+                reinterpret_cast<unsigned char**>(const_cast<void**>(rows)),
+                count);
+        }
     }
 
     void PngWriter::write_row(const void* row, size_t size)
     {
         if (size != get_row_size(metadata_, transform_))
             YIMAGE_THROW("Incorrect row size.");
+        if (metadata_.interlace_type != PNG_INTERLACE_NONE)
+            YIMAGE_THROW("Interlaced images must be written all at once.");
 
         assert_is_valid();
         if (setjmp(png_jmpbuf(png_ptr_)))
@@ -219,6 +320,11 @@ namespace Yimage
     void PngWriter::write_end()
     {
         assert_is_valid();
+        if (setjmp(png_jmpbuf(png_ptr_)))
+        {
+            png_destroy_write_struct(&png_ptr_, &info_ptr_);
+            YIMAGE_THROW("Error while writing the end of the PNG image.");
+        }
         png_write_end(png_ptr_, nullptr);
     }
 
@@ -8,62 +8,205 @@
 #include "Yimage/Png/ReadPng.hpp"
 
 #include <png.h>
-#include <fstream>
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
 #include <span>
+#include <string>
 #include <vector>
 
+#include "Yimage/ImageSource.hpp"
+#include "Yimage/Png/PngDecoder.hpp"
 #include "Yimage/Png/PngMetadata.hpp"
+#include "Yimage/Png/PngPushDecoder.hpp"
 #include "Yimage/YimageException.hpp"
+#include "../ImageReaderBackend.hpp"
+#include "YimageVersion.hpp"
+
+#ifdef YIMAGE_LIBDEFLATE
+    #include <zlib.h>
+    #include "LibdeflatePng.hpp"
+    #include "PngFilters.hpp"
+#endif
 
 namespace Yimage
 {
     namespace
     {
-        class MemoryReader
+        /**
+         * @brief Reads the PNG file sequentially from an ImageSource.
+         */
+        class PngSourceReader
         {
         public:
-            MemoryReader(const void* buffer, size_t size)
-                : span_(static_cast<const unsigned char*>(buffer), size)
+            explicit PngSourceReader(ImageSource& source)
+                : source_(&source),
+                  data_(source.data())
             {
             }
 
             bool read(unsigned char* dest, size_t count)
             {
-                if (current_ + count > span_.size())
+                if (!data_.empty())
+                {
+                    if (count > data_.size() - offset_)
+                        return false;
+                    std::copy_n(data_.data() + offset_, count, dest);
+                }
+                else if (source_->read(offset_, dest, count) != count)
+                {
                     return false;
-                auto first = span_.data() + current_;
-                current_ += count;
-                auto last = span_.data() + current_;
-                std::copy(first, last, dest);
+                }
+                offset_ += count;
+                if (count == sizeof(chunk_header_))
+                    std::copy_n(dest, count, chunk_header_);
                 return true;
             }
 
+            /**
+             * @brief Returns the bytes of the last read of exactly 8 bytes.
+             *
+             * libpng reads each chunk header that way, so after
+             * png_read_info this is the header of the first IDAT chunk.
+             */
+            [[nodiscard]]
+            const unsigned char* chunk_header() const
+            {
+                return chunk_header_;
+            }
+
+            [[nodiscard]]
+            uint64_t offset() const
+            {
+                return offset_;
+            }
+
+            void seek(uint64_t offset)
+            {
+                offset_ = offset;
+            }
+
+            /**
+             * @brief Returns the entire source if it is in memory,
+             *      otherwise an empty span.
+             */
+            [[nodiscard]]
+            std::span<const unsigned char> data() const
+            {
+                return data_;
+            }
         private:
-            std::span<const unsigned char> span_;
-            size_t current_ = 0;
+            ImageSource* source_;
+            std::span<const unsigned char> data_;
+            uint64_t offset_ = 0;
+            unsigned char chunk_header_[8] = {};
         };
 
         extern "C" {
-        void user_read_istream_data(png_structp png_ptr,
-                                    png_bytep data,
-                                    png_size_t length)
-        {
-            auto stream = static_cast<std::istream*>(png_get_io_ptr(png_ptr));
-            stream->read(reinterpret_cast<char*>(data),
-                         std::streamsize(length));
-            if (size_t(stream->gcount()) != length)
-                png_error(png_ptr, "Could not read the requested number of bytes.");
-        }
-
-        void user_read_buffer_data(png_structp png_ptr,
+        void user_read_source_data(png_structp png_ptr,
                                    png_bytep data,
                                    png_size_t length)
         {
-            auto reader = static_cast<MemoryReader*>(png_get_io_ptr(png_ptr));
-            if (!reader->read(data, length))
+            auto reader = static_cast<PngSourceReader*>(png_get_io_ptr(png_ptr));
+            bool success = false;
+            try
+            {
+                success = reader->read(data, length);
+            }
+            catch (std::exception&)
+            {
+            }
+            if (!success)
                 png_error(png_ptr, "Could not read the requested number of bytes.");
         }
         }
+
+        /**
+         * @brief Keeps the blocks libpng frees so they can be reused
+         *      for the next image.
+         *
+         * Images of the same size and type make libpng and zlib request
+         * the same block sizes every time, so a block is only reused for
+         * a request of exactly the same size.
+         */
+        class PngMemoryPool
+        {
+        public:
+            PngMemoryPool() = default;
+
+            PngMemoryPool(const PngMemoryPool&) = delete;
+
+            ~PngMemoryPool()
+            {
+                for (auto& [size, block] : blocks_)
+                    std::free(block);
+            }
+
+            PngMemoryPool& operator=(const PngMemoryPool&) = delete;
+
+            void* allocate(size_t size)
+            {
+                for (auto& [block_size, block] : blocks_)
+                {
+                    if (block_size != size)
+                        continue;
+
+                    auto result = block;
+                    cached_size_ -= size;
+                    std::swap(block, blocks_.back().second);
+                    std::swap(block_size, blocks_.back().first);
+                    blocks_.pop_back();
+                    return static_cast<unsigned char*>(result) + HEADER_SIZE;
+                }
+
+                auto block = static_cast<unsigned char*>(std::malloc(HEADER_SIZE + size));
+                if (!block)
+                    return nullptr;
+                std::memcpy(block, &size, sizeof(size));
+                return block + HEADER_SIZE;
+            }
+
+            void deallocate(void* ptr)
+            {
+                if (!ptr)
+                    return;
+
+                auto block = static_cast<unsigned char*>(ptr) - HEADER_SIZE;
+                size_t size;
+                std::memcpy(&size, block, sizeof(size));
+                if (cached_size_ + size > MAX_CACHED_SIZE)
+                {
+                    std::free(block);
+                    return;
+                }
+
+                blocks_.emplace_back(size, block);
+                cached_size_ += size;
+            }
+        private:
+            // The size is stored in front of each block.
+            static constexpr size_t HEADER_SIZE = alignof(std::max_align_t);
+            static constexpr size_t MAX_CACHED_SIZE = 4 * 1024 * 1024;
+
+            std::vector<std::pair<size_t, void*>> blocks_;
+            size_t cached_size_ = 0;
+        };
+
+        extern "C" {
+        png_voidp pool_malloc(png_structp png_ptr, png_alloc_size_t size)
+        {
+            auto pool = static_cast<PngMemoryPool*>(png_get_mem_ptr(png_ptr));
+            return pool->allocate(size);
+        }
+
+        void pool_free(png_structp png_ptr, png_voidp ptr)
+        {
+            auto pool = static_cast<PngMemoryPool*>(png_get_mem_ptr(png_ptr));
+            pool->deallocate(ptr);
+        }
+        }
     }
 
     struct PngHandle
@@ -104,9 +247,12 @@ namespace Yimage
         png_infop info_ptr = nullptr;
     };
 
-    PngHandle create_png_handle()
+    PngHandle create_png_handle(PngMemoryPool* pool = nullptr)
     {
-        auto png_ptr = png_create_read_struct(PNG_LIBPNG_VER_STRING, nullptr, nullptr, nullptr);
+        auto png_ptr = pool
+            ? png_create_read_struct_2(PNG_LIBPNG_VER_STRING, nullptr, nullptr, nullptr,
+                                       pool, pool_malloc, pool_free)
+            : png_create_read_struct(PNG_LIBPNG_VER_STRING, nullptr, nullptr, nullptr);
         if (!png_ptr)
             YIMAGE_THROW("Can not create PNG struct.");
         auto info_ptr = png_create_info_struct(png_ptr);
@@ -140,6 +286,14 @@ namespace Yimage
                 return PixelType::MONO_ALPHA_16;
             break;
         case PNG_COLOR_TYPE_PALETTE:
+            switch (bit_depth)
+            {
+            case 1: return PixelType::INDEXED_1;
+            case 2: return PixelType::INDEXED_2;
+            case 4: return PixelType::INDEXED_4;
+            case 8: return PixelType::INDEXED_8;
+            default: break;
+            }
             break;
         case PNG_COLOR_TYPE_RGB:
             if (bit_depth == 8)
@@ -162,7 +316,54 @@ namespace Yimage
             + std::to_string(bit_depth) + ".");
     }
 
-    Image read_png(const PngHandle& png)
+    namespace
+    {
+        /**
+         * @brief Returns the pixel type the image is read as.
+         *
+         * The rows of an Image must end on a byte boundary, so libpng
+         * unpacks 1, 2 and 4-bit palette images whose rows don't to
+         * INDEXED_8.
+         */
+        PixelType setup_pixel_type(png_structp png_ptr, const PngMetadata& metadata)
+        {
+            if (metadata.color_type == PNG_COLOR_TYPE_PALETTE
+                && metadata.bit_depth < 8
+                && metadata.width * metadata.bit_depth % 8 != 0)
+            {
+                png_set_packing(png_ptr);
+                return PixelType::INDEXED_8;
+            }
+            return get_pixel_type(metadata.color_type, metadata.bit_depth);
+        }
+    }
+
+    void read_png_palette(png_structp png_ptr, png_infop info_ptr,
+                          ImageMetadata& metadata)
+    {
+        png_colorp colors = nullptr;
+        int color_count = 0;
+        if (!png_get_PLTE(png_ptr, info_ptr, &colors, &color_count))
+            return;
+
+        metadata.palette.resize(size_t(color_count));
+        for (int i = 0; i < color_count; ++i)
+        {
+            metadata.palette[i] = {colors[i].red, colors[i].green,
+                                   colors[i].blue, 255};
+        }
+
+        png_bytep alphas = nullptr;
+        int alpha_count = 0;
+        if (png_get_tRNS(png_ptr, info_ptr, &alphas, &alpha_count, nullptr))
+        {
+            alpha_count = std::min(alpha_count, color_count);
+            for (int i = 0; i < alpha_count; ++i)
+                metadata.palette[i].a = alphas[i];
+        }
+    }
+
+    std::unique_ptr<PngMetadata> read_png_info(const PngHandle& png)
     {
         png_read_info(png.png_ptr, png.info_ptr);
 
@@ -171,43 +372,775 @@ namespace Yimage
         metadata->height = png_get_image_height(png.png_ptr, png.info_ptr);
         metadata->bit_depth = png_get_bit_depth(png.png_ptr, png.info_ptr);
         metadata->color_type = png_get_color_type(png.png_ptr, png.info_ptr);
+        metadata->interlace_type = png_get_interlace_type(png.png_ptr, png.info_ptr);
+        if (metadata->color_type == PNG_COLOR_TYPE_PALETTE)
+            read_png_palette(png.png_ptr, png.info_ptr, *metadata);
         //const auto channels = png_get_channels(png.png_ptr, png.info_ptr);
+        return metadata;
+    }
 
-        Image image(get_pixel_type(metadata->color_type,
-                                   metadata->bit_depth),
-                    metadata->width, metadata->height);
+    namespace
+    {
+        /**
+         * @brief Copies the @a count pixels in @a src to every
+         *      @a step'th pixel in @a dst, starting at pixel @a x.
+         */
+        template <size_t BYTES>
+        void scatter_pixels(const uint8_t* src, size_t count,
+                            uint8_t* dst, size_t x, size_t step)
+        {
+            dst += x * BYTES;
+            for (size_t i = 0; i < count; ++i)
+            {
+                std::memcpy(dst, src, BYTES);
+                src += BYTES;
+                dst += step * BYTES;
+            }
+        }
 
-        std::vector<uint8_t*> row_pointers(metadata->height);
-        for (size_t i = 0; i < metadata->height; ++i)
-            row_pointers[i] = image.pixel_pointer(0, i);
+        void scatter_bits(const uint8_t* src, size_t count, size_t bits,
+                          uint8_t* dst, size_t x, size_t step)
+        {
+            const auto per_byte = 8 / bits;
+            const auto mask = (1u << bits) - 1;
+            for (size_t i = 0; i < count; ++i, x += step)
+            {
+                auto src_shift = 8 - bits - (i % per_byte) * bits;
+                auto value = (src[i / per_byte] >> src_shift) & mask;
+                auto dst_shift = 8 - bits - (x % per_byte) * bits;
+                auto& byte = dst[x / per_byte];
+                byte = uint8_t((byte & ~(mask << dst_shift)) | value << dst_shift);
+            }
+        }
+
+        void scatter_row(const uint8_t* src, size_t count, size_t bits,
+                         uint8_t* dst, size_t x, size_t step)
+        {
+            switch (bits)
+            {
+            case 8: scatter_pixels<1>(src, count, dst, x, step); break;
+            case 16: scatter_pixels<2>(src, count, dst, x, step); break;
+            case 24: scatter_pixels<3>(src, count, dst, x, step); break;
+            case 32: scatter_pixels<4>(src, count, dst, x, step); break;
+            case 48: scatter_pixels<6>(src, count, dst, x, step); break;
+            case 64: scatter_pixels<8>(src, count, dst, x, step); break;
+            default: scatter_bits(src, count, bits, dst, x, step); break;
+            }
+        }
+
+        /**
+         * @brief Reads the seven Adam7 passes as the small images they
+         *      are stored as, and copies each pixel straight to its
+         *      place in @a dst.
+         *
+         * libpng's interlace handling instead widens every row in every
+         * pass to the full width of the image before it copies the
+         * pixels that belong to the pass.
+         */
+        void read_interlaced_pixels(const PngHandle& png,
+                                    const MutableImageView& dst)
+        {
+            const auto width = uint32_t(dst.width());
+            const auto height = uint32_t(dst.height());
+            const auto bits = dst.pixel_size();
+            // The last pass has rows as wide as the image.
+            std::vector<uint8_t> row((width * bits + 7) / 8);
+            for (int pass = 0; pass < 7; ++pass)
+            {
+                const size_t cols = PNG_PASS_COLS(width, pass);
+                const size_t rows = PNG_PASS_ROWS(height, pass);
+                if (cols == 0 || rows == 0)
+                    continue;
+
+                const size_t x0 = PNG_PASS_START_COL(pass);
+                const size_t dx = size_t(1) << PNG_PASS_COL_SHIFT(pass);
+                const size_t y0 = PNG_PASS_START_ROW(pass);
+                const size_t dy = size_t(1) << PNG_PASS_ROW_SHIFT(pass);
+                for (size_t i = 0; i < rows; ++i)
+                {
+                    png_read_row(png.png_ptr, row.data(), nullptr);
+                    scatter_row(row.data(), cols, bits,
+                                dst.row(y0 + i * dy).first, x0, dx);
+                }
+            }
+        }
+    }
+
+    void read_png_pixels(const PngHandle& png, const MutableImageView& dst,
+                         std::vector<uint8_t*>& row_pointers)
+    {
+        if (png_get_interlace_type(png.png_ptr, png.info_ptr) != PNG_INTERLACE_NONE)
+        {
+            read_interlaced_pixels(png, dst);
+            return;
+        }
+
+        row_pointers.resize(dst.height());
+        for (size_t i = 0; i < dst.height(); ++i)
+            row_pointers[i] = dst.row(i).first;
         png_read_image(png.png_ptr, row_pointers.data());
+    }
+
+    namespace
+    {
+        /**
+         * @brief The buffers PngDecoder keeps between images.
+         */
+        struct PngReadBuffers
+        {
+            std::vector<uint8_t*> row_pointers;
+#ifdef YIMAGE_LIBDEFLATE
+            PngInflater inflater;
+            std::vector<unsigned char> idat;
+#endif
+        };
+
+#ifdef YIMAGE_LIBDEFLATE
+        [[noreturn]]
+        void throw_truncated()
+        {
+            YIMAGE_THROW("The PNG data ends in the middle of the image.");
+        }
+
+        /**
+         * @brief Returns the contents of the consecutive IDAT chunks that
+         *      start at the chunk header png_read_info stopped after.
+         *
+         * The data is only copied to @a buffer if the source isn't in
+         * memory or the image has more than one IDAT chunk.
+         */
+        std::span<const unsigned char>
+        read_idat_chunks(PngSourceReader& reader, bool verify_crc,
+                         std::vector<unsigned char>& buffer)
+        {
+            const auto memory = reader.data();
+            std::span<const unsigned char> first_chunk;
+            size_t chunk_count = 0;
+            buffer.clear();
+
+            // libpng has already read the first chunk header, and
+            // streamed sources can't seek back to it.
+            unsigned char header[8];
+            std::copy_n(reader.chunk_header(), sizeof(header), header);
+            if (std::memcmp(header + 4, "IDAT", 4) != 0)
+                YIMAGE_THROW("The image data doesn't follow the PNG header chunks.");
+            do
+            {
+
+                const size_t length = png_get_uint_32(header);
+                const auto offset = reader.offset();
+                std::span<const unsigned char> chunk;
+                if (!memory.empty())
+                {
+                    if (length > memory.size() - offset)
+                        throw_truncated();
+                    chunk = memory.subspan(size_t(offset), length);
+                    reader.seek(offset + length);
+                    if (chunk_count == 0)
+                        first_chunk = chunk;
+                    else if (chunk_count == 1)
+                        buffer.assign(first_chunk.begin(), first_chunk.end());
+                    if (chunk_count != 0)
+                        buffer.insert(buffer.end(), chunk.begin(), chunk.end());
+                }
+                else
+                {
+                    auto old_size = buffer.size();
+                    buffer.resize(old_size + length);
+                    if (!reader.read(buffer.data() + old_size, length))
+                        throw_truncated();
+                    chunk = {buffer.data() + old_size, length};
+                }
+
+                unsigned char crc[4];
+                if (!reader.read(crc, sizeof(crc)))
+                    throw_truncated();
+                if (verify_crc)
+                {
+                    auto value = crc32(crc32(0, header + 4, 4),
+                                       chunk.data(), uInt(chunk.size()));
+                    if (value != png_get_uint_32(crc))
+                        YIMAGE_THROW("IDAT: CRC error");
+                }
+                ++chunk_count;
+
+                if (!reader.read(header, sizeof(header)))
+                    throw_truncated();
+            } while (std::memcmp(header + 4, "IDAT", 4) == 0);
+
+            if (!memory.empty() && chunk_count == 1)
+                return first_chunk;
+            return buffer;
+        }
+
+        /**
+         * @brief Returns the number of bytes in the filtered image data.
+         */
+        size_t get_filtered_size(size_t width, size_t height, size_t bits,
+                                 bool interlaced)
+        {
+            if (!interlaced)
+                return height * ((width * bits + 7) / 8 + 1);
+
+            size_t size = 0;
+            for (int pass = 0; pass < 7; ++pass)
+            {
+                const size_t cols = PNG_PASS_COLS(width, pass);
+                const size_t rows = PNG_PASS_ROWS(height, pass);
+                if (cols != 0 && rows != 0)
+                    size += rows * ((cols * bits + 7) / 8 + 1);
+            }
+            return size;
+        }
+
+        void unfilter(const unsigned char* src, const unsigned char* prev,
+                      size_t size, size_t bpp, unsigned char* dst)
+        {
+            if (!unfilter_row(src[0], src + 1, prev, size, bpp, dst))
+                YIMAGE_THROW("Unknown PNG filter type: " + std::to_string(src[0]));
+        }
+
+        /**
+         * @brief Inflates all the image data at once and unfilters the
+         *      rows straight into @a dst.
+         *
+         * The rows of interlaced images are unfiltered in place, and the
+         * pixels are then copied to their places in @a dst.
+         */
+        void read_pixels_libdeflate(const PngHandle& png,
+                                    const MutableImageView& dst,
+                                    PngReadBuffers& buffers,
+                                    bool verify_checksums)
+        {
+            auto& reader = *static_cast<PngSourceReader*>(
+                png_get_io_ptr(png.png_ptr));
+            auto idat = read_idat_chunks(reader, verify_checksums, buffers.idat);
+
+            const auto width = uint32_t(dst.width());
+            const auto height = uint32_t(dst.height());
+            const auto bits = dst.pixel_size();
+            const auto bpp = std::max<size_t>(bits / 8, 1);
+            const auto interlaced = png_get_interlace_type(png.png_ptr, png.info_ptr)
+                                    != PNG_INTERLACE_NONE;
+            auto data = buffers.inflater.inflate(
+                idat, get_filtered_size(width, height, bits, interlaced),
+                verify_checksums);
+            auto src = data.data();
+
+            if (!interlaced)
+            {
+                const auto row_size = (width * bits + 7) / 8;
+                const unsigned char* prev = nullptr;
+                for (size_t y = 0; y < height; ++y)
+                {
+                    auto row = dst.row(y).first;
+                    unfilter(src, prev, row_size, bpp, row);
+                    prev = row;
+                    src += row_size + 1;
+                }
+                return;
+            }
+
+            for (int pass = 0; pass < 7; ++pass)
+            {
+                const size_t cols = PNG_PASS_COLS(width, pass);
+                const size_t rows = PNG_PASS_ROWS(height, pass);
+                if (cols == 0 || rows == 0)
+                    continue;
+
+                const size_t x0 = PNG_PASS_START_COL(pass);
+                const size_t dx = size_t(1) << PNG_PASS_COL_SHIFT(pass);
+                const size_t y0 = PNG_PASS_START_ROW(pass);
+                const size_t dy = size_t(1) << PNG_PASS_ROW_SHIFT(pass);
+                const auto row_size = (cols * bits + 7) / 8;
+                const unsigned char* prev = nullptr;
+                for (size_t i = 0; i < rows; ++i)
+                {
+                    unfilter(src, prev, row_size, bpp, src + 1);
+                    scatter_row(src + 1, cols, bits,
+                                dst.row(y0 + i * dy).first, x0, dx);
+                    prev = src + 1;
+                    src += row_size + 1;
+                }
+            }
+        }
+#endif
+
+        void read_pixels(const PngHandle& png, const MutableImageView& dst,
+                         PngReadBuffers& buffers, const PngReadOptions& options)
+        {
+#ifdef YIMAGE_LIBDEFLATE
+            // Unpacked sub-byte pixels are left to libpng.
+            if (dst.pixel_size() == png_get_bit_depth(png.png_ptr, png.info_ptr)
+                                    * png_get_channels(png.png_ptr, png.info_ptr))
+            {
+                read_pixels_libdeflate(png, dst, buffers, options.verify_checksums());
+                return;
+            }
+            read_png_pixels(png, dst, buffers.row_pointers);
+#else
+            (void)options;
+            read_png_pixels(png, dst, buffers.row_pointers);
+#endif
+        }
+    }
+
+    Image read_png(const PngHandle& png, PngReadBuffers& buffers,
+                   const PngReadOptions& options)
+    {
+        auto metadata = read_png_info(png);
+
+        Image image(setup_pixel_type(png.png_ptr, *metadata),
+                    metadata->width, metadata->height);
+        read_pixels(png, image.mutable_view(), buffers, options);
 
         image.set_metadata(std::move(metadata));
         return image;
     }
 
-    Image read_png(std::istream& stream)
+    void read_png_into(const PngHandle& png, const MutableImageView& dst,
+                       PngReadBuffers& buffers, const PngReadOptions& options)
     {
-        auto png = create_png_handle();
-        png_set_read_fn(png.png_ptr, &stream, user_read_istream_data);
-        return read_png(png);
+        auto metadata = read_png_info(png);
+        if (dst.pixel_type() != setup_pixel_type(png.png_ptr, *metadata)
+            || dst.width() != metadata->width
+            || dst.height() != metadata->height)
+        {
+            YIMAGE_THROW("The destination must have the same size and pixel type as the image.");
+        }
+        read_pixels(png, dst, buffers, options);
     }
 
-    Image read_png(const std::filesystem::path& path)
+    Image read_png(ImageSource& source, const PngReadOptions& options)
     {
-        std::ifstream file(path, std::ios::binary);
-        if (!file)
-            YIMAGE_THROW("Can not open file: " + path.string());
-        auto image = read_png(file);
+        return PngDecoder(options).read(source);
+    }
+
+    Image read_png(std::istream& stream, const PngReadOptions& options)
+    {
+        StreamSource source(stream);
+        return read_png(source, options);
+    }
+
+    Image read_png(const std::filesystem::path& path,
+                   const PngReadOptions& options)
+    {
+        auto image = read_png(*open_image_source(path), options);
         image.metadata()->path = path;
         return image;
     }
 
-    Image read_png(const void* buffer, size_t size)
+    Image read_png(const void* buffer, size_t size,
+                   const PngReadOptions& options)
+    {
+        MemorySource source(buffer, size);
+        return read_png(source, options);
+    }
+
+    void read_png_into(ImageSource& source, const MutableImageView& dst,
+                       const PngReadOptions& options)
+    {
+        PngDecoder(options).read_into(source, dst);
+    }
+
+    void read_png_into(std::istream& stream, const MutableImageView& dst,
+                       const PngReadOptions& options)
+    {
+        StreamSource source(stream);
+        read_png_into(source, dst, options);
+    }
+
+    void read_png_into(const std::filesystem::path& path,
+                       const MutableImageView& dst,
+                       const PngReadOptions& options)
+    {
+        read_png_into(*open_image_source(path), dst, options);
+    }
+
+    void read_png_into(const void* buffer, size_t size,
+                       const MutableImageView& dst,
+                       const PngReadOptions& options)
+    {
+        MemorySource source(buffer, size);
+        read_png_into(source, dst, options);
+    }
+
+    namespace
+    {
+        void apply_read_options(png_structp png_ptr,
+                                const PngReadOptions& options)
+        {
+            if (options.verify_checksums())
+                return;
+
+            // With QUIET_USE libpng doesn't even compute the CRCs.
+            png_set_crc_action(png_ptr, PNG_CRC_QUIET_USE, PNG_CRC_QUIET_USE);
+#ifdef PNG_IGNORE_ADLER32
+            png_set_option(png_ptr, PNG_IGNORE_ADLER32, PNG_OPTION_ON);
+#endif
+        }
+    }
+
+    struct PngDecoder::Data
+    {
+        PngMemoryPool pool;
+        PngReadBuffers buffers;
+        PngReadOptions options;
+    };
+
+    PngDecoder::PngDecoder()
+        : data_(std::make_unique<Data>())
+    {}
+
+    PngDecoder::PngDecoder(const PngReadOptions& options)
+        : data_(std::make_unique<Data>())
+    {
+        data_->options = options;
+    }
+
+    PngDecoder::PngDecoder(PngDecoder&& rhs) noexcept = default;
+
+    PngDecoder::~PngDecoder() = default;
+
+    PngDecoder& PngDecoder::operator=(PngDecoder&& rhs) noexcept = default;
+
+    const PngReadOptions& PngDecoder::options() const
+    {
+        return data_->options;
+    }
+
+    PngDecoder& PngDecoder::options(const PngReadOptions& value)
+    {
+        data_->options = value;
+        return *this;
+    }
+
+    Image PngDecoder::read(ImageSource& source)
+    {
+        auto png = create_png_handle(&data_->pool);
+        apply_read_options(png.png_ptr, data_->options);
+        PngSourceReader reader(source);
+        png_set_read_fn(png.png_ptr, &reader, user_read_source_data);
+        return read_png(png, data_->buffers, data_->options);
+    }
+
+    Image PngDecoder::read(const void* buffer, size_t size)
+    {
+        MemorySource source(buffer, size);
+        return read(source);
+    }
+
+    void PngDecoder::read_into(ImageSource& source, const MutableImageView& dst)
+    {
+        auto png = create_png_handle(&data_->pool);
+        apply_read_options(png.png_ptr, data_->options);
+        PngSourceReader reader(source);
+        png_set_read_fn(png.png_ptr, &reader, user_read_source_data);
+        read_png_into(png, dst, data_->buffers, data_->options);
+    }
+
+    void PngDecoder::read_into(const void* buffer, size_t size,
+                               const MutableImageView& dst)
+    {
+        MemorySource source(buffer, size);
+        read_into(source, dst);
+    }
+
+    namespace
+    {
+        struct PngPushState
+        {
+            PngPushState();
+
+            void start(png_infop info_ptr);
+
+            void add_row(png_bytep new_row, png_uint_32 row_num, int pass);
+
+            PngHandle png;
+            PngPushDecoder::InfoCallback info_callback;
+            PngPushDecoder::RowCallback row_callback;
+            bool keep_image = true;
+            ImageInfo info;
+            Image image;
+            bool interlaced = false;
+            bool finished = false;
+            bool failed = false;
+            // Exceptions from the callbacks can't pass through libpng,
+            // they are stored here and rethrown by push().
+            std::exception_ptr exception;
+            std::string error;
+        };
+
+        extern "C" {
+        void push_error(png_structp png_ptr, png_const_charp msg)
+        {
+            auto state = static_cast<PngPushState*>(png_get_error_ptr(png_ptr));
+            try
+            {
+                state->error = msg;
+            }
+            catch (std::exception&)
+            {
+            }
+            png_longjmp(png_ptr, 1);
+        }
+
+        void push_warning(png_structp, png_const_charp)
+        {}
+
+        void push_info(png_structp png_ptr, png_infop info_ptr)
+        {
+            auto state = static_cast<PngPushState*>(png_get_progressive_ptr(png_ptr));
+            try
+            {
+                state->start(info_ptr);
+            }
+            catch (...)
+            {
+                state->exception = std::current_exception();
+            }
+            if (state->exception)
+                png_error(png_ptr, "Callback failed.");
+        }
+
+        void push_row(png_structp png_ptr, png_bytep new_row,
+                      png_uint_32 row_num, int pass)
+        {
+            auto state = static_cast<PngPushState*>(png_get_progressive_ptr(png_ptr));
+            try
+            {
+                state->add_row(new_row, row_num, pass);
+            }
+            catch (...)
+            {
+                state->exception = std::current_exception();
+            }
+            if (state->exception)
+                png_error(png_ptr, "Callback failed.");
+        }
+
+        void push_end(png_structp png_ptr, png_infop)
+        {
+            auto state = static_cast<PngPushState*>(png_get_progressive_ptr(png_ptr));
+            state->finished = true;
+        }
+        }
+
+        PngPushState::PngPushState()
+        {
+            png.png_ptr = png_create_read_struct(PNG_LIBPNG_VER_STRING, this,
+                                                 push_error, push_warning);
+            if (!png.png_ptr)
+                YIMAGE_THROW("Can not create PNG struct.");
+            png.info_ptr = png_create_info_struct(png.png_ptr);
+            if (!png.info_ptr)
+                YIMAGE_THROW("Can not create PNG info struct.");
+            png_set_progressive_read_fn(png.png_ptr, this,
+                                        push_info, push_row, push_end);
+        }
+
+        void PngPushState::start(png_infop info_ptr)
+        {
+            auto metadata = std::make_unique<PngMetadata>();
+            metadata->width = png_get_image_width(png.png_ptr, info_ptr);
+            metadata->height = png_get_image_height(png.png_ptr, info_ptr);
+            metadata->bit_depth = png_get_bit_depth(png.png_ptr, info_ptr);
+            metadata->color_type = png_get_color_type(png.png_ptr, info_ptr);
+            metadata->interlace_type = png_get_interlace_type(png.png_ptr, info_ptr);
+            if (metadata->color_type == PNG_COLOR_TYPE_PALETTE)
+                read_png_palette(png.png_ptr, info_ptr, *metadata);
+            info = {ImageFormat::PNG,
+                    metadata->width,
+                    metadata->height,
+                    setup_pixel_type(png.png_ptr, *metadata)};
+
+            interlaced = metadata->interlace_type != PNG_INTERLACE_NONE;
+            if (interlaced)
+                png_set_interlace_handling(png.png_ptr);
+            png_read_update_info(png.png_ptr, info_ptr);
+
+            if (keep_image || interlaced)
+            {
+                image = Image(info.pixel_type, info.width, info.height);
+                image.set_metadata(std::move(metadata));
+            }
+
+            if (info_callback)
+                info_callback(info);
+        }
+
+        void PngPushState::add_row(png_bytep new_row, png_uint_32 row_num,
+                                   int pass)
+        {
+            // libpng passes null for rows that aren't part of the
+            // current pass.
+            if (!new_row)
+                return;
+
+            ImageView row;
+            if (image)
+            {
+                auto [b, e] = image.row(row_num);
+                if (interlaced)
+                    png_progressive_combine_row(png.png_ptr, b, new_row);
+                else
+                    std::copy(new_row, new_row + (e - b), b);
+                row = image.view().subimage(0, row_num, info.width, 1);
+            }
+            else
+            {
+                row = ImageView(new_row, info.pixel_type, info.width, 1);
+            }
+
+            if (row_callback)
+                row_callback(row_num, interlaced ? pass : 0, row);
+        }
+    }
+
+    struct PngPushDecoder::Data
+    {
+        PngPushState state;
+    };
+
+    PngPushDecoder::PngPushDecoder()
+        : data_(std::make_unique<Data>())
+    {}
+
+    PngPushDecoder::PngPushDecoder(PngPushDecoder&& rhs) noexcept = default;
+
+    PngPushDecoder::~PngPushDecoder() = default;
+
+    PngPushDecoder& PngPushDecoder::operator=(PngPushDecoder&& rhs) noexcept = default;
+
+    PngPushDecoder& PngPushDecoder::on_info(InfoCallback callback)
+    {
+        data_->state.info_callback = std::move(callback);
+        return *this;
+    }
+
+    PngPushDecoder& PngPushDecoder::on_row(RowCallback callback)
+    {
+        data_->state.row_callback = std::move(callback);
+        return *this;
+    }
+
+    bool PngPushDecoder::keep_image() const
+    {
+        return data_->state.keep_image;
+    }
+
+    PngPushDecoder& PngPushDecoder::keep_image(bool value)
+    {
+        data_->state.keep_image = value;
+        return *this;
+    }
+
+    void PngPushDecoder::push(const void* data, size_t size)
+    {
+        auto& state = data_->state;
+        if (state.failed)
+            YIMAGE_THROW("The PNG decoder can not be used after an error.");
+        if (state.finished || size == 0)
+            return;
+
+        if (setjmp(png_jmpbuf(state.png.png_ptr)))
+        {
+            state.failed = true;
+            if (state.exception)
+                std::rethrow_exception(state.exception);
+            YIMAGE_THROW("Could not decode PNG data: " + state.error);
+        }
+
+        png_process_data(state.png.png_ptr, state.png.info_ptr,
+                         static_cast<png_bytep>(const_cast<void*>(data)), size);
+    }
+
+    const ImageInfo& PngPushDecoder::info() const
+    {
+        return data_->state.info;
+    }
+
+    bool PngPushDecoder::is_finished() const
+    {
+        return data_->state.finished;
+    }
+
+    const Image& PngPushDecoder::image() const
+    {
+        return data_->state.image;
+    }
+
+    Image PngPushDecoder::release_image()
+    {
+        return std::move(data_->state.image);
+    }
+
+    namespace
+    {
+        class PngReaderBackend : public ImageReaderBackend
+        {
+        public:
+            explicit PngReaderBackend(std::unique_ptr<ImageSource> source)
+                : source_(std::move(source)),
+                  reader_(*source_),
+                  png_(create_png_handle())
+            {
+                png_set_read_fn(png_.png_ptr, &reader_, user_read_source_data);
+
+                auto metadata = read_png_info(png_);
+                info_ = {ImageFormat::PNG,
+                         metadata->width,
+                         metadata->height,
+                         setup_pixel_type(png_.png_ptr, *metadata),
+                         metadata->palette};
+                interlaced_ = png_get_interlace_type(png_.png_ptr, png_.info_ptr)
+                             != PNG_INTERLACE_NONE;
+            }
+
+            [[nodiscard]]
+            const ImageInfo& info() const override
+            {
+                return info_;
+            }
+
+            void read_rows(const MutableImageView& band) override
+            {
+                if (interlaced_)
+                {
+                    // The last pass of an interlaced image contributes to
+                    // every other row, so the whole image must be decoded.
+                    if (!image_)
+                    {
+                        image_ = Image(info_.pixel_type, info_.width, info_.height);
+                        std::vector<uint8_t*> row_pointers;
+                        read_png_pixels(png_, image_.mutable_view(), row_pointers);
+                    }
+
+                    for (size_t i = 0; i < band.height(); ++i)
+                    {
+                        auto [b, e] = image_.row(row_++);
+                        std::copy(b, e, band.row(i).first);
+                    }
+                    return;
+                }
+
+                for (size_t i = 0; i < band.height(); ++i)
+                    png_read_row(png_.png_ptr, band.row(i).first, nullptr);
+            }
+        private:
+            std::unique_ptr<ImageSource> source_;
+            PngSourceReader reader_;
+            PngHandle png_;
+            ImageInfo info_;
+            bool interlaced_ = false;
+            Image image_;
+            size_t row_ = 0;
+        };
+    }
+
+    std::unique_ptr<ImageReaderBackend>
+    make_png_reader_backend(std::unique_ptr<ImageSource> source)
     {
-        auto png = create_png_handle();
-        MemoryReader reader(buffer, size);
-        png_set_read_fn(png.png_ptr, &reader, user_read_buffer_data);
-        return read_png(png);
+        return std::make_unique<PngReaderBackend>(std::move(source));
     }
 }
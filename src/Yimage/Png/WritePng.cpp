@@ -7,106 +7,346 @@
 //****************************************************************************
 #include "Yimage/Png/WritePng.hpp"
 
-#include <fstream>
+#include <utility>
+#include <vector>
 #include "Yimage/Png/PngWriter.hpp"
 #include "Yimage/YimageException.hpp"
+#include "../ImageWriterBackend.hpp"
+#include "ParallelPngEncoder.hpp"
+#include "YimageVersion.hpp"
+
+#ifdef YIMAGE_LIBDEFLATE
+    #include "LibdeflatePng.hpp"
+#endif
 
 namespace Yimage
 {
+    namespace
+    {
+        /**
+         * @brief Throws if @a options asks for quantizing, which is
+         *      impossible when the rows are written as they are received.
+         */
+        void check_no_quantize(const PngWriteOptions& options)
+        {
+            if (options.quantize())
+                YIMAGE_THROW("Images written as raw rows can't be quantized.");
+        }
+    }
+
     void write_png(std::ostream& stream,
                    const void* image, size_t image_size,
-                   PngMetadata options, PngTransform transform)
+                   PngMetadata options, PngTransform transform,
+                   const PngWriteOptions& write_options)
     {
-        PngWriter writer(stream, std::move(options), transform);
+        check_no_quantize(write_options);
+        StreamSink sink(stream);
+        PngWriter writer(sink, std::move(options), transform, write_options);
         writer.write_info();
         writer.write(image, image_size);
         writer.write_end();
+        sink.flush();
     }
 
     void write_png(const std::filesystem::path& path,
                    const void* image, size_t image_size,
-                   PngMetadata options, PngTransform transform)
+                   PngMetadata options, PngTransform transform,
+                   const PngWriteOptions& write_options)
+    {
+        check_no_quantize(write_options);
+        FileSink sink(path);
+        PngWriter writer(sink, std::move(options), transform, write_options);
+        writer.write_info();
+        writer.write(image, image_size);
+        writer.write_end();
+        // libpng doesn't flush after the last chunk, and the sink's
+        // destructor ignores errors.
+        sink.flush();
+    }
+
+    namespace
+    {
+        std::pair<PngMetadata, PngTransform>
+        get_png_format(PixelType pixel_type, size_t width, size_t height,
+                       const std::vector<Rgba8>& palette = {})
+        {
+            PngMetadata metadata;
+            metadata.width = uint32_t(width);
+            metadata.height = uint32_t(height);
+
+            PngTransform transform;
+
+            switch (pixel_type)
+            {
+            case PixelType::MONO_1:
+                metadata.bit_depth = 1;
+                metadata.color_type = PNG_COLOR_TYPE_GRAY;
+                break;
+            case PixelType::MONO_2:
+                metadata.bit_depth = 2;
+                metadata.color_type = PNG_COLOR_TYPE_GRAY;
+                break;
+            case PixelType::MONO_4:
+                metadata.bit_depth = 4;
+                metadata.color_type = PNG_COLOR_TYPE_GRAY;
+                break;
+            case PixelType::MONO_8:
+                metadata.bit_depth = 8;
+                metadata.color_type = PNG_COLOR_TYPE_GRAY;
+                break;
+            case PixelType::ALPHA_MONO_8:
+                transform.invert_alpha(true);
+                [[fallthrough]];
+            case PixelType::MONO_ALPHA_8:
+                metadata.bit_depth = 8;
+                metadata.color_type = PNG_COLOR_TYPE_GRAY_ALPHA;
+                break;
+            case PixelType::ALPHA_MONO_16:
+                transform.invert_alpha(true);
+                [[fallthrough]];
+            case PixelType::MONO_ALPHA_16:
+                metadata.bit_depth = 16;
+                metadata.color_type = PNG_COLOR_TYPE_GRAY_ALPHA;
+                break;
+            case PixelType::RGB_8:
+                metadata.bit_depth = 8;
+                metadata.color_type = PNG_COLOR_TYPE_RGB;
+                break;
+            case PixelType::RGB_16:
+                metadata.bit_depth = 16;
+                metadata.color_type = PNG_COLOR_TYPE_RGB;
+                break;
+            case PixelType::ARGB_8:
+                transform.invert_alpha(true);
+                [[fallthrough]];
+            case PixelType::RGBA_8:
+                metadata.bit_depth = 8;
+                metadata.color_type = PNG_COLOR_TYPE_RGBA;
+                break;
+            case PixelType::ARGB_16:
+                transform.invert_alpha(true);
+                [[fallthrough]];
+            case PixelType::RGBA_16:
+                metadata.bit_depth = 16;
+                metadata.color_type = PNG_COLOR_TYPE_RGBA;
+                break;
+            case PixelType::INDEXED_1:
+            case PixelType::INDEXED_2:
+            case PixelType::INDEXED_4:
+            case PixelType::INDEXED_8:
+                metadata.bit_depth = int32_t(get_pixel_size(pixel_type));
+                metadata.color_type = PNG_COLOR_TYPE_PALETTE;
+                if (palette.empty())
+                    YIMAGE_THROW("Indexed images can't be written without a palette.");
+                if (palette.size() > size_t(1) << metadata.bit_depth)
+                {
+                    YIMAGE_THROW("The palette has too many colors: "
+                                 + std::to_string(palette.size()));
+                }
+                metadata.palette = palette;
+                break;
+            default:
+                YIMAGE_THROW("Unsupported pixel type: "
+                             + std::to_string(int(pixel_type)));
+            }
+            return {metadata, transform};
+        }
+
+        /**
+         * @brief Returns a rough estimate of the size of @a img as a PNG
+         *      image.
+         *
+         * Images without compression need the image data, the filter
+         * bytes and a few bytes per deflate block and chunk. Compressed
+         * images are assumed to need half of that, which is in the
+         * middle of the typical range for photos.
+         */
+        size_t estimate_png_size(const ImageView& img,
+                                 const PngMetadata& metadata,
+                                 const PngWriteOptions& options)
+        {
+            auto size = img.height() * ((img.width() * img.pixel_size() + 7) / 8 + 1);
+            size += size / 1024 + metadata.palette.size() * 4 + 256;
+            if (options.compression_level().value_or(6) != 0)
+                size /= 2;
+            return size;
+        }
+
+        /**
+         * @brief Passes the rows of @a img to libpng in a single call
+         *      without copying them, also when there are gaps between
+         *      the rows.
+         */
+        void write_rows(PngWriter& writer, const ImageView& img,
+                        std::vector<const void*>& rows)
+        {
+            if (!img)
+                return;
+
+            rows.resize(img.height());
+            for (size_t i = 0; i < img.height(); ++i)
+                rows[i] = img.row(i).first;
+
+            auto [b, e] = img.row(0);
+            writer.write_rows(rows.data(), uint32_t(rows.size()), size_t(e - b));
+        }
+    }
+
+    void write_png(ImageSink& sink, const ImageView& img,
+                   const PngWriteOptions& options,
+                   const ExecutionContext& context)
+    {
+        if (options.quantize() && !is_indexed(img.pixel_type()))
+        {
+            auto indexed = quantize(img, *options.quantize(), context);
+            write_png(sink, indexed.view(), options, context);
+            return;
+        }
+
+        auto [metadata, transform] = get_png_format(
+            img.pixel_type(), img.width(), img.height(),
+            img.metadata() ? img.metadata()->palette : std::vector<Rgba8>());
+        if (options.interlaced())
+            metadata.interlace_type = PNG_INTERLACE_ADAM7;
+        sink.reserve(estimate_png_size(img, metadata, options));
+        // The built-in encoders don't implement libpng's transforms.
+        if (!transform.invert_alpha())
+        {
+            auto done = write_png_parallel(sink, img, metadata, options, context);
+#ifdef YIMAGE_LIBDEFLATE
+            if (!done)
+                done = write_png_libdeflate(sink, img, metadata, options, context);
+#endif
+            if (done)
+            {
+                sink.flush();
+                return;
+            }
+        }
+
+        PngWriter writer(sink, std::move(metadata), transform, options);
+        writer.write_info();
+        std::vector<const void*> rows;
+        write_rows(writer, img, rows);
+        writer.write_end();
+        sink.flush();
+    }
+
+    void write_png(std::ostream& stream, const ImageView& img,
+                   const PngWriteOptions& options,
+                   const ExecutionContext& context)
     {
-        std::ofstream stream(path);
-        if (!stream)
-            YIMAGE_THROW("Can not create " + path.string());
-        write_png(stream, image, image_size, std::move(options), transform);
+        StreamSink sink(stream);
+        write_png(sink, img, options, context);
     }
 
-    void write_png(std::ostream& stream, const ImageView& img)
+    void write_png(std::vector<unsigned char>& buffer, const ImageView& img,
+                   const PngWriteOptions& options,
+                   const ExecutionContext& context)
     {
-        PngMetadata metadata;
-        metadata.width = img.width();
-        metadata.height = img.height();
+        VectorSink sink(buffer);
+        write_png(sink, img, options, context);
+    }
 
-        PngTransform transform;
+    void write_png(const std::filesystem::path& path, const ImageView& img,
+                   const PngWriteOptions& options,
+                   const ExecutionContext& context)
+    {
+        FileSink sink(path);
+        write_png(sink, img, options, context);
+    }
 
-        switch (img.pixel_type())
+    void write_png(ImageSink& sink, Pipeline& pipeline,
+                   const PngWriteOptions& options,
+                   const ExecutionContext& context)
+    {
+        // Interlaced images can't be written one band at a time, and
+        // quantizing needs all the pixels to choose the palette.
+        if (options.interlaced()
+            || (options.quantize() && !is_indexed(pipeline.pixel_type())))
         {
-        case PixelType::MONO_1:
-            metadata.bit_depth = 1;
-            metadata.color_type = PNG_COLOR_TYPE_GRAY;
-            break;
-        case PixelType::MONO_2:
-            metadata.bit_depth = 2;
-            metadata.color_type = PNG_COLOR_TYPE_GRAY;
-            break;
-        case PixelType::MONO_4:
-            metadata.bit_depth = 4;
-            metadata.color_type = PNG_COLOR_TYPE_GRAY;
-            break;
-        case PixelType::MONO_8:
-            metadata.bit_depth = 8;
-            metadata.color_type = PNG_COLOR_TYPE_GRAY;
-            break;
-        case PixelType::ALPHA_MONO_8:
-            transform.invert_alpha(true);
-            [[fallthrough]];
-        case PixelType::MONO_ALPHA_8:
-            metadata.bit_depth = 8;
-            metadata.color_type = PNG_COLOR_TYPE_GRAY_ALPHA;
-            break;
-        case PixelType::ALPHA_MONO_16:
-            transform.invert_alpha(true);
-            [[fallthrough]];
-        case PixelType::MONO_ALPHA_16:
-            metadata.bit_depth = 16;
-            metadata.color_type = PNG_COLOR_TYPE_GRAY_ALPHA;
-            break;
-        case PixelType::RGB_8:
-            metadata.bit_depth = 8;
-            metadata.color_type = PNG_COLOR_TYPE_RGB;
-            break;
-        case PixelType::RGB_16:
-            metadata.bit_depth = 16;
-            metadata.color_type = PNG_COLOR_TYPE_RGB;
-            break;
-        case PixelType::ARGB_8:
-            transform.invert_alpha(true);
-            [[fallthrough]];
-        case PixelType::RGBA_8:
-            metadata.bit_depth = 8;
-            metadata.color_type = PNG_COLOR_TYPE_RGBA;
-            break;
-        case PixelType::ARGB_16:
-            transform.invert_alpha(true);
-            [[fallthrough]];
-        case PixelType::RGBA_16:
-            metadata.bit_depth = 16;
-            metadata.color_type = PNG_COLOR_TYPE_RGBA;
-            break;
-        default:
-            YIMAGE_THROW("Unsupported pixel type: "
-                         + std::to_string(int(img.pixel_type())));
+            auto image = pipeline.to_image();
+            write_png(sink, image.view(), options, context);
+            return;
         }
-        write_png(stream, img.data(), img.size(), metadata, transform);
+
+        auto [metadata, transform] = get_png_format(pipeline.pixel_type(),
+                                                    pipeline.width(),
+                                                    pipeline.height(),
+                                                    pipeline.palette());
+        PngWriter writer(sink, std::move(metadata), transform, options);
+        writer.write_info();
+        std::vector<const void*> rows;
+        pipeline.run([&](const ImageView& band)
+                     {
+                         write_rows(writer, band, rows);
+                     });
+        writer.write_end();
+        sink.flush();
+    }
+
+    void write_png(std::ostream& stream, Pipeline& pipeline,
+                   const PngWriteOptions& options,
+                   const ExecutionContext& context)
+    {
+        StreamSink sink(stream);
+        write_png(sink, pipeline, options, context);
+    }
+
+    void write_png(const std::filesystem::path& path, Pipeline& pipeline,
+                   const PngWriteOptions& options,
+                   const ExecutionContext& context)
+    {
+        FileSink sink(path);
+        write_png(sink, pipeline, options, context);
+    }
+
+    namespace
+    {
+        class PngWriterBackend : public ImageWriterBackend
+        {
+        public:
+            PngWriterBackend(ImageSink& sink, const ImageInfo& info,
+                             const PngWriteOptions& options)
+                : info_(info)
+            {
+                if (!is_indexed(info.pixel_type))
+                    check_no_quantize(options);
+                auto [metadata, transform] = get_png_format(info.pixel_type,
+                                                            info.width,
+                                                            info.height,
+                                                            info.palette);
+                writer_ = PngWriter(sink, std::move(metadata), transform,
+                                    options);
+                writer_.write_info();
+            }
+
+            [[nodiscard]]
+            const ImageInfo& info() const override
+            {
+                return info_;
+            }
+
+            void write_rows(const ImageView& band) override
+            {
+                Yimage::write_rows(writer_, band, rows_);
+            }
+
+            void finish() override
+            {
+                writer_.write_end();
+            }
+        private:
+            ImageInfo info_;
+            PngWriter writer_;
+            std::vector<const void*> rows_;
+        };
     }
 
-    void write_png(const std::filesystem::path& path, const ImageView& img)
+    std::unique_ptr<ImageWriterBackend>
+    make_png_writer_backend(ImageSink& sink, const ImageInfo& info,
+                            const PngWriteOptions& options)
     {
-        std::ofstream stream(path);
-        if (!stream)
-            YIMAGE_THROW("Can not create " + path.string());
-        write_png(stream, img);
+        return std::make_unique<PngWriterBackend>(sink, info, options);
     }
 }
@@ -0,0 +1,362 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-19.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "Yimage/ProbeImage.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include "Yimage/ReadImage.hpp"
+#include "Yimage/YimageException.hpp"
+
+namespace Yimage
+{
+    namespace
+    {
+        /**
+         * @brief Reads the first block of a source up front, so that
+         *      headers can be parsed without a read call per field.
+         */
+        class HeadCachedSource : public ImageSource
+        {
+        public:
+            explicit HeadCachedSource(ImageSource& source)
+                : source_(&source)
+            {
+                head_size_ = source.read(0, head_, sizeof(head_));
+            }
+
+            size_t read(uint64_t offset, void* buffer, size_t size) override
+            {
+                if (offset <= head_size_ && size <= head_size_ - offset)
+                {
+                    std::memcpy(buffer, head_ + offset, size);
+                    return size;
+                }
+                return source_->read(offset, buffer, size);
+            }
+
+            [[nodiscard]]
+            uint64_t size() const override
+            {
+                return source_->size();
+            }
+        private:
+            ImageSource* source_;
+            unsigned char head_[4096];
+            size_t head_size_ = 0;
+        };
+
+        uint16_t get_u16(const uint8_t* bytes, bool big_endian)
+        {
+            if (big_endian)
+                return uint16_t((bytes[0] << 8) | bytes[1]);
+            return uint16_t((bytes[1] << 8) | bytes[0]);
+        }
+
+        uint32_t get_u32(const uint8_t* bytes, bool big_endian)
+        {
+            if (big_endian)
+                return (uint32_t(get_u16(bytes, true)) << 16) | get_u16(bytes + 2, true);
+            return (uint32_t(get_u16(bytes + 2, false)) << 16) | get_u16(bytes, false);
+        }
+
+        uint64_t get_u64(const uint8_t* bytes, bool big_endian)
+        {
+            if (big_endian)
+                return (uint64_t(get_u32(bytes, true)) << 32) | get_u32(bytes + 4, true);
+            return (uint64_t(get_u32(bytes + 4, false)) << 32) | get_u32(bytes, false);
+        }
+
+        void read_header(ImageSource& source, uint64_t offset,
+                         void* buffer, size_t size)
+        {
+            if (source.read(offset, buffer, size) != size)
+                YIMAGE_THROW("The image header is incomplete.");
+        }
+
+        PixelType get_png_pixel_type(uint8_t color_type, uint8_t bit_depth,
+                                     size_t width)
+        {
+            switch (color_type)
+            {
+            case 0: // Gray
+                switch (bit_depth)
+                {
+                case 1: return PixelType::MONO_1;
+                case 2: return PixelType::MONO_2;
+                case 4: return PixelType::MONO_4;
+                case 8: return PixelType::MONO_8;
+                case 16: return PixelType::MONO_16;
+                default: break;
+                }
+                break;
+            case 3: // Palette
+                // read_png unpacks rows that don't end on a byte boundary.
+                if (bit_depth < 8 && width * bit_depth % 8 != 0)
+                    return PixelType::INDEXED_8;
+                switch (bit_depth)
+                {
+                case 1: return PixelType::INDEXED_1;
+                case 2: return PixelType::INDEXED_2;
+                case 4: return PixelType::INDEXED_4;
+                case 8: return PixelType::INDEXED_8;
+                default: break;
+                }
+                break;
+            case 2: // RGB
+                if (bit_depth == 8)
+                    return PixelType::RGB_8;
+                if (bit_depth == 16)
+                    return PixelType::RGB_16;
+                break;
+            case 4: // Gray and alpha
+                if (bit_depth == 8)
+                    return PixelType::MONO_ALPHA_8;
+                if (bit_depth == 16)
+                    return PixelType::MONO_ALPHA_16;
+                break;
+            case 6: // RGB and alpha
+                if (bit_depth == 8)
+                    return PixelType::RGBA_8;
+                if (bit_depth == 16)
+                    return PixelType::RGBA_16;
+                break;
+            default:
+                break;
+            }
+            return PixelType::NONE;
+        }
+
+        ImageInfo probe_png(ImageSource& source)
+        {
+            // Signature (8), chunk length (4), "IHDR" (4), width (4),
+            // height (4), bit depth (1), color type (1).
+            uint8_t header[26];
+            read_header(source, 0, header, sizeof(header));
+            if (std::memcmp(header + 12, "IHDR", 4) != 0)
+                YIMAGE_THROW("The PNG image doesn't start with an IHDR chunk.");
+
+            auto width = get_u32(header + 16, true);
+            return {ImageFormat::PNG,
+                    width,
+                    get_u32(header + 20, true),
+                    get_png_pixel_type(header[25], header[24], width)};
+        }
+
+        bool is_jpeg_sof_marker(uint8_t marker)
+        {
+            // C4 (DHT), C8 (JPG) and CC (DAC) share the range, but aren't
+            // start of frame markers.
+            return marker >= 0xC0 && marker <= 0xCF
+                   && marker != 0xC4 && marker != 0xC8 && marker != 0xCC;
+        }
+
+        ImageInfo probe_jpeg(ImageSource& source)
+        {
+            uint64_t offset = 2;
+            while (true)
+            {
+                uint8_t marker[4];
+                read_header(source, offset, marker, 2);
+                if (marker[0] != 0xFF)
+                    YIMAGE_THROW("Invalid JPEG marker.");
+                if (marker[1] == 0xFF)
+                {
+                    // Fill byte.
+                    ++offset;
+                    continue;
+                }
+
+                offset += 2;
+                if (marker[1] == 0x01 || (marker[1] >= 0xD0 && marker[1] <= 0xD7))
+                    continue;
+                if (marker[1] == 0xD9 || marker[1] == 0xDA)
+                    YIMAGE_THROW("The JPEG image has no SOF marker.");
+
+                read_header(source, offset, marker + 2, 2);
+                auto length = get_u16(marker + 2, true);
+                if (is_jpeg_sof_marker(marker[1]))
+                {
+                    // Length (2), precision (1), height (2), width (2),
+                    // number of components (1).
+                    uint8_t sof[8];
+                    read_header(source, offset, sof, sizeof(sof));
+                    PixelType pixel_type = PixelType::NONE;
+                    if (sof[7] == 1)
+                        pixel_type = PixelType::MONO_8;
+                    else if (sof[7] == 3)
+                        pixel_type = PixelType::RGB_8;
+                    return {ImageFormat::JPEG,
+                            get_u16(sof + 5, true),
+                            get_u16(sof + 3, true),
+                            pixel_type};
+                }
+                offset += length;
+            }
+        }
+
+        struct TiffFields
+        {
+            uint64_t width = 0;
+            uint64_t height = 0;
+            uint64_t bits_per_sample = 1;
+            uint64_t samples_per_pixel = 1;
+            uint64_t sample_format = 1;
+            uint64_t planar_configuration = 1;
+        };
+
+        PixelType get_tiff_pixel_type(const TiffFields& fields)
+        {
+            if (fields.bits_per_sample <= 16)
+                return PixelType::RGBA_8;
+            if (fields.bits_per_sample == 32
+                && fields.samples_per_pixel == 1
+                && fields.sample_format == 3 // IEEE floating point
+                && fields.planar_configuration == 1) // Contiguous
+            {
+                return PixelType::MONO_FLOAT_32;
+            }
+            return PixelType::NONE;
+        }
+
+        ImageInfo probe_tiff(ImageSource& source)
+        {
+            uint8_t header[16];
+            read_header(source, 0, header, 8);
+            const bool big_endian = header[0] == 'M';
+            const bool big_tiff = get_u16(header + 2, big_endian) == 43;
+
+            uint64_t ifd_offset;
+            uint64_t entry_count;
+            size_t entry_size;
+            if (big_tiff)
+            {
+                read_header(source, 0, header, 16);
+                ifd_offset = get_u64(header + 8, big_endian);
+                read_header(source, ifd_offset, header, 8);
+                entry_count = get_u64(header, big_endian);
+                ifd_offset += 8;
+                entry_size = 20;
+            }
+            else
+            {
+                ifd_offset = get_u32(header + 4, big_endian);
+                read_header(source, ifd_offset, header, 2);
+                entry_count = get_u16(header, big_endian);
+                ifd_offset += 2;
+                entry_size = 12;
+            }
+
+            TiffFields fields;
+            for (uint64_t i = 0; i < entry_count; ++i)
+            {
+                uint8_t entry[20];
+                read_header(source, ifd_offset + i * entry_size,
+                            entry, entry_size);
+                auto tag = get_u16(entry, big_endian);
+                auto type = get_u16(entry + 2, big_endian);
+                auto value = entry + (big_tiff ? 12 : 8);
+
+                uint64_t* field;
+                switch (tag)
+                {
+                case 256: field = &fields.width; break;
+                case 257: field = &fields.height; break;
+                case 258: field = &fields.bits_per_sample; break;
+                case 277: field = &fields.samples_per_pixel; break;
+                case 284: field = &fields.planar_configuration; break;
+                case 339: field = &fields.sample_format; break;
+                default: continue;
+                }
+
+                // Only the first value is needed. It is stored in the
+                // entry itself unless all the values are too large to fit.
+                size_t value_size;
+                switch (type)
+                {
+                case 3: value_size = 2; break; // SHORT
+                case 4: value_size = 4; break; // LONG
+                case 16: value_size = 8; break; // LONG8
+                default: continue;
+                }
+
+                uint64_t count = big_tiff ? get_u64(entry + 4, big_endian)
+                                          : get_u32(entry + 4, big_endian);
+                uint8_t buffer[8];
+                if (count * value_size > (big_tiff ? 8u : 4u))
+                {
+                    auto offset = big_tiff ? get_u64(value, big_endian)
+                                           : get_u32(value, big_endian);
+                    read_header(source, offset, buffer, value_size);
+                    value = buffer;
+                }
+
+                if (value_size == 2)
+                    *field = get_u16(value, big_endian);
+                else if (value_size == 4)
+                    *field = get_u32(value, big_endian);
+                else
+                    *field = get_u64(value, big_endian);
+            }
+
+            if (fields.width == 0 || fields.height == 0)
+                YIMAGE_THROW("The TIFF image has no width or height.");
+
+            return {ImageFormat::TIFF,
+                    size_t(fields.width),
+                    size_t(fields.height),
+                    get_tiff_pixel_type(fields)};
+        }
+
+        ImageInfo probe_image(ImageSource& source, ImageFormat format)
+        {
+            switch (format)
+            {
+            case ImageFormat::PNG:
+                return probe_png(source);
+            case ImageFormat::JPEG:
+                return probe_jpeg(source);
+            case ImageFormat::TIFF:
+                return probe_tiff(source);
+            case ImageFormat::UNKNOWN:
+            default:
+                YIMAGE_THROW("Unrecognized image format.");
+            }
+        }
+    }
+
+    bool operator==(const ImageInfo& a, const ImageInfo& b)
+    {
+        return a.format == b.format
+               && a.width == b.width
+               && a.height == b.height
+               && a.pixel_type == b.pixel_type
+               && a.palette == b.palette;
+    }
+
+    ImageInfo probe_image(ImageSource& source)
+    {
+        if (!source.data().empty())
+            return probe_image(source, get_image_format(source));
+
+        HeadCachedSource cached_source(source);
+        return probe_image(cached_source, get_image_format(cached_source));
+    }
+
+    ImageInfo probe_image(const std::filesystem::path& path)
+    {
+        FileSource source(path);
+        return probe_image(source);
+    }
+
+    ImageInfo probe_image(const void* buffer, size_t size)
+    {
+        MemorySource source(buffer, size);
+        return probe_image(source);
+    }
+}
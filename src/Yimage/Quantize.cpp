@@ -0,0 +1,682 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-19.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "Yimage/Quantize.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <unordered_map>
+#include "Yimage/YimageException.hpp"
+
+namespace Yimage
+{
+    size_t QuantizeOptions::max_colors() const
+    {
+        return max_colors_;
+    }
+
+    QuantizeOptions& QuantizeOptions::max_colors(size_t value)
+    {
+        if (value < 2 || value > 256)
+            YIMAGE_THROW("max_colors must be from 2 to 256: " + std::to_string(value));
+        max_colors_ = value;
+        return *this;
+    }
+
+    DitherMethod QuantizeOptions::dither() const
+    {
+        return dither_;
+    }
+
+    QuantizeOptions& QuantizeOptions::dither(DitherMethod value)
+    {
+        dither_ = value;
+        return *this;
+    }
+
+    namespace
+    {
+        static_assert(sizeof(Rgba8) == 4);
+
+        constexpr size_t DEFAULT_GRAIN_SIZE = 64 * 1024;
+
+        constexpr Rgba8 TRANSPARENT = {0, 0, 0, 0};
+
+        uint32_t to_uint32(Rgba8 c)
+        {
+            return uint32_t(c.r) << 24 | uint32_t(c.g) << 16
+                   | uint32_t(c.b) << 8 | c.a;
+        }
+
+        void load_row(const ImageView& img, size_t y, std::vector<Rgba8>& row)
+        {
+            row.resize(img.width());
+            auto src = img.row(y).first;
+            switch (img.pixel_type())
+            {
+            case PixelType::RGBA_8:
+                std::memcpy(row.data(), src, row.size() * sizeof(Rgba8));
+                break;
+            case PixelType::RGB_8:
+                for (auto& c : row)
+                {
+                    c = {src[0], src[1], src[2]};
+                    src += 3;
+                }
+                break;
+            default:
+                for (size_t x = 0; x < row.size(); ++x)
+                    row[x] = get_rgba8(img, x, y);
+                break;
+            }
+
+            // The color channels of fully transparent pixels don't matter.
+            for (auto& c : row)
+            {
+                if (c.a == 0)
+                    c = TRANSPARENT;
+            }
+        }
+
+        /**
+         * @brief Splits the rows of @a img into bands that can be
+         *      processed on separate threads.
+         */
+        size_t get_band_count(const ImageView& img,
+                              const ExecutionContext& context)
+        {
+            auto threads = context.max_threads();
+            if (context.parallelism() == ParallelismHint::AUTO)
+            {
+                auto grain_size = context.grain_size() != 0
+                                  ? context.grain_size()
+                                  : DEFAULT_GRAIN_SIZE;
+                threads = std::min(threads,
+                                   std::max<size_t>(img.size() / grain_size, 1));
+            }
+            return std::clamp<size_t>(threads, 1, img.height());
+        }
+
+        std::pair<size_t, size_t>
+        get_band_rows(size_t height, size_t band_count, size_t band)
+        {
+            return {band * height / band_count,
+                    (band + 1) * height / band_count};
+        }
+
+        struct Bin
+        {
+            uint64_t sums[4] = {};
+            uint64_t count = 0;
+        };
+
+        struct Histogram
+        {
+            /**
+             * @brief Colors that only differ in the three lowest bits
+             *      of each channel share a bin.
+             */
+            std::unordered_map<uint32_t, Bin> bins;
+            /**
+             * @brief The exact colors, as long as there are no more
+             *      of them than there is room for in the palette.
+             */
+            std::unordered_map<uint32_t, uint64_t> colors;
+            bool too_many_colors = false;
+        };
+
+        uint32_t get_bin_key(Rgba8 c)
+        {
+            return uint32_t(c.r >> 3) << 15 | uint32_t(c.g >> 3) << 10
+                   | uint32_t(c.b >> 3) << 5 | uint32_t(c.a >> 3);
+        }
+
+        void add_row(Histogram& histogram, const std::vector<Rgba8>& row,
+                     size_t max_colors)
+        {
+            // Runs of identical pixels are common in synthetic images,
+            // and each run only needs a single lookup.
+            for (size_t i = 0; i < row.size();)
+            {
+                const auto c = row[i];
+                const auto key = to_uint32(c);
+                size_t n = 1;
+                while (i + n < row.size() && to_uint32(row[i + n]) == key)
+                    ++n;
+                i += n;
+
+                auto& bin = histogram.bins[get_bin_key(c)];
+                bin.sums[0] += c.r * n;
+                bin.sums[1] += c.g * n;
+                bin.sums[2] += c.b * n;
+                bin.sums[3] += c.a * n;
+                bin.count += n;
+
+                if (histogram.too_many_colors)
+                    continue;
+
+                histogram.colors[key] += n;
+                if (histogram.colors.size() > max_colors)
+                {
+                    histogram.too_many_colors = true;
+                    histogram.colors.clear();
+                }
+            }
+        }
+
+        void merge(Histogram& dst, const Histogram& src, size_t max_colors)
+        {
+            for (const auto& [key, bin] : src.bins)
+            {
+                auto& dst_bin = dst.bins[key];
+                for (int i = 0; i < 4; ++i)
+                    dst_bin.sums[i] += bin.sums[i];
+                dst_bin.count += bin.count;
+            }
+
+            if (dst.too_many_colors)
+                return;
+
+            for (const auto& [key, count] : src.colors)
+                dst.colors[key] += count;
+            if (src.too_many_colors || dst.colors.size() > max_colors)
+            {
+                dst.too_many_colors = true;
+                dst.colors.clear();
+            }
+        }
+
+        Histogram make_histogram(const ImageView& src, size_t max_colors,
+                                 const ExecutionContext& context)
+        {
+            const auto band_count = get_band_count(src, context);
+            std::vector<Histogram> histograms(band_count);
+            run_parallel(
+                band_count,
+                [&](size_t band)
+                {
+                    auto [y0, y1] = get_band_rows(src.height(), band_count, band);
+                    std::vector<Rgba8> row;
+                    for (size_t y = y0; y < y1; ++y)
+                    {
+                        load_row(src, y, row);
+                        add_row(histograms[band], row, max_colors);
+                    }
+                },
+                context);
+
+            for (size_t i = 1; i < histograms.size(); ++i)
+                merge(histograms[0], histograms[i], max_colors);
+            return std::move(histograms[0]);
+        }
+
+        struct Entry
+        {
+            Rgba8 color;
+            uint64_t count;
+        };
+
+        uint8_t get_channel(Rgba8 c, int channel)
+        {
+            switch (channel)
+            {
+            case 0: return c.r;
+            case 1: return c.g;
+            case 2: return c.b;
+            default: return c.a;
+            }
+        }
+
+        struct Box
+        {
+            size_t begin;
+            size_t end;
+            uint64_t count;
+            int channel;
+            uint64_t score;
+        };
+
+        Box make_box(const std::vector<Entry>& entries, size_t begin, size_t end)
+        {
+            int lo[4] = {255, 255, 255, 255};
+            int hi[4] = {0, 0, 0, 0};
+            uint64_t count = 0;
+            for (size_t i = begin; i < end; ++i)
+            {
+                for (int ch = 0; ch < 4; ++ch)
+                {
+                    int value = get_channel(entries[i].color, ch);
+                    lo[ch] = std::min(lo[ch], value);
+                    hi[ch] = std::max(hi[ch], value);
+                }
+                count += entries[i].count;
+            }
+
+            // Differences in color matter less the more transparent
+            // the colors are.
+            int ranges[4];
+            for (int ch = 0; ch < 3; ++ch)
+                ranges[ch] = (hi[ch] - lo[ch]) * hi[3] / 255;
+            ranges[3] = hi[3] - lo[3];
+
+            auto channel = int(std::max_element(ranges, ranges + 4) - ranges);
+            auto score = end - begin > 1 ? uint64_t(ranges[channel]) * count : 0;
+            return {begin, end, count, channel, score};
+        }
+
+        Rgba8 get_mean_color(const std::vector<Entry>& entries, const Box& box)
+        {
+            uint64_t sums[4] = {};
+            for (size_t i = box.begin; i < box.end; ++i)
+            {
+                for (int ch = 0; ch < 4; ++ch)
+                    sums[ch] += get_channel(entries[i].color, ch) * entries[i].count;
+            }
+            auto mean = [&](int ch)
+            {
+                return uint8_t((sums[ch] + box.count / 2) / box.count);
+            };
+            return {mean(0), mean(1), mean(2), mean(3)};
+        }
+
+        std::vector<Rgba8> median_cut(std::vector<Entry> entries,
+                                      size_t max_colors)
+        {
+            std::vector<Box> boxes{make_box(entries, 0, entries.size())};
+            while (boxes.size() < max_colors)
+            {
+                auto it = std::max_element(boxes.begin(), boxes.end(),
+                                           [](auto& a, auto& b)
+                                           {
+                                               return a.score < b.score;
+                                           });
+                if (it->score == 0)
+                    break;
+
+                // Split the box at the weighted median of its
+                // widest channel.
+                const auto box = *it;
+                const auto first = entries.begin() + ptrdiff_t(box.begin);
+                const auto last = entries.begin() + ptrdiff_t(box.end);
+                std::sort(first, last, [&](auto& a, auto& b)
+                {
+                    return get_channel(a.color, box.channel)
+                           < get_channel(b.color, box.channel);
+                });
+
+                auto split = box.begin;
+                for (uint64_t count = 0; count < box.count / 2; ++split)
+                    count += entries[split].count;
+                split = std::clamp(split, box.begin + 1, box.end - 1);
+
+                *it = make_box(entries, box.begin, split);
+                boxes.push_back(make_box(entries, split, box.end));
+            }
+
+            std::vector<Rgba8> palette;
+            for (const auto& box : boxes)
+                palette.push_back(get_mean_color(entries, box));
+            return palette;
+        }
+
+        struct Palette
+        {
+            std::vector<Rgba8> colors;
+            /**
+             * @brief True if every color in the image is in the palette.
+             */
+            bool exact = false;
+        };
+
+        Palette create_palette(const ImageView& src, size_t max_colors,
+                               const ExecutionContext& context)
+        {
+            if (!src)
+                return {};
+
+            auto histogram = make_histogram(src, max_colors, context);
+            Palette result;
+            if (!histogram.too_many_colors)
+            {
+                for (const auto& [key, count] : histogram.colors)
+                    result.colors.emplace_back(key);
+                result.exact = true;
+            }
+            else
+            {
+                std::vector<Entry> entries;
+                entries.reserve(histogram.bins.size());
+                for (const auto& [key, bin] : histogram.bins)
+                {
+                    auto mean = [&](int ch)
+                    {
+                        return uint8_t((bin.sums[ch] + bin.count / 2) / bin.count);
+                    };
+                    entries.push_back({{mean(0), mean(1), mean(2), mean(3)},
+                                       bin.count});
+                }
+                result.colors = median_cut(std::move(entries), max_colors);
+            }
+
+            std::sort(result.colors.begin(), result.colors.end(),
+                      [](auto& a, auto& b)
+                      {
+                          return std::pair(a.a, to_uint32(a))
+                                 < std::pair(b.a, to_uint32(b));
+                      });
+            return result;
+        }
+
+        class NearestColor
+        {
+        public:
+            explicit NearestColor(const std::vector<Rgba8>& palette)
+                : cache_(CACHE_SIZE)
+            {
+                for (size_t i = 0; i < palette.size(); ++i)
+                    entries_.push_back({palette[i], uint8_t(i)});
+                std::sort(entries_.begin(), entries_.end(),
+                          [](auto& a, auto& b) {return a.color.g < b.color.g;});
+            }
+
+            uint8_t find(Rgba8 c)
+            {
+                // Dithering can produce a large number of different
+                // colors, so the cache has a fixed size and each color
+                // can only be in one place.
+                const auto key = to_uint32(c);
+                const auto tag = uint64_t(1) << 32 | key;
+                auto& slot = cache_[(key * 2654435761u) >> (32 - CACHE_BITS)];
+                if (slot >> 8 == tag)
+                    return uint8_t(slot);
+
+                auto index = search(c);
+                slot = tag << 8 | index;
+                return index;
+            }
+        private:
+            struct Entry
+            {
+                Rgba8 color;
+                uint8_t index;
+            };
+
+            static int get_distance(Rgba8 a, Rgba8 b)
+            {
+                int dr = int(a.r) - b.r;
+                int dg = int(a.g) - b.g;
+                int db = int(a.b) - b.b;
+                int da = int(a.a) - b.a;
+                return dr * dr + dg * dg + db * db + da * da;
+            }
+
+            /**
+             * @brief Searches outwards from the entries with the same
+             *      green value as @a c, and stops in each direction
+             *      when the difference in green alone is too large.
+             */
+            uint8_t search(Rgba8 c) const
+            {
+                const auto n = ptrdiff_t(entries_.size());
+                auto hi = ptrdiff_t(std::lower_bound(
+                    entries_.begin(), entries_.end(), c.g,
+                    [](auto& e, uint8_t g) {return e.color.g < g;})
+                    - entries_.begin());
+                auto lo = hi - 1;
+
+                const Entry* best = nullptr;
+                int best_distance = std::numeric_limits<int>::max();
+                auto visit = [&](const Entry& e)
+                {
+                    auto dg = int(e.color.g) - c.g;
+                    if (dg * dg >= best_distance)
+                        return false;
+                    auto distance = get_distance(c, e.color);
+                    if (distance < best_distance)
+                    {
+                        best = &e;
+                        best_distance = distance;
+                    }
+                    return true;
+                };
+
+                while (lo >= 0 || hi < n)
+                {
+                    if (hi < n && !visit(entries_[size_t(hi++)]))
+                        hi = n;
+                    if (lo >= 0 && !visit(entries_[size_t(lo--)]))
+                        lo = -1;
+                }
+                return best->index;
+            }
+
+            static constexpr unsigned CACHE_BITS = 16;
+            static constexpr size_t CACHE_SIZE = size_t(1) << CACHE_BITS;
+
+            std::vector<Entry> entries_;
+            /**
+             * @brief A flag that marks the slot as used, the color and
+             *      its index in the palette in the lowest 8 bits.
+             */
+            std::vector<uint64_t> cache_;
+        };
+
+        constexpr uint8_t BAYER_8X8[8][8] = {
+            {0, 32, 8, 40, 2, 34, 10, 42},
+            {48, 16, 56, 24, 50, 18, 58, 26},
+            {12, 44, 4, 36, 14, 46, 6, 38},
+            {60, 28, 52, 20, 62, 30, 54, 22},
+            {3, 35, 11, 43, 1, 33, 9, 41},
+            {51, 19, 59, 27, 49, 17, 57, 25},
+            {15, 47, 7, 39, 13, 45, 5, 37},
+            {63, 31, 55, 23, 61, 29, 53, 21}
+        };
+
+        /**
+         * @brief Returns the amplitude of the ordered dithering, the mean
+         *      distance per channel from each color in @a palette to
+         *      its nearest neighbor.
+         */
+        int get_dither_spread(const std::vector<Rgba8>& palette)
+        {
+            if (palette.size() < 2)
+                return 0;
+
+            double sum = 0;
+            for (const auto& a : palette)
+            {
+                int min_distance = std::numeric_limits<int>::max();
+                for (const auto& b : palette)
+                {
+                    if (&a == &b)
+                        continue;
+                    int dr = int(a.r) - b.r;
+                    int dg = int(a.g) - b.g;
+                    int db = int(a.b) - b.b;
+                    min_distance = std::min(min_distance, dr * dr + dg * dg + db * db);
+                }
+                sum += std::sqrt(min_distance / 3.0);
+            }
+            return int(sum / double(palette.size()) + 0.5);
+        }
+
+        uint8_t clamp_channel(int value)
+        {
+            return uint8_t(std::clamp(value, 0, 255));
+        }
+
+        void write_indices(const std::vector<uint8_t>& indices, size_t bits,
+                           unsigned char* dst)
+        {
+            if (bits == 8)
+            {
+                std::copy(indices.begin(), indices.end(), dst);
+                return;
+            }
+
+            const auto per_byte = 8 / bits;
+            for (size_t i = 0; i < indices.size(); i += per_byte)
+            {
+                unsigned byte = 0;
+                for (size_t j = i; j < i + per_byte; ++j)
+                    byte = byte << bits | (j < indices.size() ? indices[j] : 0);
+                *dst++ = uint8_t(byte);
+            }
+        }
+
+        void remap_band(const ImageView& src, const std::vector<Rgba8>& palette,
+                        const MutableImageView& dst, DitherMethod dither,
+                        size_t y0, size_t y1)
+        {
+            NearestColor nearest(palette);
+            const auto bits = get_pixel_size(dst.pixel_type());
+            const auto width = src.width();
+            std::vector<Rgba8> row;
+            std::vector<uint8_t> indices(width);
+
+            const auto spread = get_dither_spread(palette);
+
+            // Floyd-Steinberg errors, times 16, for the RGB channels of
+            // the current and the next row, with an extra pixel at
+            // each end.
+            std::vector<int> errors, next_errors;
+            if (dither == DitherMethod::FLOYD_STEINBERG)
+            {
+                errors.resize((width + 2) * 3);
+                next_errors.resize((width + 2) * 3);
+            }
+
+            for (size_t y = y0; y < y1; ++y)
+            {
+                load_row(src, y, row);
+                switch (dither)
+                {
+                case DitherMethod::NONE:
+                    for (size_t x = 0; x < width; ++x)
+                        indices[x] = nearest.find(row[x]);
+                    break;
+                case DitherMethod::ORDERED:
+                    for (size_t x = 0; x < width; ++x)
+                    {
+                        auto c = row[x];
+                        if (c.a != 0)
+                        {
+                            auto offset = (BAYER_8X8[y % 8][x % 8] * 2 - 63)
+                                          * spread / 128;
+                            c = {clamp_channel(c.r + offset),
+                                 clamp_channel(c.g + offset),
+                                 clamp_channel(c.b + offset),
+                                 c.a};
+                        }
+                        indices[x] = nearest.find(c);
+                    }
+                    break;
+                case DitherMethod::FLOYD_STEINBERG:
+                    std::fill(next_errors.begin(), next_errors.end(), 0);
+                    for (size_t x = 0; x < width; ++x)
+                    {
+                        auto c = row[x];
+                        if (c.a == 0)
+                        {
+                            indices[x] = nearest.find(c);
+                            continue;
+                        }
+
+                        auto error = &errors[(x + 1) * 3];
+                        c = {clamp_channel(c.r + error[0] / 16),
+                             clamp_channel(c.g + error[1] / 16),
+                             clamp_channel(c.b + error[2] / 16),
+                             c.a};
+                        indices[x] = nearest.find(c);
+
+                        const auto& p = palette[indices[x]];
+                        const int diff[3] = {c.r - p.r, c.g - p.g, c.b - p.b};
+                        for (size_t ch = 0; ch < 3; ++ch)
+                        {
+                            errors[(x + 2) * 3 + ch] += diff[ch] * 7;
+                            next_errors[x * 3 + ch] += diff[ch] * 3;
+                            next_errors[(x + 1) * 3 + ch] += diff[ch] * 5;
+                            next_errors[(x + 2) * 3 + ch] += diff[ch];
+                        }
+                    }
+                    std::swap(errors, next_errors);
+                    break;
+                }
+                write_indices(indices, bits, dst.row(y).first);
+            }
+        }
+
+        PixelType get_indexed_pixel_type(size_t palette_size, size_t width)
+        {
+            const PixelType types[] = {PixelType::INDEXED_1,
+                                       PixelType::INDEXED_2,
+                                       PixelType::INDEXED_4};
+            for (auto type : types)
+            {
+                auto bits = get_pixel_size(type);
+                if (palette_size <= size_t(1) << bits && width * bits % 8 == 0)
+                    return type;
+            }
+            return PixelType::INDEXED_8;
+        }
+    }
+
+    std::vector<Rgba8> make_palette(const ImageView& src, size_t max_colors,
+                                    const ExecutionContext& context)
+    {
+        if (max_colors < 2 || max_colors > 256)
+            YIMAGE_THROW("max_colors must be from 2 to 256: " + std::to_string(max_colors));
+        return create_palette(src, max_colors, context).colors;
+    }
+
+    void remap_to_palette(const ImageView& src,
+                          const std::vector<Rgba8>& palette,
+                          const MutableImageView& dst,
+                          DitherMethod dither,
+                          const ExecutionContext& context)
+    {
+        if (!is_indexed(dst.pixel_type()))
+            YIMAGE_THROW("The destination image doesn't have an indexed pixel type.");
+        if (src.width() != dst.width() || src.height() != dst.height())
+            YIMAGE_THROW("Source and destination images must have the same size.");
+        if (palette.empty()
+            || palette.size() > size_t(1) << get_pixel_size(dst.pixel_type()))
+        {
+            YIMAGE_THROW("Invalid palette size: " + std::to_string(palette.size()));
+        }
+        if (!src)
+            return;
+
+        const auto band_count = get_band_count(src, context);
+        run_parallel(
+            band_count,
+            [&](size_t band)
+            {
+                auto [y0, y1] = get_band_rows(src.height(), band_count, band);
+                remap_band(src, palette, dst, dither, y0, y1);
+            },
+            context);
+    }
+
+    Image quantize(const ImageView& src, const QuantizeOptions& options,
+                   const ExecutionContext& context)
+    {
+        auto palette = create_palette(src, options.max_colors(), context);
+        Image image(get_indexed_pixel_type(palette.colors.size(), src.width()),
+                    src.width(), src.height());
+        remap_to_palette(src, palette.colors, image.mutable_view(),
+                         palette.exact ? DitherMethod::NONE : options.dither(),
+                         context);
+
+        auto metadata = std::make_unique<ImageMetadata>();
+        metadata->palette = std::move(palette.colors);
+        image.set_metadata(std::move(metadata));
+        return image;
+    }
+}
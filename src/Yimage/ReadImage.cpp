@@ -66,28 +66,30 @@ namespace Yimage
         return ImageFormat::UNKNOWN;
     }
 
-    Image read_image(const std::filesystem::path& path)
+    ImageFormat get_image_format(ImageSource& source)
     {
-        std::ifstream stream(path, std::ios::binary);
         char buffer[16];
-        stream.read(buffer, 16);
+        auto size = source.read(0, buffer, sizeof(buffer));
+        return get_image_format(buffer, size);
+    }
 
-        switch (get_image_format(buffer, size_t(stream.gcount())))
+    Image read_image(ImageSource& source, const ImageReadOptions& options)
+    {
+        switch (get_image_format(source))
         {
 #ifdef YIMAGE_JPEG
         case ImageFormat::JPEG:
-            stream.close();
-            return read_jpeg(path);
+            return read_jpeg(source,
+                             JpegReadOptions().min_size(options.min_width(),
+                                                        options.min_height()));
 #endif
 #ifdef YIMAGE_PNG
         case ImageFormat::PNG:
-            stream.seekg(0, std::ios::beg);
-            return read_png(stream);
+            return read_png(source);
 #endif
 #ifdef YIMAGE_TIFF
         case ImageFormat::TIFF:
-            stream.seekg(0, std::ios::beg);
-            return read_tiff(stream, path);
+            return read_tiff(source);
 #endif
         case ImageFormat::UNKNOWN:
         default:
@@ -95,25 +97,57 @@ namespace Yimage
         }
     }
 
-    Image read_image(const void* buffer, size_t size)
+    Image read_image(const std::filesystem::path& path,
+                     const ImageReadOptions& options)
+    {
+        auto image = read_image(*open_image_source(path), options);
+        if (auto metadata = image.metadata())
+            metadata->path = path;
+        return image;
+    }
+
+    Image read_image(const void* buffer, size_t size,
+                     const ImageReadOptions& options)
+    {
+        MemorySource source(buffer, size);
+        return read_image(source, options);
+    }
+
+    void read_image_into(ImageSource& source, const MutableImageView& dst)
     {
-        switch (get_image_format(buffer, size))
+        switch (get_image_format(source))
         {
 #ifdef YIMAGE_JPEG
         case ImageFormat::JPEG:
-            return read_jpeg(buffer, size);
+            read_jpeg_into(source, dst);
+            break;
 #endif
 #ifdef YIMAGE_PNG
         case ImageFormat::PNG:
-            return read_png(buffer, size);
+            read_png_into(source, dst);
+            break;
 #endif
 #ifdef YIMAGE_TIFF
         case ImageFormat::TIFF:
-            return read_tiff(buffer, size);
+            read_tiff_into(source, dst);
+            break;
 #endif
         case ImageFormat::UNKNOWN:
         default:
             YIMAGE_THROW("Unrecognized image format.");
         }
     }
+
+    void read_image_into(const std::filesystem::path& path,
+                         const MutableImageView& dst)
+    {
+        read_image_into(*open_image_source(path), dst);
+    }
+
+    void read_image_into(const void* buffer, size_t size,
+                         const MutableImageView& dst)
+    {
+        MemorySource source(buffer, size);
+        read_image_into(source, dst);
+    }
 }
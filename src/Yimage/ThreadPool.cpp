@@ -0,0 +1,132 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-19.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "ThreadPool.hpp"
+
+#include <algorithm>
+
+namespace Yimage
+{
+    namespace
+    {
+        thread_local const ThreadPool* current_pool = nullptr;
+        thread_local size_t current_queue = 0;
+    }
+
+    ThreadPool::ThreadPool(size_t thread_count)
+    {
+        thread_count = std::max<size_t>(thread_count, 1);
+        queues_.reserve(thread_count);
+        for (size_t i = 0; i < thread_count; ++i)
+            queues_.push_back(std::make_unique<Queue>());
+        threads_.reserve(thread_count);
+        for (size_t i = 0; i < thread_count; ++i)
+            threads_.emplace_back([this, i] {run(i);});
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+        {
+            std::lock_guard lock(mutex_);
+            stop_ = true;
+        }
+        condition_.notify_all();
+        for (auto& thread : threads_)
+            thread.join();
+    }
+
+    size_t ThreadPool::thread_count() const
+    {
+        return threads_.size();
+    }
+
+    void ThreadPool::submit(std::function<void()> task)
+    {
+        size_t index;
+        {
+            std::lock_guard lock(mutex_);
+            ++pending_;
+            // Tasks submitted by a worker go to its own queue, where
+            // it will find them first. Other tasks are spread evenly.
+            if (current_pool == this)
+                index = current_queue;
+            else
+                index = next_queue_++ % queues_.size();
+        }
+
+        {
+            auto& queue = *queues_[index];
+            std::lock_guard lock(queue.mutex);
+            queue.tasks.push_back(std::move(task));
+        }
+        condition_.notify_one();
+    }
+
+    bool ThreadPool::pop_or_steal(size_t index, std::function<void()>& task)
+    {
+        {
+            auto& queue = *queues_[index];
+            std::lock_guard lock(queue.mutex);
+            if (!queue.tasks.empty())
+            {
+                task = std::move(queue.tasks.back());
+                queue.tasks.pop_back();
+                return true;
+            }
+        }
+
+        for (size_t i = 1; i < queues_.size(); ++i)
+        {
+            auto& queue = *queues_[(index + i) % queues_.size()];
+            std::lock_guard lock(queue.mutex);
+            if (!queue.tasks.empty())
+            {
+                task = std::move(queue.tasks.front());
+                queue.tasks.pop_front();
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    void ThreadPool::run(size_t index)
+    {
+        current_pool = this;
+        current_queue = index;
+        while (true)
+        {
+            {
+                std::unique_lock lock(mutex_);
+                condition_.wait(lock, [this] {return stop_ || pending_ != 0;});
+                if (pending_ == 0)
+                    return;
+            }
+
+            std::function<void()> task;
+            if (!pop_or_steal(index, task))
+            {
+                // The task is counted, but not yet pushed to a queue.
+                std::this_thread::yield();
+                continue;
+            }
+
+            {
+                std::lock_guard lock(mutex_);
+                --pending_;
+            }
+            task();
+        }
+    }
+
+    ThreadPool& get_thread_pool()
+    {
+        static ThreadPool pool(std::max(std::thread::hardware_concurrency(),
+                                        2u) - 1);
+        return pool;
+    }
+}
@@ -0,0 +1,75 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-19.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "Yimage/ExecutionContext.hpp"
+
+namespace Yimage
+{
+    /**
+     * @brief A thread pool where each worker has its own task queue and
+     *      idle workers steal tasks from the other workers' queues.
+     */
+    class ThreadPool
+    {
+    public:
+        explicit ThreadPool(size_t thread_count);
+
+        ThreadPool(const ThreadPool&) = delete;
+
+        ~ThreadPool();
+
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        [[nodiscard]]
+        size_t thread_count() const;
+
+        void submit(std::function<void()> task);
+    private:
+        struct Queue
+        {
+            std::mutex mutex;
+            std::deque<std::function<void()>> tasks;
+        };
+
+        bool pop_or_steal(size_t index, std::function<void()>& task);
+
+        void run(size_t index);
+
+        std::vector<std::unique_ptr<Queue>> queues_;
+        std::vector<std::thread> threads_;
+        std::mutex mutex_;
+        std::condition_variable condition_;
+        size_t pending_ = 0;
+        size_t next_queue_ = 0;
+        bool stop_ = false;
+    };
+
+    /**
+     * @brief Returns the pool used by parallel operations when the
+     *      execution context has no executor.
+     *
+     * The pool is created on first use and has one thread less than
+     * the number of hardware threads, as the calling thread always
+     * takes part in the work.
+     */
+    ThreadPool& get_thread_pool();
+
+    /**
+     * @brief Runs @a task with the executor in @a context, or on the
+     *      internal pool if the context has no executor.
+     */
+    void submit_task(const ExecutionContext& context,
+                     std::function<void()> task);
+}
@@ -7,7 +7,8 @@
 //****************************************************************************
 #include "OpenTiff.hpp"
 
-#include <iostream>
+#include <mutex>
+#include <span>
 #include <tiffio.h>
 #include "ReadGeoTiffMetadata.hpp"
 
@@ -15,87 +16,91 @@
 
 namespace
 {
-    class TiffInputStream
+    /**
+     * @brief Gives libtiff sequential access to an ImageSource.
+     */
+    class TiffSourceReader
     {
     public:
-        explicit TiffInputStream(std::istream& stream)
-            : stream_(&stream),
-              start_pos_(stream.tellg())
+        explicit TiffSourceReader(Yimage::ImageSource& source)
+            : source_(&source),
+              data_(source.data())
         {
         }
 
         tmsize_t read(void* buf, tmsize_t size)
         {
-            std::streamsize request_size = size;
-            if (static_cast<tmsize_t>(request_size) != size)
+            if (size < 0)
                 return -1;
-
-            stream_->read((char*)buf, request_size);
-
-            return stream_->gcount();
+            try
+            {
+                auto n = source_->read(pos_, buf, size_t(size));
+                pos_ += n;
+                return tmsize_t(n);
+            }
+            catch (std::exception&)
+            {
+                return -1;
+            }
         }
 
         toff_t seek(toff_t off, int whence)
         {
+            toff_t base;
             switch (whence)
             {
             case SEEK_SET:
-            {
-                toff_t new_offset = static_cast<toff_t>(start_pos_) + off;
-
-                // Verify that value does not overflow
-                auto offset = static_cast<std::ios::off_type>(new_offset);
-                if (static_cast<toff_t>(offset) != new_offset)
-                    return static_cast<toff_t>(-1);
-
-                stream_->seekg(offset, std::ios::beg);
+                base = 0;
                 break;
-            }
             case SEEK_CUR:
-            {
-                // Verify that value does not overflow
-                auto offset = static_cast<std::ios::off_type>(off);
-                if (static_cast<toff_t>(offset) != off)
-                    return static_cast<toff_t>(-1);
-
-                stream_->seekg(offset, std::ios::cur);
+                base = pos_;
                 break;
-            }
             case SEEK_END:
-            {
-                // Verify that value does not overflow
-                auto offset = static_cast<std::ios::off_type>(off);
-                if (static_cast<toff_t>(offset) != off)
-                    return static_cast<toff_t>(-1);
-
-                stream_->seekg(offset, std::ios::end);
+                base = size();
                 break;
-            }
+            default:
+                return static_cast<toff_t>(-1);
             }
 
-            return static_cast<toff_t>(stream_->tellg());
+            // Offsets are unsigned, negative offsets wrap around.
+            auto new_pos = base + off;
+            if (new_pos > size())
+                return static_cast<toff_t>(-1);
+            pos_ = new_pos;
+            return new_pos;
         }
 
         [[nodiscard]] toff_t size() const
         {
-            std::ios::pos_type pos = stream_->tellg();
-            stream_->seekg(0, std::ios::end);
-            std::ios::pos_type size = stream_->tellg();
-            stream_->seekg(pos);
-            return size;
+            return source_->size();
+        }
+
+        [[nodiscard]] bool is_mapped() const
+        {
+            return !data_.empty();
         }
 
+        bool map(void** base, toff_t* size) const
+        {
+            if (data_.empty())
+                return false;
+            // libtiff never writes through the mapping when the file
+            // is opened for reading.
+            *base = const_cast<unsigned char*>(data_.data());
+            *size = data_.size();
+            return true;
+        }
     private:
-        std::istream* stream_;
-        std::ios::pos_type start_pos_;
+        Yimage::ImageSource* source_;
+        std::span<const unsigned char> data_;
+        uint64_t pos_ = 0;
     };
 }
 
 extern "C" {
 static tmsize_t tiff_read_proc(thandle_t fd, void* buf, tmsize_t size)
 {
-    auto* reader = static_cast<TiffInputStream*>(fd);
-    return reader->read(buf, size);
+    return static_cast<TiffSourceReader*>(fd)->read(buf, size);
 }
 
 static tmsize_t tiff_write_proc(thandle_t, void*, tmsize_t)
@@ -105,28 +110,26 @@ static tmsize_t tiff_write_proc(thandle_t, void*, tmsize_t)
 
 static toff_t tiff_seek_proc(thandle_t fd, toff_t off, int whence)
 {
-    auto* reader = static_cast<TiffInputStream*>(fd);
-    return reader->seek(off, whence);
+    return static_cast<TiffSourceReader*>(fd)->seek(off, whence);
 }
 
 static toff_t tiff_size_proc(thandle_t fd)
 {
-    auto* reader = static_cast<TiffInputStream*>(fd);
-    return reader->size();
+    return static_cast<TiffSourceReader*>(fd)->size();
 }
 
 static int tiff_close_proc(thandle_t fd)
 {
-    delete static_cast<TiffInputStream*>(fd);
+    delete static_cast<TiffSourceReader*>(fd);
     return 0;
 }
 
-static int tiff_dummy_map_proc(thandle_t, void** /*base*/, toff_t* /*size*/)
+static int tiff_map_proc(thandle_t fd, void** base, toff_t* size)
 {
-    return (0);
+    return static_cast<TiffSourceReader*>(fd)->map(base, size) ? 1 : 0;
 }
 
-static void tiff_dummy_unmap_proc(thandle_t, void* /*base*/, toff_t /*size*/)
+static void tiff_unmap_proc(thandle_t, void* /*base*/, toff_t /*size*/)
 {
 }
 
@@ -145,24 +148,22 @@ namespace Yimage
 
     void register_additional_tags()
     {
-        static bool has_registered_extra_tags = false;
-        if (!has_registered_extra_tags)
-        {
-            TIFFSetTagExtender(register_extra_tags);
-            has_registered_extra_tags = true;
-        }
+        static std::once_flag flag;
+        std::call_once(flag, [] {TIFFSetTagExtender(register_extra_tags);});
     }
 
     std::unique_ptr<TIFF, TiffDeleter>
-    open_tiff(std::istream& is, const char* stream_name)
+    open_tiff(ImageSource& source, const char* stream_name)
     {
         register_additional_tags();
 
-        auto* reader = new TiffInputStream(is);
+        // Without the "m" flag, libtiff reads strips and tiles directly
+        // from sources that are in memory through the map procedure.
+        auto* reader = new TiffSourceReader(source);
         std::unique_ptr<TIFF, TiffDeleter> tiff(TIFFClientOpen(
-            stream_name, "rm", reader, tiff_read_proc,
-            tiff_write_proc, tiff_seek_proc, tiff_close_proc,
-            tiff_size_proc, tiff_dummy_map_proc, tiff_dummy_unmap_proc));
+            stream_name, reader->is_mapped() ? "r" : "rm", reader,
+            tiff_read_proc, tiff_write_proc, tiff_seek_proc, tiff_close_proc,
+            tiff_size_proc, tiff_map_proc, tiff_unmap_proc));
 
         if (!tiff)
             delete reader;
@@ -7,9 +7,9 @@
 //****************************************************************************
 #pragma once
 #include <filesystem>
-#include <iosfwd>
 #include <memory>
 #include <tiffio.h>
+#include "Yimage/ImageSource.hpp"
 
 namespace Yimage
 {
@@ -18,8 +18,12 @@ namespace Yimage
         void operator()(TIFF* tiff) const;
     };
 
+    /**
+     * @brief Opens a TIFF image in @a source. The source must remain
+     *      valid until the TIFF is closed.
+     */
     std::unique_ptr<TIFF, TiffDeleter>
-    open_tiff(std::istream& is, const char* stream_name);
+    open_tiff(ImageSource& source, const char* stream_name);
 
     std::unique_ptr<TIFF, TiffDeleter>
     open_tiff(const std::filesystem::path& path);
@@ -7,12 +7,13 @@
 //****************************************************************************
 #include "Yimage/Tiff/ReadTiff.hpp"
 
-#include <fstream>
+#include <algorithm>
+#include <vector>
 #include "Yimage/ImageAlgorithms.hpp"
+#include "Yimage/Tiff/TiffDecoder.hpp"
 #include "Yimage/Tiff/TiffMetadata.hpp"
 #include "Yimage/YimageException.hpp"
-#include "../FileUtilities.hpp"
-#include "../ReadOnlyStreamBuffer.hpp"
+#include "../ImageReaderBackend.hpp"
 #include "OpenTiff.hpp"
 #include "ReadGeoTiffMetadata.hpp"
 
@@ -94,27 +95,153 @@ namespace Yimage
             return strips;
         }
 
-        Image read_float32_tiles(TIFF* tiff, const TiffMetadata& metadata)
+        // The scratch buffer holds strips and tiles that can't be decoded
+        // straight into the destination. TiffDecoder keeps it between
+        // images.
+        using ScratchBuffer = std::vector<uint32_t>;
+
+        bool read_float32_tiles(TIFF* tiff, const TiffMetadata& metadata,
+                                const MutableImageView& dst,
+                                ScratchBuffer& scratch)
         {
-            Image image(PixelType::MONO_FLOAT_32, metadata.width, metadata.height);
-            Image tile_image(PixelType::MONO_FLOAT_32, metadata.tiles->width,
-                             metadata.tiles->height);
+            // The tiles are read one at a time, pasting them is too little
+            // work to be worth sharing with other threads.
+            auto context = ExecutionContext()
+                .parallelism(ParallelismHint::SEQUENTIAL);
+            scratch.resize(size_t(metadata.tiles->width) * metadata.tiles->height);
+            ImageView tile_image(reinterpret_cast<const unsigned char*>(scratch.data()),
+                                 PixelType::MONO_FLOAT_32,
+                                 metadata.tiles->width,
+                                 metadata.tiles->height);
             for (auto& tile : metadata.tiles->tiles)
             {
                 if (TIFFReadTile(tiff,
-                                 tile_image.data(),
+                                 scratch.data(),
                                  tile.x * metadata.tiles->width,
                                  tile.y * metadata.tiles->height,
                                  0, 0) != -1)
                 {
-                    paste(tile_image.view(),
-                          image.mutable_subimage(tile.x * metadata.tiles->width,
-                                                 tile.y * metadata.tiles->height,
-                                                 metadata.tiles->width,
-                                                 metadata.tiles->height));
+                    paste(tile_image,
+                          dst.subimage(tile.x * metadata.tiles->width,
+                                       tile.y * metadata.tiles->height,
+                                       metadata.tiles->width,
+                                       metadata.tiles->height),
+                          0, 0, context);
                 }
             }
-            return image;
+            return true;
+        }
+
+        bool read_float32_strips(TIFF* tiff, const TiffMetadata& metadata,
+                                 const MutableImageView& dst,
+                                 ScratchBuffer& scratch)
+        {
+            const auto rows_per_strip = std::min(metadata.strips->rows_per_strip,
+                                                 metadata.height);
+            const auto row_size = size_t(metadata.width) * sizeof(float);
+
+            // Strips are decoded straight into the destination unless
+            // it has gaps between the rows.
+            const bool contiguous = dst.is_contiguous();
+            if (!contiguous)
+                scratch.resize(size_t(metadata.width) * rows_per_strip);
+            auto bytes = reinterpret_cast<unsigned char*>(scratch.data());
+
+            for (uint32_t y = 0; y < metadata.height; y += rows_per_strip)
+            {
+                auto rows = std::min(rows_per_strip, metadata.height - y);
+                auto strip = TIFFComputeStrip(tiff, y, 0);
+                auto buffer = contiguous ? dst.row(y).first : bytes;
+                if (TIFFReadEncodedStrip(tiff, strip, buffer,
+                                         tmsize_t(rows * row_size)) == -1)
+                {
+                    return false;
+                }
+
+                if (!contiguous)
+                {
+                    for (uint32_t i = 0; i < rows; ++i)
+                        std::copy_n(bytes + i * row_size, row_size, dst.row(y + i).first);
+                }
+            }
+            return true;
+        }
+
+        // TIFFReadRGBAImage, TIFFReadRGBAStrip and TIFFReadRGBATile all
+        // return the rows bottom-up. read_tiff has always returned RGBA
+        // images in this orientation, so the strip and tile readers
+        // place the rows accordingly.
+
+        bool read_rgba_strips(TIFF* tiff, const TiffMetadata& metadata,
+                              const MutableImageView& dst,
+                              ScratchBuffer& buffer)
+        {
+            uint32_t rows_per_strip = metadata.height;
+            if (metadata.strips)
+                rows_per_strip = std::min(metadata.strips->rows_per_strip,
+                                          metadata.height);
+
+            const auto row_size = size_t(metadata.width) * 4;
+            buffer.resize(size_t(metadata.width) * rows_per_strip);
+            auto bytes = reinterpret_cast<const unsigned char*>(buffer.data());
+            for (uint32_t y = 0; y < metadata.height; y += rows_per_strip)
+            {
+                if (!TIFFReadRGBAStrip(tiff, y, buffer.data()))
+                    return false;
+
+                auto rows = std::min(rows_per_strip, metadata.height - y);
+                for (uint32_t i = 0; i < rows; ++i)
+                {
+                    // Buffer row i is file row y + rows - 1 - i.
+                    auto file_row = y + rows - 1 - i;
+                    std::copy_n(bytes + i * row_size, row_size,
+                                dst.row(metadata.height - 1 - file_row).first);
+                }
+            }
+            return true;
+        }
+
+        bool read_rgba_tiles(TIFF* tiff, const TiffMetadata& metadata,
+                             const MutableImageView& dst,
+                             ScratchBuffer& buffer)
+        {
+            const auto tile_width = metadata.tiles->width;
+            const auto tile_height = metadata.tiles->height;
+            buffer.resize(size_t(tile_width) * tile_height);
+            auto bytes = reinterpret_cast<const unsigned char*>(buffer.data());
+            for (auto& tile : metadata.tiles->tiles)
+            {
+                auto x = tile.x * tile_width;
+                auto y = tile.y * tile_height;
+                if (!TIFFReadRGBATile(tiff, x, y, buffer.data()))
+                    return false;
+
+                auto columns = std::min(tile_width, metadata.width - x);
+                auto rows = std::min(tile_height, metadata.height - y);
+                for (uint32_t i = 0; i < rows; ++i)
+                {
+                    // Buffer row tile_height - 1 - i is file row y + i.
+                    auto src = bytes + size_t(tile_height - 1 - i) * tile_width * 4;
+                    std::copy_n(src, size_t(columns) * 4,
+                                dst.pixel_pointer(x, metadata.height - 1 - (y + i)));
+                }
+            }
+            return true;
+        }
+
+        bool read_rgba(TIFF* tiff, const TiffMetadata& metadata,
+                       const MutableImageView& dst, ScratchBuffer& scratch)
+        {
+            if (dst.is_contiguous())
+            {
+                return TIFFReadRGBAImage(tiff, metadata.width, metadata.height,
+                                         reinterpret_cast<uint32_t*>(dst.data()),
+                                         0) != 0;
+            }
+
+            if (TIFFIsTiled(tiff) && metadata.tiles)
+                return read_rgba_tiles(tiff, metadata, dst, scratch);
+            return read_rgba_strips(tiff, metadata, dst, scratch);
         }
 
         std::unique_ptr<TiffMetadata> get_metadata(TIFF* tiff)
@@ -154,61 +281,182 @@ namespace Yimage
         }
     }
 
-    Image read_tiff(std::istream& stream,
-                    const std::filesystem::path& path)
+    namespace
     {
-        std::string stream_name = path.string();
-        auto tiff = open_tiff(stream, stream_name.c_str());
-        if (!tiff)
-            return {};
+        PixelType get_pixel_type(const TiffMetadata& metadata)
+        {
+            if (metadata.bits_per_sample <= 16)
+                return PixelType::RGBA_8;
 
-        auto metadata = get_metadata(tiff.get());
+            if (metadata.bits_per_sample == 32
+                && metadata.samples_per_pixel == 1
+                && metadata.sample_format == SAMPLEFORMAT_IEEEFP
+                && metadata.planar_configuration == PLANARCONFIG_CONTIG
+                && (metadata.tiles || metadata.strips))
+            {
+                return PixelType::MONO_FLOAT_32;
+            }
 
-        Image image;
-        if (metadata->bits_per_sample <= 16)
+            return PixelType::NONE;
+        }
+
+        bool read_pixels(TIFF* tiff, const TiffMetadata& metadata,
+                         const MutableImageView& dst, ScratchBuffer& scratch)
         {
-            image = Image(PixelType::RGBA_8, metadata->width, metadata->height);
-            if (!image)
-                return {};
+            if (dst.pixel_type() == PixelType::RGBA_8)
+                return read_rgba(tiff, metadata, dst, scratch);
+            if (metadata.tiles)
+                return read_float32_tiles(tiff, metadata, dst, scratch);
+            return read_float32_strips(tiff, metadata, dst, scratch);
+        }
+
+        Image read_tiff(TIFF* tiff, const std::filesystem::path& path,
+                        ScratchBuffer& scratch)
+        {
+            auto metadata = get_metadata(tiff);
 
-            if (!TIFFReadRGBAImage(tiff.get(),
-                                   metadata->width, metadata->height,
-                                   reinterpret_cast<uint32_t*>(image.data()),
-                                   0))
+            Image image;
+            auto pixel_type = get_pixel_type(*metadata);
+            if (pixel_type != PixelType::NONE)
             {
-                return {};
+                image = Image(pixel_type, metadata->width, metadata->height);
+                if (!image)
+                    return {};
+
+                if (!read_pixels(tiff, *metadata, image.mutable_view(), scratch))
+                    return {};
             }
+
+            metadata->path = path;
+
+            image.set_metadata(std::move(metadata));
+            return image;
         }
-        else if (metadata->bits_per_sample == 32
-                 && metadata->samples_per_pixel == 1
-                 && metadata->sample_format == SAMPLEFORMAT_IEEEFP
-                 && metadata->planar_configuration == PLANARCONFIG_CONTIG)
+
+        void read_tiff_into(TIFF* tiff, const MutableImageView& dst,
+                            ScratchBuffer& scratch)
         {
-            if (metadata->tiles)
+            auto metadata = get_metadata(tiff);
+            auto pixel_type = get_pixel_type(*metadata);
+            if (pixel_type == PixelType::NONE)
+                YIMAGE_THROW("Unsupported TIFF image format.");
+            if (dst.pixel_type() != pixel_type
+                || dst.width() != metadata->width
+                || dst.height() != metadata->height)
             {
-                image = read_float32_tiles(tiff.get(), *metadata);
+                YIMAGE_THROW("The destination must have the same size and pixel type as the image.");
             }
+
+            if (!read_pixels(tiff, *metadata, dst, scratch))
+                YIMAGE_THROW("Could not read the TIFF image.");
         }
+    }
 
-        metadata->path = path;
+    Image read_tiff(ImageSource& source, const std::filesystem::path& path)
+    {
+        std::string stream_name = path.string();
+        auto tiff = open_tiff(source, stream_name.c_str());
+        if (!tiff)
+            return {};
+
+        ScratchBuffer scratch;
+        return read_tiff(tiff.get(), path, scratch);
+    }
 
-        image.set_metadata(std::move(metadata));
-        return image;
+    Image read_tiff(std::istream& stream,
+                    const std::filesystem::path& path)
+    {
+        StreamSource source(stream);
+        return read_tiff(source, path);
     }
 
     Image read_tiff(const std::filesystem::path& path)
     {
-        std::ifstream file(path, std::ios::binary);
-        if (!file)
-            YIMAGE_THROW("Could not open file: " + path.string());
-        return read_tiff(file, path);
+        return read_tiff(*open_image_source(path), path);
     }
 
     Image read_tiff(const void* buffer, size_t size)
     {
-        ReadOnlyStreamBuffer stream_buffer(static_cast<const char*>(buffer), size);
-        std::istream stream(&stream_buffer);
-        return read_tiff(stream);
+        MemorySource source(buffer, size);
+        return read_tiff(source);
+    }
+
+    void read_tiff_into(ImageSource& source, const MutableImageView& dst,
+                        const std::filesystem::path& path)
+    {
+        std::string stream_name = path.string();
+        auto tiff = open_tiff(source, stream_name.c_str());
+        if (!tiff)
+            YIMAGE_THROW("Could not open " + stream_name);
+
+        ScratchBuffer scratch;
+        read_tiff_into(tiff.get(), dst, scratch);
+    }
+
+    void read_tiff_into(std::istream& stream, const MutableImageView& dst,
+                        const std::filesystem::path& path)
+    {
+        StreamSource source(stream);
+        read_tiff_into(source, dst, path);
+    }
+
+    void read_tiff_into(const std::filesystem::path& path,
+                        const MutableImageView& dst)
+    {
+        read_tiff_into(*open_image_source(path), dst, path);
+    }
+
+    void read_tiff_into(const void* buffer, size_t size,
+                        const MutableImageView& dst)
+    {
+        MemorySource source(buffer, size);
+        read_tiff_into(source, dst);
+    }
+
+    struct TiffDecoder::Data
+    {
+        ScratchBuffer scratch;
+    };
+
+    TiffDecoder::TiffDecoder()
+        : data_(std::make_unique<Data>())
+    {}
+
+    TiffDecoder::TiffDecoder(TiffDecoder&& rhs) noexcept = default;
+
+    TiffDecoder::~TiffDecoder() = default;
+
+    TiffDecoder& TiffDecoder::operator=(TiffDecoder&& rhs) noexcept = default;
+
+    Image TiffDecoder::read(ImageSource& source)
+    {
+        auto tiff = open_tiff(source, "TIFF stream");
+        if (!tiff)
+            return {};
+
+        return read_tiff(tiff.get(), "TIFF stream", data_->scratch);
+    }
+
+    Image TiffDecoder::read(const void* buffer, size_t size)
+    {
+        MemorySource source(buffer, size);
+        return read(source);
+    }
+
+    void TiffDecoder::read_into(ImageSource& source, const MutableImageView& dst)
+    {
+        auto tiff = open_tiff(source, "TIFF stream");
+        if (!tiff)
+            YIMAGE_THROW("Could not open TIFF stream.");
+
+        read_tiff_into(tiff.get(), dst, data_->scratch);
+    }
+
+    void TiffDecoder::read_into(const void* buffer, size_t size,
+                                const MutableImageView& dst)
+    {
+        MemorySource source(buffer, size);
+        read_into(source, dst);
     }
 
     std::unique_ptr<TiffMetadata> read_tiff_metadata(const std::filesystem::path& path)
@@ -221,4 +469,161 @@ namespace Yimage
         metadata->path = path;
         return metadata;
     }
+
+    namespace
+    {
+        /**
+         * @brief Reads a TIFF image one strip or one row of tiles at a time.
+         *
+         * The most recently decoded strip or row of tiles is kept in a
+         * cache with the rows in file order. RGBA images are returned
+         * bottom-up to match read_tiff, which means that the strips are
+         * read starting with the last one.
+         */
+        class TiffReaderBackend : public ImageReaderBackend
+        {
+        public:
+            explicit TiffReaderBackend(std::unique_ptr<ImageSource> source)
+                : source_(std::move(source))
+            {
+                tiff_ = open_tiff(*source_, "TIFF stream");
+                if (!tiff_)
+                    YIMAGE_THROW("Could not open TIFF stream.");
+
+                metadata_ = get_metadata(tiff_.get());
+                auto pixel_type = get_pixel_type(*metadata_);
+                if (pixel_type == PixelType::NONE)
+                    YIMAGE_THROW("Unsupported TIFF image format.");
+                info_ = {ImageFormat::TIFF,
+                         metadata_->width,
+                         metadata_->height,
+                         pixel_type};
+
+                rgba_ = pixel_type == PixelType::RGBA_8;
+                row_size_ = size_t(metadata_->width) * 4;
+                if (metadata_->tiles)
+                {
+                    block_height_ = metadata_->tiles->height;
+                    scratch_.resize(size_t(metadata_->tiles->width)
+                                    * metadata_->tiles->height * 4);
+                }
+                else
+                {
+                    block_height_ = metadata_->height;
+                    if (metadata_->strips && metadata_->strips->rows_per_strip)
+                        block_height_ = std::min(metadata_->strips->rows_per_strip,
+                                                 metadata_->height);
+                    if (rgba_)
+                        scratch_.resize(size_t(block_height_) * row_size_);
+                }
+                cache_.resize(size_t(block_height_) * row_size_);
+            }
+
+            [[nodiscard]]
+            const ImageInfo& info() const override
+            {
+                return info_;
+            }
+
+            void read_rows(const MutableImageView& band) override
+            {
+                for (size_t i = 0; i < band.height(); ++i, ++row_)
+                {
+                    auto file_row = uint32_t(rgba_ ? metadata_->height - 1 - row_
+                                                   : row_);
+                    if (file_row < cache_start_
+                        || file_row >= cache_start_ + cache_rows_)
+                    {
+                        load_block(file_row / block_height_ * block_height_);
+                    }
+
+                    auto src = cache_.data() + (file_row - cache_start_) * row_size_;
+                    std::copy_n(src, row_size_, band.row(i).first);
+                }
+            }
+        private:
+            void load_block(uint32_t y)
+            {
+                cache_start_ = y;
+                cache_rows_ = std::min(block_height_, metadata_->height - y);
+                if (metadata_->tiles)
+                    load_tiles(y);
+                else if (rgba_)
+                    load_rgba_strip(y);
+                else
+                    load_strip(y);
+            }
+
+            void load_tiles(uint32_t y)
+            {
+                const auto tile_width = metadata_->tiles->width;
+                const auto tile_size = size_t(tile_width) * 4;
+                for (uint32_t x = 0; x < metadata_->width; x += tile_width)
+                {
+                    auto ok = rgba_
+                        ? TIFFReadRGBATile(tiff_.get(), x, y,
+                                           reinterpret_cast<uint32_t*>(scratch_.data())) != 0
+                        : TIFFReadTile(tiff_.get(), scratch_.data(), x, y, 0, 0) != -1;
+                    if (!ok)
+                        YIMAGE_THROW("Could not read TIFF tile.");
+
+                    auto columns = std::min(tile_width, metadata_->width - x);
+                    for (uint32_t i = 0; i < cache_rows_; ++i)
+                    {
+                        // RGBA tiles are bottom-up and always have the
+                        // full tile height.
+                        auto src_row = rgba_ ? block_height_ - 1 - i : i;
+                        std::copy_n(scratch_.data() + src_row * tile_size,
+                                    size_t(columns) * 4,
+                                    cache_.data() + i * row_size_ + size_t(x) * 4);
+                    }
+                }
+            }
+
+            void load_rgba_strip(uint32_t y)
+            {
+                if (!TIFFReadRGBAStrip(tiff_.get(), y,
+                                       reinterpret_cast<uint32_t*>(scratch_.data())))
+                {
+                    YIMAGE_THROW("Could not read TIFF strip.");
+                }
+
+                for (uint32_t i = 0; i < cache_rows_; ++i)
+                {
+                    std::copy_n(scratch_.data() + (cache_rows_ - 1 - i) * row_size_,
+                                row_size_,
+                                cache_.data() + i * row_size_);
+                }
+            }
+
+            void load_strip(uint32_t y)
+            {
+                auto strip = TIFFComputeStrip(tiff_.get(), y, 0);
+                if (TIFFReadEncodedStrip(tiff_.get(), strip, cache_.data(),
+                                         tmsize_t(cache_rows_ * row_size_)) == -1)
+                {
+                    YIMAGE_THROW("Could not read TIFF strip.");
+                }
+            }
+
+            std::unique_ptr<ImageSource> source_;
+            std::unique_ptr<TIFF, TiffDeleter> tiff_;
+            std::unique_ptr<TiffMetadata> metadata_;
+            ImageInfo info_;
+            bool rgba_ = false;
+            size_t row_size_ = 0;
+            uint32_t block_height_ = 0;
+            std::vector<unsigned char> scratch_;
+            std::vector<unsigned char> cache_;
+            uint32_t cache_start_ = 0;
+            uint32_t cache_rows_ = 0;
+            size_t row_ = 0;
+        };
+    }
+
+    std::unique_ptr<ImageReaderBackend>
+    make_tiff_reader_backend(std::unique_ptr<ImageSource> source)
+    {
+        return std::make_unique<TiffReaderBackend>(std::move(source));
+    }
 }
@@ -0,0 +1,129 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-19.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "Yimage/TileScheduler.hpp"
+
+#include <algorithm>
+#include "Yimage/YimageException.hpp"
+
+namespace Yimage
+{
+    namespace
+    {
+        constexpr size_t DEFAULT_GRAIN_SIZE = 64 * 1024;
+
+        // Tiles are narrower than the image only if this many rows
+        // don't fit within the grain size.
+        constexpr size_t MIN_TILE_ROWS = 8;
+
+        constexpr size_t MIN_TILE_ROW_SIZE = 64;
+    }
+
+    bool operator==(const ImageRegion& a, const ImageRegion& b)
+    {
+        return a.x == b.x && a.y == b.y
+               && a.width == b.width && a.height == b.height;
+    }
+
+    std::vector<ImageRegion> make_tiles(size_t width, size_t height,
+                                        size_t pixel_size,
+                                        size_t grain_size)
+    {
+        if (width == 0 || height == 0)
+            return {};
+        if (pixel_size == 0)
+            YIMAGE_THROW("Pixel size can not be 0.");
+        if (grain_size == 0)
+            grain_size = DEFAULT_GRAIN_SIZE;
+
+        auto row_size = (width * pixel_size + 7) / 8;
+        size_t tile_width = width;
+        size_t tile_height;
+        if (row_size * MIN_TILE_ROWS <= grain_size)
+        {
+            tile_height = grain_size / row_size;
+        }
+        else
+        {
+            tile_height = MIN_TILE_ROWS;
+            auto tile_row_size = std::max(grain_size / MIN_TILE_ROWS,
+                                          MIN_TILE_ROW_SIZE);
+            tile_width = std::max<size_t>(tile_row_size * 8 / pixel_size / 8 * 8,
+                                          8);
+        }
+
+        std::vector<ImageRegion> tiles;
+        tiles.reserve(((height + tile_height - 1) / tile_height)
+                      * ((width + tile_width - 1) / tile_width));
+        for (size_t y = 0; y < height; y += tile_height)
+        {
+            auto h = std::min(tile_height, height - y);
+            for (size_t x = 0; x < width; x += tile_width)
+                tiles.push_back({x, y, std::min(tile_width, width - x), h});
+        }
+        return tiles;
+    }
+
+    void for_each_tile(size_t width, size_t height, size_t pixel_size,
+                       const std::function<void(const ImageRegion&)>& kernel,
+                       const ExecutionContext& context)
+    {
+        auto max_threads = context.max_threads();
+        auto grain_size = context.grain_size();
+        if (context.parallelism() == ParallelismHint::MAXIMUM)
+        {
+            // Make sure there's at least one tile per thread.
+            auto size = (width * pixel_size + 7) / 8 * height;
+            auto max_grain_size = std::max<size_t>(size / max_threads, 1);
+            if (grain_size == 0 || grain_size > max_grain_size)
+                grain_size = max_grain_size;
+        }
+
+        auto tiles = make_tiles(width, height, pixel_size, grain_size);
+        if (tiles.size() <= 1 || max_threads <= 1)
+        {
+            for (auto& tile : tiles)
+                kernel(tile);
+            return;
+        }
+
+        run_parallel(tiles.size(), [&](size_t i) {kernel(tiles[i]);}, context);
+    }
+
+    void for_each_tile(const MutableImageView& image,
+                       const std::function<void(const MutableImageView&)>& kernel,
+                       const ExecutionContext& context)
+    {
+        for_each_tile(
+            image.width(), image.height(), image.pixel_size(),
+            [&](const ImageRegion& r)
+            {
+                kernel(image.subimage(r.x, r.y, r.width, r.height));
+            },
+            context);
+    }
+
+    void for_each_tile(const ImageView& src,
+                       const MutableImageView& dst,
+                       const std::function<void(const ImageView&,
+                                                const MutableImageView&)>& kernel,
+                       const ExecutionContext& context)
+    {
+        if (src.width() != dst.width() || src.height() != dst.height())
+            YIMAGE_THROW("Source and destination images must have the same size.");
+
+        for_each_tile(
+            src.width(), src.height(),
+            std::max(src.pixel_size(), dst.pixel_size()),
+            [&](const ImageRegion& r)
+            {
+                kernel(src.subimage(r.x, r.y, r.width, r.height),
+                       dst.subimage(r.x, r.y, r.width, r.height));
+            },
+            context);
+    }
+}
@@ -0,0 +1,149 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-19.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "Yimage/WriteImage.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include "Yimage/ImageWriter.hpp"
+#include "Yimage/Quantize.hpp"
+
+namespace Yimage
+{
+    namespace
+    {
+        ImageInfo get_info(const ImageView& image, ImageFormat format)
+        {
+            ImageInfo info{format, image.width(), image.height(), image.pixel_type()};
+            if (auto metadata = image.metadata())
+                info.palette = metadata->palette;
+            return info;
+        }
+
+        ImageInfo get_info(const Pipeline& pipeline, ImageFormat format)
+        {
+            return {format, pipeline.width(), pipeline.height(),
+                    pipeline.pixel_type(), pipeline.palette()};
+        }
+
+        bool needs_quantizing(PixelType pixel_type, ImageFormat format,
+                              const PngWriteOptions& png_options)
+        {
+            return format == ImageFormat::PNG && png_options.quantize()
+                   && !is_indexed(pixel_type);
+        }
+
+        template <typename Target>
+        void write_view(Target& target, const ImageView& image,
+                        ImageFormat format, const PngWriteOptions& png_options)
+        {
+            if (needs_quantizing(image.pixel_type(), format, png_options))
+            {
+                auto indexed = quantize(image, *png_options.quantize());
+                write_view(target, indexed.view(), format, png_options);
+                return;
+            }
+
+            ImageWriter writer(target, get_info(image, format), png_options);
+            writer.write_rows(image);
+        }
+
+        template <typename Target>
+        void write_pipeline(Target& target, Pipeline& pipeline,
+                            ImageFormat format, const PngWriteOptions& png_options)
+        {
+            // The palette can't be made until all the pixels are known.
+            if (needs_quantizing(pipeline.pixel_type(), format, png_options))
+            {
+                auto image = pipeline.to_image();
+                write_view(target, image.view(), format, png_options);
+                return;
+            }
+
+            ImageWriter writer(target, get_info(pipeline, format), png_options);
+            pipeline.run([&](const ImageView& band)
+                         {
+                             writer.write_rows(band);
+                         });
+        }
+
+        ImageFormat get_format(const std::filesystem::path& path, ImageFormat format)
+        {
+            if (format == ImageFormat::UNKNOWN)
+                return get_image_format_from_extension(path);
+            return format;
+        }
+    }
+
+    ImageFormat get_image_format_from_extension(const std::filesystem::path& path)
+    {
+        auto ext = path.extension().string();
+        std::transform(ext.begin(), ext.end(), ext.begin(),
+                       [](unsigned char c) {return char(std::tolower(c));});
+        if (ext == ".png")
+            return ImageFormat::PNG;
+        if (ext == ".jpg" || ext == ".jpeg")
+            return ImageFormat::JPEG;
+        if (ext == ".tif" || ext == ".tiff")
+            return ImageFormat::TIFF;
+        return ImageFormat::UNKNOWN;
+    }
+
+    void write_image(const std::filesystem::path& path,
+                     const ImageView& image)
+    {
+        write_image(path, image, ImageFormat::UNKNOWN);
+    }
+
+    void write_image(const std::filesystem::path& path,
+                     const ImageView& image,
+                     ImageFormat format,
+                     const PngWriteOptions& png_options)
+    {
+        write_view(path, image, get_format(path, format), png_options);
+    }
+
+    void write_image(std::ostream& stream,
+                     const ImageView& image,
+                     ImageFormat format,
+                     const PngWriteOptions& png_options)
+    {
+        write_view(stream, image, format, png_options);
+    }
+
+    void write_image(ImageSink& sink,
+                     const ImageView& image,
+                     ImageFormat format,
+                     const PngWriteOptions& png_options)
+    {
+        write_view(sink, image, format, png_options);
+    }
+
+    void write_image(const std::filesystem::path& path,
+                     Pipeline& pipeline,
+                     ImageFormat format,
+                     const PngWriteOptions& png_options)
+    {
+        write_pipeline(path, pipeline, get_format(path, format), png_options);
+    }
+
+    void write_image(std::ostream& stream,
+                     Pipeline& pipeline,
+                     ImageFormat format,
+                     const PngWriteOptions& png_options)
+    {
+        write_pipeline(stream, pipeline, format, png_options);
+    }
+
+    void write_image(ImageSink& sink,
+                     Pipeline& pipeline,
+                     ImageFormat format,
+                     const PngWriteOptions& png_options)
+    {
+        write_pipeline(sink, pipeline, format, png_options);
+    }
+}
@@ -0,0 +1,45 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-19.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <chrono>
+#include <iostream>
+#include <string>
+
+/**
+ * @brief Calls @a func repeatedly for at least @a min_duration and
+ *      prints how many items per second it processed.
+ *
+ * @param items The number of items processed by each call to @a func.
+ * @return Items per second.
+ */
+template <typename Func>
+double report_throughput(const std::string& name,
+                         const std::string& unit,
+                         size_t items, Func func,
+                         std::chrono::duration<double> min_duration
+                             = std::chrono::seconds(1))
+{
+    using Clock = std::chrono::steady_clock;
+
+    // Warm up caches and lazily initialized state.
+    func();
+
+    size_t calls = 0;
+    auto start = Clock::now();
+    std::chrono::duration<double> elapsed{};
+    do
+    {
+        func();
+        ++calls;
+        elapsed = Clock::now() - start;
+    } while (elapsed < min_duration);
+
+    auto rate = double(calls * items) / elapsed.count();
+    std::cout << name << ": " << rate << " " << unit << "/s\n";
+    return rate;
+}
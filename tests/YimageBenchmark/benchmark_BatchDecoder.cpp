@@ -0,0 +1,54 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-19.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include <thread>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include "Yimage/BatchDecoder.hpp"
+#include "Yimage/ReadImage.hpp"
+#include "Resources.hpp"
+#include "Throughput.hpp"
+
+TEST_CASE("Benchmark BatchDecoder")
+{
+    using namespace Yimage;
+    constexpr size_t IMAGES = 48;
+    std::vector<std::pair<const void*, size_t>> buffers;
+    for (size_t i = 0; i < IMAGES / 2; ++i)
+    {
+        buffers.emplace_back(THUMB_UP_PNG, THUMB_UP_PNG_SIZE);
+        buffers.emplace_back(CITY_JPG, CITY_JPG_SIZE);
+    }
+
+    size_t pixels = 0;
+    report_throughput(
+        "read_image loop", "images", buffers.size(),
+        [&]
+        {
+            for (auto [buffer, size] : buffers)
+                pixels += read_image(buffer, size).width();
+        });
+
+    auto cores = std::max(std::thread::hardware_concurrency(), 1u);
+    for (size_t threads = 1; threads <= cores; threads *= 2)
+    {
+        report_throughput(
+            "BatchDecoder, " + std::to_string(threads) + " threads",
+            "images", buffers.size(),
+            [&]
+            {
+                BatchDecoder decoder(buffers, BatchDecoderOptions(),
+                                     ExecutionContext().thread_count(threads));
+                decoder.run([&](BatchResult& result)
+                            {
+                                pixels += result.image.width();
+                            });
+            });
+    }
+
+    REQUIRE(pixels != 0);
+}
@@ -0,0 +1,142 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-19.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include <catch2/catch_test_macros.hpp>
+#include "Yimage/Pipeline.hpp"
+#include "Yimage/ReadImage.hpp"
+#include "Yimage/Jpeg/JpegDecoder.hpp"
+#include "Yimage/Jpeg/ReadJpeg.hpp"
+#include "Yimage/Png/PngDecoder.hpp"
+#include "Yimage/Png/ReadPng.hpp"
+#include "Yimage/Png/WritePng.hpp"
+#include "Yimage/Tiff/ReadTiff.hpp"
+#include "Yimage/Tiff/TiffDecoder.hpp"
+#include "Resources.hpp"
+#include "Throughput.hpp"
+
+namespace
+{
+    constexpr size_t IMAGES_PER_CALL = 100;
+
+    /**
+     * @brief Prints the number of images per second decoded with
+     *      a new decoder per image and with one reused decoder.
+     */
+    template <typename Decoder, typename ReadFunc>
+    void compare(const std::string& name, const void* buffer, size_t size,
+                 ReadFunc read)
+    {
+        size_t pixels = 0;
+        auto fresh_rate = report_throughput(
+            name + " (new decoder)", "images", IMAGES_PER_CALL,
+            [&]
+            {
+                for (size_t i = 0; i < IMAGES_PER_CALL; ++i)
+                    pixels += read(buffer, size).width();
+            });
+
+        Decoder decoder;
+        auto reused_rate = report_throughput(
+            name + " (reused decoder)", "images", IMAGES_PER_CALL,
+            [&]
+            {
+                for (size_t i = 0; i < IMAGES_PER_CALL; ++i)
+                    pixels += decoder.read(buffer, size).width();
+            });
+
+        REQUIRE(pixels != 0);
+        std::cout << name << ": saved "
+                  << (1e6 / fresh_rate - 1e6 / reused_rate)
+                  << " us per image\n";
+    }
+}
+
+TEST_CASE("Benchmark decoder reuse")
+{
+    compare<Yimage::PngDecoder>(
+        "32x32 PNG", THUMB_UP_PNG, THUMB_UP_PNG_SIZE,
+        [](const void* b, size_t s) {return Yimage::read_png(b, s);});
+    compare<Yimage::JpegDecoder>(
+        "150x150 JPEG", CITY_JPG, CITY_JPG_SIZE,
+        [](const void* b, size_t s) {return Yimage::read_jpeg(b, s);});
+    compare<Yimage::TiffDecoder>(
+        "701x711 TIFF", GEOID_TIF, GEOID_TIF_SIZE,
+        [](const void* b, size_t s) {return Yimage::read_tiff(b, s);});
+}
+
+TEST_CASE("Benchmark interlaced PNG decoding")
+{
+    using namespace Yimage;
+    auto image = Pipeline(read_image(CITY_JPG, CITY_JPG_SIZE).view())
+        .convert(PixelType::RGBA_8)
+        .resize(2000, 2000)
+        .to_image();
+
+    PngDecoder decoder;
+    for (bool interlaced : {false, true})
+    {
+        std::vector<unsigned char> buffer;
+        VectorSink sink(buffer);
+        write_png(sink, image.view(),
+                  PngWriteOptions::fastest().interlaced(interlaced));
+
+        size_t pixels = 0;
+        auto rate = report_throughput(
+            interlaced ? "read_png interlaced" : "read_png", "images", 1,
+            [&]
+            {
+                pixels += decoder.read(buffer.data(), buffer.size()).width();
+            });
+        std::cout << "    " << rate * image.size() / 1e6 << " MB/s\n";
+        REQUIRE(pixels != 0);
+    }
+}
+
+TEST_CASE("Benchmark PNG decoding without checksums")
+{
+    using namespace Yimage;
+    auto image = Pipeline(read_image(CITY_JPG, CITY_JPG_SIZE).view())
+        .convert(PixelType::RGBA_8)
+        .resize(2000, 2000)
+        .to_image();
+    std::vector<unsigned char> buffer;
+    VectorSink sink(buffer);
+    write_png(sink, image.view(), PngWriteOptions::fastest());
+
+    for (bool verify : {true, false})
+    {
+        PngDecoder decoder(PngReadOptions().verify_checksums(verify));
+        size_t pixels = 0;
+        auto rate = report_throughput(
+            verify ? "read_png" : "read_png trusted", "images", 1,
+            [&]
+            {
+                pixels += decoder.read(buffer.data(), buffer.size()).width();
+            });
+        std::cout << "    " << rate * image.size() / 1e6 << " MB/s\n";
+        REQUIRE(pixels != 0);
+    }
+}
+
+TEST_CASE("Benchmark scaled JPEG decoding")
+{
+    using namespace Yimage;
+    for (unsigned denom : {1u, 2u, 4u, 8u})
+    {
+        JpegDecoder decoder(JpegReadOptions().scale_denom(denom));
+        size_t pixels = 0;
+        report_throughput(
+            "150x150 JPEG at 1/" + std::to_string(denom), "images",
+            IMAGES_PER_CALL,
+            [&]
+            {
+                for (size_t i = 0; i < IMAGES_PER_CALL; ++i)
+                    pixels += decoder.read(CITY_JPG, CITY_JPG_SIZE).width();
+            });
+        REQUIRE(pixels != 0);
+    }
+}
@@ -0,0 +1,95 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-19.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include <fstream>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include "Yimage/ProbeImage.hpp"
+#include "Yimage/ReadImage.hpp"
+#include "Resources.hpp"
+#include "Throughput.hpp"
+
+namespace
+{
+    constexpr size_t FILES_PER_FORMAT = 100;
+
+    class ImageDirectory
+    {
+    public:
+        ImageDirectory()
+            : dir_(std::filesystem::temp_directory_path()
+                   / "YimageBenchmark_probe")
+        {
+            std::filesystem::create_directories(dir_);
+            add_files("png", THUMB_UP_PNG, THUMB_UP_PNG_SIZE);
+            add_files("jpg", CITY_JPG, CITY_JPG_SIZE);
+            add_files("tif", GEOID_TIF, GEOID_TIF_SIZE);
+        }
+
+        ~ImageDirectory()
+        {
+            std::error_code ec;
+            std::filesystem::remove_all(dir_, ec);
+        }
+
+        [[nodiscard]]
+        const std::vector<std::filesystem::path>& paths() const
+        {
+            return paths_;
+        }
+    private:
+        void add_files(const std::string& extension,
+                       const void* data, size_t size)
+        {
+            for (size_t i = 0; i < FILES_PER_FORMAT; ++i)
+            {
+                auto path = dir_ / (std::to_string(i) + "." + extension);
+                std::ofstream(path, std::ios::binary)
+                    .write(static_cast<const char*>(data), std::streamsize(size));
+                paths_.push_back(path);
+            }
+        }
+
+        std::filesystem::path dir_;
+        std::vector<std::filesystem::path> paths_;
+    };
+}
+
+TEST_CASE("Benchmark probe_image")
+{
+    ImageDirectory dir;
+    auto& paths = dir.paths();
+
+    size_t pixels = 0;
+    auto probe_rate = report_throughput(
+        "probe_image(path)", "files", paths.size(),
+        [&]
+        {
+            for (auto& path : paths)
+                pixels += Yimage::probe_image(path).width;
+        });
+
+    auto read_rate = report_throughput(
+        "read_image(path)", "files", paths.size(),
+        [&]
+        {
+            for (auto& path : paths)
+                pixels += Yimage::read_image(path).width();
+        });
+
+    REQUIRE(pixels != 0);
+    REQUIRE(probe_rate > read_rate);
+
+    report_throughput(
+        "probe_image(buffer)", "files", 3,
+        [&]
+        {
+            pixels += Yimage::probe_image(THUMB_UP_PNG, THUMB_UP_PNG_SIZE).width;
+            pixels += Yimage::probe_image(CITY_JPG, CITY_JPG_SIZE).width;
+            pixels += Yimage::probe_image(GEOID_TIF, GEOID_TIF_SIZE).width;
+        });
+}
@@ -0,0 +1,252 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-19.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include <filesystem>
+#include <fstream>
+#include <memory_resource>
+#include <sstream>
+#include <thread>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include "Yimage/Pipeline.hpp"
+#include "Yimage/Png/WritePng.hpp"
+#include "Yimage/ReadImage.hpp"
+#include "Resources.hpp"
+#include "Throughput.hpp"
+
+namespace
+{
+    /**
+     * @brief Returns the number of write system calls the process has
+     *      made, or 0 if the operating system doesn't tell.
+     */
+    size_t get_write_syscall_count()
+    {
+        std::ifstream file("/proc/self/io");
+        std::string key;
+        size_t value = 0;
+        while (file >> key >> value)
+        {
+            if (key == "syscw:")
+                return value;
+        }
+        return 0;
+    }
+}
+
+TEST_CASE("Benchmark PNG presets")
+{
+    using namespace Yimage;
+    // Upscale the photo to get an image large enough for zlib's
+    // window and buffer sizes to matter.
+    auto image = Pipeline(read_image(CITY_JPG, CITY_JPG_SIZE).view())
+        .resize(1200, 1200)
+        .to_image();
+
+    std::pair<std::string, PngWriteOptions> presets[] = {
+        {"fastest", PngWriteOptions::fastest()},
+        {"balanced", PngWriteOptions::balanced()},
+        {"smallest", PngWriteOptions::smallest()}
+    };
+
+    std::vector<unsigned char> buffer;
+    for (auto& [name, options] : presets)
+    {
+        auto rate = report_throughput(
+            "write_png " + name, "images", 1,
+            [&]
+            {
+                buffer.clear();
+                VectorSink sink(buffer);
+                write_png(sink, image.view(), options);
+            });
+        std::cout << "    " << rate * image.size() / 1e6 << " MB/s, "
+                  << buffer.size() << " bytes\n";
+        REQUIRE(!buffer.empty());
+    }
+}
+
+TEST_CASE("Benchmark PNG encoding to memory")
+{
+    using namespace Yimage;
+    auto image = Pipeline(read_image(CITY_JPG, CITY_JPG_SIZE).view())
+        .resize(2000, 2000)
+        .to_image();
+    // Without compression the cost of storing the bytes is easier to see.
+    auto options = PngWriteOptions().compression_level(0);
+    auto context = ExecutionContext().parallelism(ParallelismHint::SEQUENTIAL);
+
+    size_t size = 0;
+    auto rate = report_throughput(
+        "write_png to std::ostringstream", "images", 1,
+        [&]
+        {
+            std::ostringstream stream;
+            write_png(stream, image.view(), options, context);
+            size += stream.str().size();
+        });
+    std::cout << "    " << rate * image.size() / 1e6 << " MB/s\n";
+
+    rate = report_throughput(
+        "write_png to std::vector", "images", 1,
+        [&]
+        {
+            std::vector<unsigned char> buffer;
+            write_png(buffer, image.view(), options, context);
+            size += buffer.size();
+        });
+    std::cout << "    " << rate * image.size() / 1e6 << " MB/s\n";
+
+    std::pmr::monotonic_buffer_resource arena(64 * 1024 * 1024);
+    rate = report_throughput(
+        "write_png to ArenaSink", "images", 1,
+        [&]
+        {
+            ArenaSink sink(&arena);
+            write_png(sink, image.view(), options, context);
+            size += sink.release().size();
+            arena.release();
+        });
+    std::cout << "    " << rate * image.size() / 1e6 << " MB/s\n";
+    REQUIRE(size != 0);
+}
+
+TEST_CASE("Benchmark parallel PNG encoding")
+{
+    using namespace Yimage;
+    auto image = Pipeline(read_image(CITY_JPG, CITY_JPG_SIZE).view())
+        .convert(PixelType::RGBA_8)
+        .resize(2000, 2000)
+        .to_image();
+
+    std::vector<unsigned char> buffer;
+    auto max_threads = std::max(std::thread::hardware_concurrency(), 1u);
+    for (size_t threads = 1; threads <= max_threads; threads *= 2)
+    {
+        auto context = ExecutionContext().thread_count(threads);
+        auto rate = report_throughput(
+            "write_png " + std::to_string(threads) + " thread(s)", "images", 1,
+            [&]
+            {
+                buffer.clear();
+                VectorSink sink(buffer);
+                write_png(sink, image.view(), {}, context);
+            });
+        std::cout << "    " << rate * image.size() / 1e6 << " MB/s, "
+                  << buffer.size() << " bytes\n";
+        REQUIRE(!buffer.empty());
+    }
+}
+
+TEST_CASE("Benchmark quantized PNG encoding")
+{
+    using namespace Yimage;
+    // The photo is gray and has fewer than 256 colors, the gradient
+    // has far more.
+    auto photo = Pipeline(read_image(CITY_JPG, CITY_JPG_SIZE).view())
+        .convert(PixelType::RGBA_8)
+        .resize(2000, 2000)
+        .to_image();
+    Image gradient(PixelType::RGBA_8, 2000, 2000);
+    for (size_t y = 0; y < gradient.height(); ++y)
+    {
+        auto row = gradient.mutable_view().row(y).first;
+        for (size_t x = 0; x < gradient.width(); ++x)
+        {
+            row[x * 4] = uint8_t(x / 8);
+            row[x * 4 + 1] = uint8_t(y / 8);
+            row[x * 4 + 2] = uint8_t((x + y) / 16);
+            row[x * 4 + 3] = 0xFF;
+        }
+    }
+
+    std::pair<std::string, PngWriteOptions> variants[] = {
+        {"truecolor", PngWriteOptions()},
+        {"256 colors", PngWriteOptions().quantize(QuantizeOptions())},
+        {"256 colors, Floyd-Steinberg", PngWriteOptions().quantize(
+            QuantizeOptions().dither(DitherMethod::FLOYD_STEINBERG))}
+    };
+
+    std::pair<std::string, const Image*> images[] = {
+        {"photo", &photo},
+        {"gradient", &gradient}
+    };
+
+    std::vector<unsigned char> buffer;
+    for (auto& [image_name, image] : images)
+    {
+        for (auto& [name, options] : variants)
+        {
+            auto rate = report_throughput(
+                "write_png " + image_name + " " + name, "images", 1,
+                [&]
+                {
+                    buffer.clear();
+                    VectorSink sink(buffer);
+                    write_png(sink, image->view(), options);
+                });
+            std::cout << "    " << rate * image->size() / 1e6 << " MB/s, "
+                      << buffer.size() << " bytes\n";
+            REQUIRE(!buffer.empty());
+        }
+    }
+}
+
+TEST_CASE("Benchmark writing PNG files")
+{
+    using namespace Yimage;
+    constexpr size_t FILE_COUNT = 20;
+    auto image = Pipeline(read_image(CITY_JPG, CITY_JPG_SIZE).view())
+        .resize(600, 600)
+        .to_image();
+    auto options = PngWriteOptions::fastest();
+    auto dir = std::filesystem::temp_directory_path() / "YimageBenchmark_write";
+    std::filesystem::create_directories(dir);
+
+    auto run = [&](const std::string& name, auto write_file)
+    {
+        size_t files = 0;
+        auto syscalls = get_write_syscall_count();
+        report_throughput(
+            name, "images", FILE_COUNT,
+            [&]
+            {
+                for (size_t i = 0; i < FILE_COUNT; ++i, ++files)
+                    write_file(dir / (std::to_string(i) + ".png"));
+            });
+        syscalls = get_write_syscall_count() - syscalls;
+        std::cout << "    " << double(syscalls) / double(files)
+                  << " write calls per image\n";
+    };
+
+    run("std::ofstream",
+        [&](const std::filesystem::path& path)
+        {
+            std::ofstream stream(path, std::ios::binary);
+            write_png(stream, image.view(), options);
+        });
+    run("FileSink without buffer",
+        [&](const std::filesystem::path& path)
+        {
+            FileSink sink(path, FileSinkOptions().buffer_size(0));
+            write_png(sink, image.view(), options);
+        });
+    run("FileSink",
+        [&](const std::filesystem::path& path)
+        {
+            FileSink sink(path);
+            write_png(sink, image.view(), options);
+        });
+    run("FileSink with preallocation",
+        [&](const std::filesystem::path& path)
+        {
+            FileSink sink(path, FileSinkOptions().preallocate(true));
+            write_png(sink, image.view(), options);
+        });
+
+    std::filesystem::remove_all(dir);
+}
@@ -0,0 +1,158 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-19.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "Yimage/AsyncImage.hpp"
+#include <sstream>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include "Yimage/ReadImage.hpp"
+#include "Resources.hpp"
+
+namespace
+{
+    struct Detached
+    {
+        struct promise_type
+        {
+            Detached get_return_object()
+            {
+                return {};
+            }
+
+            std::suspend_never initial_suspend() noexcept
+            {
+                return {};
+            }
+
+            std::suspend_never final_suspend() noexcept
+            {
+                return {};
+            }
+
+            void return_void()
+            {}
+
+            void unhandled_exception()
+            {
+                std::terminate();
+            }
+        };
+    };
+
+    Detached await_image(Yimage::AsyncTask<Yimage::Image> task,
+                         Yimage::Image& result)
+    {
+        result = co_await task;
+    }
+
+    // An executor that holds on to the tasks until they are run explicitly.
+    struct DeferredExecutor
+    {
+        void run_all()
+        {
+            for (auto& task : tasks)
+                task();
+            tasks.clear();
+        }
+
+        Yimage::Executor executor()
+        {
+            return [this](std::function<void()> task)
+            {
+                tasks.push_back(std::move(task));
+            };
+        }
+
+        std::vector<std::function<void()>> tasks;
+    };
+}
+
+TEST_CASE("Await async_read_image")
+{
+    using namespace Yimage;
+    DeferredExecutor executor;
+    Image image;
+    await_image(async_read_image(CITY_JPG, CITY_JPG_SIZE, executor.executor()),
+                image);
+    REQUIRE(!image);
+    executor.run_all();
+    REQUIRE(image.view() == read_image(CITY_JPG, CITY_JPG_SIZE).view());
+}
+
+TEST_CASE("async_read_image and async_write_png with futures")
+{
+    using namespace Yimage;
+    auto image = async_read_image(THUMB_UP_PNG, THUMB_UP_PNG_SIZE).get();
+    REQUIRE(image.view() == read_image(THUMB_UP_PNG, THUMB_UP_PNG_SIZE).view());
+    REQUIRE(image.metadata()->format == ImageFormat::PNG);
+
+    std::stringstream stream;
+    auto future = async_write_png(stream, image.view()).future();
+    future.get();
+    auto str = stream.str();
+    REQUIRE(read_image(str.data(), str.size()).view() == image.view());
+}
+
+TEST_CASE("Cancel async_read_image")
+{
+    using namespace Yimage;
+    DeferredExecutor executor;
+    std::stop_source stop_source;
+    auto task = async_read_image(GEOID_TIF, GEOID_TIF_SIZE,
+                                 executor.executor(),
+                                 stop_source.get_token());
+    stop_source.request_stop();
+    executor.run_all();
+    REQUIRE_THROWS_AS(task.get(), OperationCancelled);
+}
+
+TEST_CASE("async_read_image uses the default execution context")
+{
+    using namespace Yimage;
+    DeferredExecutor executor;
+    auto old_context = default_execution_context();
+    set_default_execution_context(ExecutionContext().executor(executor.executor()));
+    auto task = async_read_image(THUMB_UP_PNG, THUMB_UP_PNG_SIZE);
+    set_default_execution_context(old_context);
+    REQUIRE(executor.tasks.size() == 1);
+    executor.run_all();
+    REQUIRE(task.get().view() == read_image(THUMB_UP_PNG, THUMB_UP_PNG_SIZE).view());
+}
+
+TEST_CASE("async_write_png with options and context")
+{
+    using namespace Yimage;
+    auto image = read_image(CITY_JPG, CITY_JPG_SIZE);
+    DeferredExecutor executor;
+    std::stringstream stream;
+    auto task = async_write_png(stream, image.view(),
+                                PngWriteOptions().compression_level(0),
+                                ExecutionContext().executor(executor.executor())
+                                                  .thread_count(1));
+    REQUIRE(executor.tasks.size() == 1);
+    executor.run_all();
+    task.get();
+    auto str = stream.str();
+    // Uncompressed RGB pixels.
+    REQUIRE(str.size() > image.width() * image.height() * 3);
+    REQUIRE(read_image(str.data(), str.size()).view() == image.view());
+}
+
+TEST_CASE("Cancel async_write_png")
+{
+    using namespace Yimage;
+    auto image = read_image(CITY_JPG, CITY_JPG_SIZE);
+    DeferredExecutor executor;
+    std::stop_source stop_source;
+    std::stringstream stream;
+    auto task = async_write_png(stream, image.view(), {},
+                                ExecutionContext().executor(executor.executor()),
+                                stop_source.get_token());
+    stop_source.request_stop();
+    executor.run_all();
+    REQUIRE_THROWS_AS(task.get(), OperationCancelled);
+}
@@ -0,0 +1,109 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-19.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "Yimage/BatchDecoder.hpp"
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+#include "Yimage/ReadImage.hpp"
+#include "Resources.hpp"
+
+namespace
+{
+    const char INVALID_IMAGE[] = "Not an image";
+
+    std::vector<std::pair<const void*, size_t>> get_buffers()
+    {
+        return {
+            {THUMB_UP_PNG, THUMB_UP_PNG_SIZE},
+            {INVALID_IMAGE, sizeof(INVALID_IMAGE)},
+            {CITY_JPG, CITY_JPG_SIZE},
+            {GEOID_TIF, GEOID_TIF_SIZE},
+            {THUMB_UP_PNG, THUMB_UP_PNG_SIZE}
+        };
+    }
+}
+
+TEST_CASE("Decode batch in order")
+{
+    using namespace Yimage;
+    auto buffers = get_buffers();
+    BatchDecoder decoder(buffers, BatchDecoderOptions().max_pending(2));
+    REQUIRE(decoder.size() == buffers.size());
+
+    size_t index = 0;
+    decoder.run([&](BatchResult& result)
+                {
+                    REQUIRE(result.index == index);
+                    auto [buffer, size] = buffers[index];
+                    if (index == 1)
+                    {
+                        REQUIRE(result.error);
+                        REQUIRE(!result.image);
+                    }
+                    else
+                    {
+                        REQUIRE(!result.error);
+                        REQUIRE(result.image.view() == read_image(buffer, size).view());
+                    }
+                    ++index;
+                });
+    REQUIRE(index == buffers.size());
+    REQUIRE(!decoder.next());
+}
+
+TEST_CASE("Decode batch out of order")
+{
+    using namespace Yimage;
+    auto buffers = get_buffers();
+    BatchDecoder decoder(buffers, BatchDecoderOptions().ordered(false),
+                         ExecutionContext().thread_count(3));
+    std::vector<size_t> indexes;
+    while (auto result = decoder.next())
+        indexes.push_back(result->index);
+    std::sort(indexes.begin(), indexes.end());
+    REQUIRE(indexes == std::vector<size_t>{0, 1, 2, 3, 4});
+}
+
+TEST_CASE("Decode batch with inline executor")
+{
+    using namespace Yimage;
+    auto buffers = get_buffers();
+    size_t tasks = 0;
+    auto context = ExecutionContext().executor([&](std::function<void()> task)
+                                               {
+                                                   ++tasks;
+                                                   task();
+                                               });
+    BatchDecoder decoder(buffers, BatchDecoderOptions().max_pending(2), context);
+    size_t index = 0;
+    while (auto result = decoder.next())
+    {
+        REQUIRE(result->index == index);
+        REQUIRE(bool(result->error) == (index == 1));
+        ++index;
+    }
+    REQUIRE(index == buffers.size());
+    REQUIRE(tasks != 0);
+}
+
+TEST_CASE("Decode batch of files")
+{
+    using namespace Yimage;
+    BatchDecoder decoder({"non-existent-file.png"});
+    auto result = decoder.next();
+    REQUIRE(result);
+    REQUIRE(result->error);
+    REQUIRE(!decoder.next());
+}
+
+TEST_CASE("Destroy batch decoder before it is done")
+{
+    using namespace Yimage;
+    auto buffers = get_buffers();
+    BatchDecoder decoder(buffers, BatchDecoderOptions().max_pending(1));
+    REQUIRE(decoder.next());
+}
@@ -0,0 +1,84 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-19.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+#include "Yimage/Jpeg/JpegDecoder.hpp"
+#include "Yimage/Png/PngDecoder.hpp"
+#include "Yimage/Png/ReadPng.hpp"
+#include "Yimage/Png/WritePng.hpp"
+#include "Yimage/Tiff/TiffDecoder.hpp"
+#include "Yimage/ReadImage.hpp"
+#include "Resources.hpp"
+
+namespace
+{
+    template <typename Decoder>
+    void test_decoder(const void* buffer, size_t size)
+    {
+        auto expected = Yimage::read_image(buffer, size);
+        Decoder decoder;
+        for (int i = 0; i < 3; ++i)
+            REQUIRE(decoder.read(buffer, size).view() == expected.view());
+
+        // Leave a gap between the rows.
+        Yimage::Image image(expected.pixel_type(),
+                            expected.width() + 3, expected.height());
+        auto dst = image.mutable_view().subimage(0, 0, expected.width(),
+                                                 expected.height());
+        decoder.read_into(buffer, size, dst);
+        REQUIRE(Yimage::ImageView(dst) == expected.view());
+        decoder.read_into(buffer, size, dst);
+        REQUIRE(Yimage::ImageView(dst) == expected.view());
+    }
+}
+
+TEST_CASE("Reuse PngDecoder")
+{
+    test_decoder<Yimage::PngDecoder>(THUMB_UP_PNG, THUMB_UP_PNG_SIZE);
+}
+
+TEST_CASE("Read trusted PNG with invalid checksums")
+{
+    using namespace Yimage;
+    auto image = read_image(THUMB_UP_PNG, THUMB_UP_PNG_SIZE);
+    std::vector<unsigned char> buffer;
+    VectorSink sink(buffer);
+    write_png(sink, image.view());
+
+    // Change the last byte of the image data, which is part of the
+    // Adler-32 checksum, and the first byte of the chunk's CRC.
+    auto idat = std::search(buffer.begin(), buffer.end(), "IDAT", "IDAT" + 4);
+    REQUIRE(idat != buffer.end());
+    size_t length = size_t(idat[-4]) << 24 | size_t(idat[-3]) << 16
+                    | size_t(idat[-2]) << 8 | size_t(idat[-1]);
+    idat[3 + length] ^= 0xFF;
+    idat[4 + length] ^= 0xFF;
+
+    PngDecoder decoder(PngReadOptions::trusted());
+    REQUIRE(decoder.read(buffer.data(), buffer.size()).view() == image.view());
+    REQUIRE(read_png(buffer.data(), buffer.size(), PngReadOptions::trusted())
+            .view() == image.view());
+}
+
+TEST_CASE("Reuse JpegDecoder")
+{
+    test_decoder<Yimage::JpegDecoder>(CITY_JPG, CITY_JPG_SIZE);
+}
+
+TEST_CASE("Reuse TiffDecoder")
+{
+    test_decoder<Yimage::TiffDecoder>(GEOID_TIF, GEOID_TIF_SIZE);
+}
+
+TEST_CASE("JpegDecoder can be used after an error")
+{
+    Yimage::JpegDecoder decoder;
+    REQUIRE_THROWS(decoder.read(THUMB_UP_PNG, THUMB_UP_PNG_SIZE));
+    auto image = decoder.read(CITY_JPG, CITY_JPG_SIZE);
+    REQUIRE(image.view() == Yimage::read_image(CITY_JPG, CITY_JPG_SIZE).view());
+}
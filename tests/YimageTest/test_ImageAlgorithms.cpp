@@ -7,6 +7,7 @@
 //****************************************************************************
 #include "Yimage/ImageAlgorithms.hpp"
 #include <catch2/catch_test_macros.hpp>
+#include "Yimage/ImageMetadata.hpp"
 
 TEST_CASE("Test flip RGB image vertically")
 {
@@ -139,3 +140,70 @@ TEST_CASE("test fill_rgba8")
         REQUIRE(buffer == expected);
     }
 }
+
+TEST_CASE("Test expand_palette")
+{
+    using namespace Yimage;
+    const std::vector<Rgba8> palette{
+        Color::Red, Color::Green, Color::Blue, {1, 2, 3, 4}
+    };
+    // Two rows of 8 2-bit pixels.
+    std::vector<uint8_t> buffer{0b00011011, 0b11100100,
+                                0b01010101, 0b00001111};
+    ImageMetadata metadata;
+    metadata.palette = palette;
+    ImageView src(buffer.data(), PixelType::INDEXED_2, 8, 2, 0, &metadata);
+
+    SECTION("rgba8")
+    {
+        auto image = expand_palette(src);
+        REQUIRE(image.pixel_type() == PixelType::RGBA_8);
+        for (size_t y = 0; y < 2; ++y)
+        {
+            for (size_t x = 0; x < 8; ++x)
+                REQUIRE(get_rgba8(image.view(), x, y) == get_rgba8(src, x, y));
+        }
+        REQUIRE(get_rgba8(image.view(), 3, 0) == Rgba8(1, 2, 3, 4));
+        REQUIRE(get_rgba8(image.view(), 4, 1) == Color::Red);
+    }
+    SECTION("rgb8 from an explicit palette")
+    {
+        Image image(PixelType::RGB_8, 8, 2);
+        expand_palette(src, palette.data(), 2, image.mutable_view());
+        REQUIRE(get_rgba8(image.view(), 1, 0) == Color::Green);
+        // Indices outside the palette become black.
+        REQUIRE(get_rgba8(image.view(), 2, 0) == Color::Black);
+    }
+    SECTION("tiles that start inside a byte")
+    {
+        const PixelType pixel_types[] = {PixelType::INDEXED_1,
+                                         PixelType::INDEXED_2,
+                                         PixelType::INDEXED_4};
+        for (auto pixel_type : pixel_types)
+        {
+            Image indexed(pixel_type, 200, 20);
+            auto data = indexed.mutable_view().data();
+            for (size_t i = 0; i < indexed.size(); ++i)
+                data[i] = uint8_t(i * 37);
+            auto gray_metadata = std::make_unique<ImageMetadata>();
+            for (uint8_t i = 0; i < 16; ++i)
+                gray_metadata->palette.push_back({uint8_t(i * 16), i, 0, 0});
+            indexed.set_metadata(std::move(gray_metadata));
+
+            auto context = ExecutionContext().grain_size(1);
+            Image image(PixelType::RGB_8, 200, 20);
+            expand_palette(indexed.view(), image.mutable_view(), context);
+
+            CAPTURE(int(pixel_type));
+            for (size_t y = 0; y < 20; ++y)
+            {
+                for (size_t x = 0; x < 200; ++x)
+                {
+                    auto color = get_rgba8(indexed.view(), x, y);
+                    color.a = 0xFF;
+                    REQUIRE(get_rgba8(image.view(), x, y) == color);
+                }
+            }
+        }
+    }
+}
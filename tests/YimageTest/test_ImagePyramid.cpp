@@ -0,0 +1,88 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-19.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "Yimage/ImagePyramid.hpp"
+#include <cmath>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+
+TEST_CASE("Test pyramid level sizes")
+{
+    using namespace Yimage;
+    REQUIRE(get_max_pyramid_levels(5, 3) == 4);
+    REQUIRE(get_max_pyramid_levels(1, 1) == 1);
+    REQUIRE(get_max_pyramid_levels(0, 4) == 0);
+
+    ImagePyramid pyramid(PixelType::RGB_8, 5, 3);
+    REQUIRE(pyramid.level_count() == 4);
+    REQUIRE(pyramid.level(1).width() == 3);
+    REQUIRE(pyramid.level(1).height() == 2);
+    REQUIRE(pyramid.level(3).width() == 1);
+    REQUIRE(pyramid.level(3).height() == 1);
+    REQUIRE(pyramid.size() == (15 + 6 + 2 + 1) * 3);
+    REQUIRE(pyramid.level(2).data() == pyramid.data() + (15 + 6) * 3);
+}
+
+TEST_CASE("Test build_pyramid with box filter")
+{
+    using namespace Yimage;
+    std::vector<uint8_t> buffer{
+        0, 2, 10, 20, 99,
+        4, 6, 30, 40, 99,
+        100, 100, 200, 200, 99,
+        100, 100, 200, 200, 99
+    };
+    ImageView image(buffer.data(), PixelType::MONO_8, 4, 4, 1);
+
+    auto pyramid = build_pyramid(image);
+    REQUIRE(pyramid.level_count() == 3);
+    REQUIRE(pyramid.level(0) == image);
+    std::vector<uint8_t> expected1{3, 25, 100, 200};
+    REQUIRE(pyramid.level(1) == ImageView(expected1.data(), PixelType::MONO_8, 2, 2));
+    REQUIRE(*pyramid.level(2).data() == 82);
+
+    auto partial = build_pyramid(image, 2);
+    REQUIRE(partial.level_count() == 2);
+}
+
+TEST_CASE("Test build_pyramid with sRGB filter")
+{
+    using namespace Yimage;
+    std::vector<uint8_t> buffer{
+        0, 0, 0, 0, 255, 255, 255, 255,
+        0, 0, 0, 0, 255, 255, 255, 255
+    };
+    ImageView image(buffer.data(), PixelType::RGBA_8, 2, 2);
+
+    auto box = build_pyramid(image, 2, PyramidFilter::BOX);
+    REQUIRE(get_rgba8(box.level(1), 0, 0) == Rgba8(128, 128, 128, 128));
+
+    auto srgb = build_pyramid(image, 2, PyramidFilter::SRGB_BOX);
+    REQUIRE(get_rgba8(srgb.level(1), 0, 0) == Rgba8(188, 188, 188, 128));
+}
+
+TEST_CASE("Test build_pyramid ignores NaN and no-data values")
+{
+    using namespace Yimage;
+    const float nan = std::nanf("");
+    std::vector<float> buffer{
+        1, 3, nan, nan,
+        nan, nan, nan, -9999,
+    };
+    ImageView image(reinterpret_cast<unsigned char*>(buffer.data()),
+                    PixelType::MONO_FLOAT_32, 4, 2);
+
+    auto pyramid = build_pyramid(image, 2, PyramidFilter::BOX, -9999.0f);
+    auto level = reinterpret_cast<const float*>(pyramid.level(1).data());
+    REQUIRE(level[0] == 2);
+    REQUIRE(level[1] == -9999);
+
+    auto nan_pyramid = build_pyramid(image, 2);
+    auto nan_level = reinterpret_cast<const float*>(nan_pyramid.level(1).data());
+    REQUIRE(nan_level[0] == 2);
+    REQUIRE(nan_level[1] == -9999);
+}
@@ -0,0 +1,66 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-19.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "Yimage/ImageReader.hpp"
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+#include "Yimage/Pipeline.hpp"
+#include "Yimage/ReadImage.hpp"
+#include "Resources.hpp"
+
+namespace
+{
+    void test_read_rows(const void* buffer, size_t size)
+    {
+        using namespace Yimage;
+        auto expected = read_image(buffer, size);
+
+        ImageReader reader(buffer, size);
+        REQUIRE(reader.info() == probe_image(buffer, size));
+
+        Image image(reader.info().pixel_type,
+                    reader.info().width, reader.info().height);
+        const size_t band_height = 7;
+        for (size_t y = 0; y < image.height(); y += band_height)
+        {
+            auto rows = std::min(band_height, image.height() - y);
+            reader.read_rows(image.mutable_subimage(0, y, image.width(), rows));
+        }
+        REQUIRE(reader.current_row() == image.height());
+        REQUIRE(image.view() == expected.view());
+        REQUIRE_THROWS(reader.read_rows(image.mutable_subimage(0, 0, image.width(), 1)));
+
+        auto result = Pipeline(ImageReader(buffer, size)).band_height(5).to_image();
+        REQUIRE(result.view() == expected.view());
+    }
+}
+
+TEST_CASE("Read PNG rows")
+{
+    test_read_rows(THUMB_UP_PNG, THUMB_UP_PNG_SIZE);
+}
+
+TEST_CASE("Read JPEG rows")
+{
+    test_read_rows(CITY_JPG, CITY_JPG_SIZE);
+}
+
+TEST_CASE("Read TIFF rows")
+{
+    test_read_rows(GEOID_TIF, GEOID_TIF_SIZE);
+}
+
+TEST_CASE("Read rows with wrong band")
+{
+    using namespace Yimage;
+    ImageReader reader(THUMB_UP_PNG, THUMB_UP_PNG_SIZE);
+    Image narrow(reader.info().pixel_type, reader.info().width - 1, 1);
+    REQUIRE_THROWS(reader.read_rows(narrow.mutable_view()));
+    reader.close();
+    REQUIRE(!reader);
+    REQUIRE_THROWS(reader.info());
+}
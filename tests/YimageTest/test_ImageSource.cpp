@@ -0,0 +1,120 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-19.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "Yimage/ImageSource.hpp"
+#include <fstream>
+#include <sstream>
+#include <streambuf>
+#include <catch2/catch_test_macros.hpp>
+#include "Yimage/ImageSink.hpp"
+#include "Yimage/ProbeImage.hpp"
+#include "Yimage/ReadImage.hpp"
+#include "Yimage/Png/ReadPng.hpp"
+#include "Yimage/Png/WritePng.hpp"
+#include "Resources.hpp"
+
+namespace
+{
+    /**
+     * @brief A stream buffer that fails every attempt to seek.
+     */
+    class ForwardOnlyBuffer : public std::streambuf
+    {
+    public:
+        ForwardOnlyBuffer(const void* data, size_t size)
+        {
+            auto begin = static_cast<char*>(const_cast<void*>(data));
+            setg(begin, begin, begin + size);
+        }
+    };
+
+    void test_sources(const void* buffer, size_t size)
+    {
+        using namespace Yimage;
+        auto expected = read_image(buffer, size);
+
+        SECTION("StreamSource")
+        {
+            std::stringstream stream;
+            stream << "prefix";
+            stream.write(static_cast<const char*>(buffer), std::streamsize(size));
+            stream.seekg(6);
+            StreamSource source(stream);
+            REQUIRE(source.size() == size);
+            REQUIRE(read_image(source).view() == expected.view());
+        }
+
+        SECTION("FileSource and MappedFileSource")
+        {
+            auto path = std::filesystem::temp_directory_path()
+                        / "YimageTest_image_source";
+            std::ofstream(path, std::ios::binary)
+                .write(static_cast<const char*>(buffer), std::streamsize(size));
+
+            FileSource file_source(path);
+            REQUIRE(file_source.data().empty());
+            REQUIRE(probe_image(file_source) == probe_image(buffer, size));
+            REQUIRE(read_image(file_source).view() == expected.view());
+
+            MappedFileSource mapped_source(path);
+            REQUIRE(mapped_source.data().size() == size);
+            REQUIRE(read_image(mapped_source).view() == expected.view());
+
+            std::filesystem::remove(path);
+        }
+    }
+}
+
+TEST_CASE("Read PNG from sources")
+{
+    test_sources(THUMB_UP_PNG, THUMB_UP_PNG_SIZE);
+}
+
+TEST_CASE("Read JPEG from sources")
+{
+    test_sources(CITY_JPG, CITY_JPG_SIZE);
+}
+
+TEST_CASE("Read TIFF from sources")
+{
+    test_sources(GEOID_TIF, GEOID_TIF_SIZE);
+}
+
+TEST_CASE("Read PNG from a stream that can't seek")
+{
+    using namespace Yimage;
+    auto expected = read_image(THUMB_UP_PNG, THUMB_UP_PNG_SIZE);
+    for (bool interlaced : {false, true})
+    {
+        std::vector<unsigned char> png;
+        write_png(png, expected.view(), PngWriteOptions().interlaced(interlaced));
+        ForwardOnlyBuffer buffer(png.data(), png.size());
+        std::istream stream(&buffer);
+        REQUIRE(read_png(stream).view() == expected.view());
+    }
+}
+
+TEST_CASE("MemorySource reads at offsets")
+{
+    using namespace Yimage;
+    const char data[] = "abcdef";
+    MemorySource source(data, 6);
+    char buffer[4] = {};
+    REQUIRE(source.read(4, buffer, 4) == 2);
+    REQUIRE(std::string(buffer, 2) == "ef");
+    REQUIRE(source.read(7, buffer, 4) == 0);
+}
+
+TEST_CASE("Write PNG to VectorSink")
+{
+    using namespace Yimage;
+    auto image = read_image(THUMB_UP_PNG, THUMB_UP_PNG_SIZE);
+    std::vector<unsigned char> buffer;
+    VectorSink sink(buffer);
+    write_png(sink, image.view());
+    REQUIRE(read_image(buffer.data(), buffer.size()).view() == image.view());
+}
@@ -0,0 +1,135 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-19.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "Yimage/ImageWriter.hpp"
+#include <algorithm>
+#include <sstream>
+#include <catch2/catch_test_macros.hpp>
+#include "Yimage/Pipeline.hpp"
+#include "Yimage/Png/WritePng.hpp"
+#include "Yimage/Quantize.hpp"
+#include "Yimage/ReadImage.hpp"
+#include "Yimage/WriteImage.hpp"
+#include "Resources.hpp"
+
+TEST_CASE("Write PNG rows")
+{
+    using namespace Yimage;
+    auto image = read_image(THUMB_UP_PNG, THUMB_UP_PNG_SIZE);
+
+    std::stringstream stream;
+    ImageWriter writer(stream, {ImageFormat::PNG, image.width(),
+                                image.height(), image.pixel_type()});
+    const size_t band_height = 7;
+    for (size_t y = 0; y < image.height(); y += band_height)
+    {
+        auto rows = std::min(band_height, image.height() - y);
+        writer.write_rows(image.subimage(0, y, image.width(), rows));
+    }
+    REQUIRE(writer.current_row() == image.height());
+    REQUIRE_THROWS(writer.write_rows(image.subimage(0, 0, image.width(), 1)));
+    writer.close();
+
+    auto str = stream.str();
+    auto result = read_image(str.data(), str.size());
+    REQUIRE(result.view() == image.view());
+}
+
+TEST_CASE("Write image with format from extension")
+{
+    using namespace Yimage;
+    REQUIRE(get_image_format_from_extension("a/b.PNG") == ImageFormat::PNG);
+    REQUIRE(get_image_format_from_extension("b.jpeg") == ImageFormat::JPEG);
+    REQUIRE(get_image_format_from_extension("b.tif") == ImageFormat::TIFF);
+    REQUIRE(get_image_format_from_extension("b") == ImageFormat::UNKNOWN);
+
+    auto image = read_image(THUMB_UP_PNG, THUMB_UP_PNG_SIZE);
+    auto path = std::filesystem::temp_directory_path() / "YimageTest_write_image.png";
+    write_image(path, image.subimage(3, 5, 20, 10));
+    auto result = read_image(path);
+    std::filesystem::remove(path);
+    REQUIRE(result.view() == image.subimage(3, 5, 20, 10));
+
+    std::stringstream stream;
+    REQUIRE_THROWS(write_image(stream, image.view(), ImageFormat::UNKNOWN));
+}
+
+TEST_CASE("Write pipeline with write_image")
+{
+    using namespace Yimage;
+    auto image = read_image(THUMB_UP_PNG, THUMB_UP_PNG_SIZE);
+    Pipeline pipeline(image.view());
+    pipeline.flip_horizontally().band_height(3);
+
+    std::stringstream stream;
+    write_image(stream, pipeline, ImageFormat::PNG);
+
+    auto str = stream.str();
+    auto result = read_image(str.data(), str.size());
+    REQUIRE(result.view() == Pipeline(image.view()).flip_horizontally().to_image().view());
+}
+
+TEST_CASE("Write image with PNG options")
+{
+    using namespace Yimage;
+    auto image = read_image(CITY_JPG, CITY_JPG_SIZE);
+
+    std::stringstream fastest;
+    write_image(fastest, image.view(), ImageFormat::PNG,
+                PngWriteOptions::fastest());
+    std::stringstream uncompressed;
+    write_image(uncompressed, image.view(), ImageFormat::PNG,
+                PngWriteOptions().compression_level(0));
+
+    auto fastest_str = fastest.str();
+    auto uncompressed_str = uncompressed.str();
+    REQUIRE(fastest_str.size() < image.size());
+    REQUIRE(uncompressed_str.size() > image.size());
+    REQUIRE(read_image(fastest_str.data(), fastest_str.size()).view() == image.view());
+    REQUIRE(read_image(uncompressed_str.data(), uncompressed_str.size()).view() == image.view());
+}
+
+TEST_CASE("Write indexed image with write_image")
+{
+    using namespace Yimage;
+    std::vector<unsigned char> png;
+    write_png(png, read_image(CITY_JPG, CITY_JPG_SIZE).view(),
+              PngWriteOptions().quantize(QuantizeOptions().max_colors(16)));
+    auto image = read_image(png.data(), png.size());
+    REQUIRE(image.pixel_type() == PixelType::INDEXED_4);
+    auto& palette = image.metadata()->palette;
+
+    std::stringstream stream;
+    write_image(stream, image.view(), ImageFormat::PNG);
+    auto str = stream.str();
+    auto result = read_image(str.data(), str.size());
+    REQUIRE(result.view() == image.view());
+    REQUIRE(result.metadata()->palette == palette);
+
+    // The palette is passed on from the reader through the pipeline.
+    ImageReader reader(png.data(), png.size());
+    REQUIRE(reader.info().palette == palette);
+    Pipeline pipeline(std::move(reader));
+    pipeline.flip_vertically();
+    std::stringstream pipeline_stream;
+    write_image(pipeline_stream, pipeline, ImageFormat::PNG);
+    str = pipeline_stream.str();
+    result = read_image(str.data(), str.size());
+    REQUIRE(result.metadata()->palette == palette);
+    REQUIRE(result.view() == Pipeline(image.view()).flip_vertically().to_image().view());
+
+    for (bool interlaced : {false, true})
+    {
+        Pipeline view_pipeline(image.view());
+        std::stringstream png_stream;
+        write_png(png_stream, view_pipeline, PngWriteOptions().interlaced(interlaced));
+        str = png_stream.str();
+        result = read_image(str.data(), str.size());
+        REQUIRE(result.view() == image.view());
+        REQUIRE(result.metadata()->palette == palette);
+    }
+}
@@ -0,0 +1,186 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-19.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "Yimage/Pipeline.hpp"
+#include <algorithm>
+#include <array>
+#include <sstream>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include "Yimage/Png/ReadPng.hpp"
+#include "Yimage/Png/WritePng.hpp"
+
+namespace
+{
+    // A source that isn't in memory, row n has the value n in every pixel.
+    class CounterStage : public Yimage::PipelineStage
+    {
+    public:
+        CounterStage(size_t width, size_t height)
+            : width_(width), height_(height)
+        {}
+
+        [[nodiscard]]
+        size_t width() const override
+        {
+            return width_;
+        }
+
+        [[nodiscard]]
+        size_t height() const override
+        {
+            return height_;
+        }
+
+        [[nodiscard]]
+        Yimage::PixelType pixel_type() const override
+        {
+            return Yimage::PixelType::MONO_8;
+        }
+
+        void read_rows(const Yimage::MutableImageView& band) override
+        {
+            for (size_t i = 0; i < band.height(); ++i)
+            {
+                auto [b, e] = band.row(i);
+                std::fill(b, e, uint8_t(row_++));
+            }
+        }
+    private:
+        size_t width_;
+        size_t height_;
+        size_t row_ = 0;
+    };
+}
+
+TEST_CASE("Test pipeline with crop and flip_horizontally")
+{
+    using namespace Yimage;
+    std::vector<uint8_t> buffer{
+        1, 2, 3, 4,
+        5, 6, 7, 8,
+        9, 10, 11, 12
+    };
+    ImageView image(buffer.data(), PixelType::MONO_8, 4, 3);
+
+    auto result = Pipeline(image)
+        .crop(1, 1, 10, 2)
+        .flip_horizontally()
+        .to_image();
+
+    std::vector<uint8_t> expected{
+        8, 7, 6,
+        12, 11, 10
+    };
+    REQUIRE(result.view() == ImageView(expected.data(), PixelType::MONO_8, 3, 2));
+}
+
+TEST_CASE("Test pipeline with a streaming source")
+{
+    using namespace Yimage;
+    Pipeline pipeline(std::make_unique<CounterStage>(3, 20));
+    pipeline.crop(0, 2, 3, 15).flip_vertically().band_height(4);
+
+    std::vector<size_t> band_heights;
+    std::vector<uint8_t> first_column;
+    pipeline.run([&](const ImageView& band)
+                 {
+                     band_heights.push_back(band.height());
+                     for (size_t y = 0; y < band.height(); ++y)
+                         first_column.push_back(*band.pixel_pointer(0, y));
+                 });
+
+    REQUIRE(band_heights == std::vector<size_t>{4, 4, 4, 3});
+    REQUIRE(first_column.front() == 16);
+    REQUIRE(first_column.back() == 2);
+    REQUIRE_THROWS(pipeline.to_image());
+}
+
+TEST_CASE("Test pipeline with convert and apply_lut")
+{
+    using namespace Yimage;
+    std::vector<uint8_t> buffer{
+        10, 20, 30, 40,
+        50, 60, 70, 80
+    };
+    ImageView image(buffer.data(), PixelType::RGBA_8, 2, 1);
+
+    std::array<uint8_t, 256> lut = {};
+    for (size_t i = 0; i < lut.size(); ++i)
+        lut[i] = uint8_t(255 - i);
+
+    auto result = Pipeline(image)
+        .apply_lut(lut)
+        .convert(PixelType::RGB_8)
+        .to_image();
+
+    std::vector<uint8_t> expected{245, 235, 225, 205, 195, 185};
+    REQUIRE(result.view() == ImageView(expected.data(), PixelType::RGB_8, 2, 1));
+
+    REQUIRE_THROWS(Pipeline(image).convert(PixelType::MONO_1));
+}
+
+TEST_CASE("Test pipeline resize")
+{
+    using namespace Yimage;
+    std::vector<uint8_t> buffer{
+        0, 2, 10, 20,
+        4, 6, 30, 40,
+        100, 100, 200, 200,
+        100, 100, 200, 200
+    };
+    ImageView image(buffer.data(), PixelType::MONO_8, 4, 4);
+
+    SECTION("Downscale")
+    {
+        auto result = Pipeline(image).resize(2, 2).to_image();
+        std::vector<uint8_t> expected{3, 25, 100, 200};
+        REQUIRE(result.view() == ImageView(expected.data(), PixelType::MONO_8, 2, 2));
+    }
+
+    SECTION("Upscale")
+    {
+        auto result = Pipeline(image.subimage(0, 0, 2, 1))
+            .resize(4, 1)
+            .to_image();
+        std::vector<uint8_t> expected{0, 1, 2, 2};
+        REQUIRE(result.view() == ImageView(expected.data(), PixelType::MONO_8, 4, 1));
+    }
+
+    SECTION("Streaming source")
+    {
+        auto result = Pipeline(std::make_unique<CounterStage>(4, 8))
+            .resize(2, 4)
+            .to_image();
+        REQUIRE(*result.pixel_pointer(0, 0) == 1);
+        REQUIRE(*result.pixel_pointer(1, 3) == 7);
+    }
+}
+
+TEST_CASE("Test write_png with pipeline")
+{
+    using namespace Yimage;
+    std::vector<uint8_t> buffer{
+        1, 2, 3, 4,
+        5, 6, 7, 8,
+        9, 10, 11, 12
+    };
+    ImageView image(buffer.data(), PixelType::MONO_8, 4, 3);
+
+    Pipeline pipeline(image);
+    pipeline.flip_vertically().band_height(1);
+    std::stringstream stream;
+    write_png(stream, pipeline);
+
+    auto result = read_png(stream);
+    std::vector<uint8_t> expected{
+        9, 10, 11, 12,
+        5, 6, 7, 8,
+        1, 2, 3, 4
+    };
+    REQUIRE(result.view() == ImageView(expected.data(), PixelType::MONO_8, 4, 3));
+}
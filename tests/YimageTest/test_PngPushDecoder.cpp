@@ -0,0 +1,142 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-19.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "Yimage/Png/PngPushDecoder.hpp"
+#include <set>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include "Yimage/ImageSink.hpp"
+#include "Yimage/Png/PngWriter.hpp"
+#include "Yimage/Png/WritePng.hpp"
+#include "Yimage/ReadImage.hpp"
+#include "Yimage/YimageException.hpp"
+#include "Resources.hpp"
+
+namespace
+{
+    std::vector<unsigned char> write_png(const Yimage::Image& image, bool interlaced)
+    {
+        using namespace Yimage;
+        PngMetadata metadata;
+        metadata.width = uint32_t(image.width());
+        metadata.height = uint32_t(image.height());
+        metadata.color_type = PNG_COLOR_TYPE_RGB;
+        if (interlaced)
+            metadata.interlace_type = PNG_INTERLACE_ADAM7;
+
+        std::vector<unsigned char> buffer;
+        VectorSink sink(buffer);
+        PngWriter writer(sink, metadata, {});
+        writer.write_info();
+        writer.write(image.data(), image.size());
+        writer.write_end();
+        return buffer;
+    }
+
+    void push_in_chunks(Yimage::PngPushDecoder& decoder,
+                        const std::vector<unsigned char>& buffer,
+                        size_t chunk_size)
+    {
+        for (size_t i = 0; i < buffer.size(); i += chunk_size)
+            decoder.push(buffer.data() + i, std::min(chunk_size, buffer.size() - i));
+    }
+}
+
+TEST_CASE("Push PNG data in chunks")
+{
+    using namespace Yimage;
+    auto image = read_image(CITY_JPG, CITY_JPG_SIZE);
+    auto buffer = write_png(image, false);
+
+    for (size_t chunk_size : {1, 7, 1000, 100000})
+    {
+        PngPushDecoder decoder;
+        size_t rows = 0;
+        decoder.on_info([&](const ImageInfo& info)
+                        {
+                            REQUIRE(rows == 0);
+                            REQUIRE(info.width == image.width());
+                            REQUIRE(info.pixel_type == PixelType::RGB_8);
+                        })
+            .on_row([&](size_t y, int pass, const ImageView& row)
+                    {
+                        REQUIRE(y == rows++);
+                        REQUIRE(pass == 0);
+                        REQUIRE(row == image.view().subimage(0, y, image.width(), 1));
+                    });
+        push_in_chunks(decoder, buffer, chunk_size);
+        REQUIRE(decoder.is_finished());
+        REQUIRE(rows == image.height());
+        REQUIRE(decoder.image().view() == image.view());
+    }
+}
+
+TEST_CASE("Rows are decoded before all data has arrived")
+{
+    using namespace Yimage;
+    auto image = read_image(CITY_JPG, CITY_JPG_SIZE);
+    auto buffer = write_png(image, false);
+
+    PngPushDecoder decoder;
+    decoder.keep_image(false);
+    size_t rows = 0;
+    decoder.on_row([&](size_t, int, const ImageView&) {++rows;});
+    decoder.push(buffer.data(), buffer.size() / 2);
+    REQUIRE(decoder.info().height == image.height());
+    REQUIRE(rows > 0);
+    REQUIRE(rows < image.height());
+    REQUIRE(!decoder.is_finished());
+
+    decoder.push(buffer.data() + buffer.size() / 2,
+                 buffer.size() - buffer.size() / 2);
+    REQUIRE(decoder.is_finished());
+    REQUIRE(rows == image.height());
+    REQUIRE(!decoder.image());
+}
+
+TEST_CASE("Push interlaced PNG data")
+{
+    using namespace Yimage;
+    auto image = read_image(CITY_JPG, CITY_JPG_SIZE);
+    auto buffer = write_png(image, true);
+
+    PngPushDecoder decoder;
+    decoder.keep_image(false);
+    std::set<int> passes;
+    decoder.on_row([&](size_t, int pass, const ImageView&) {passes.insert(pass);});
+    push_in_chunks(decoder, buffer, 333);
+    REQUIRE(decoder.is_finished());
+    REQUIRE(passes.size() == 7);
+    REQUIRE(decoder.image().view() == image.view());
+}
+
+TEST_CASE("Errors from PngPushDecoder")
+{
+    using namespace Yimage;
+    auto buffer = write_png(read_image(CITY_JPG, CITY_JPG_SIZE), false);
+
+    SECTION("Corrupt data")
+    {
+        buffer[40] ^= 0xFF;
+        PngPushDecoder decoder;
+        REQUIRE_THROWS_AS(decoder.push(buffer.data(), buffer.size()),
+                          YimageException);
+        REQUIRE_THROWS(decoder.push(buffer.data(), buffer.size()));
+    }
+
+    SECTION("Exception in callback")
+    {
+        PngPushDecoder decoder;
+        decoder.on_row([](size_t y, int, const ImageView&)
+                       {
+                           if (y == 5)
+                               throw std::runtime_error("Stop");
+                       });
+        REQUIRE_THROWS_AS(decoder.push(buffer.data(), buffer.size()),
+                          std::runtime_error);
+    }
+}
@@ -0,0 +1,47 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-19.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "Yimage/ProbeImage.hpp"
+#include <fstream>
+#include <catch2/catch_test_macros.hpp>
+#include "Yimage/ReadImage.hpp"
+#include "Resources.hpp"
+
+namespace
+{
+    void test_probe(const void* buffer, size_t size, Yimage::ImageFormat format)
+    {
+        CAPTURE(int(format));
+        auto image = Yimage::read_image(buffer, size);
+        Yimage::ImageInfo expected{format, image.width(), image.height(),
+                                   image.pixel_type()};
+        REQUIRE(Yimage::probe_image(buffer, size) == expected);
+
+        auto path = std::filesystem::temp_directory_path()
+                    / "YimageTest_probe_image";
+        std::ofstream(path, std::ios::binary)
+            .write(static_cast<const char*>(buffer), std::streamsize(size));
+        auto info = Yimage::probe_image(path);
+        std::filesystem::remove(path);
+        REQUIRE(info == expected);
+    }
+}
+
+TEST_CASE("Probe images")
+{
+    using Yimage::ImageFormat;
+    test_probe(THUMB_UP_PNG, THUMB_UP_PNG_SIZE, ImageFormat::PNG);
+    test_probe(CITY_JPG, CITY_JPG_SIZE, ImageFormat::JPEG);
+    test_probe(GEOID_TIF, GEOID_TIF_SIZE, ImageFormat::TIFF);
+}
+
+TEST_CASE("Probe truncated image")
+{
+    REQUIRE_THROWS(Yimage::probe_image(THUMB_UP_PNG, 20));
+    REQUIRE_THROWS(Yimage::probe_image(CITY_JPG, 12));
+    REQUIRE_THROWS(Yimage::probe_image("Not an image", 12));
+}
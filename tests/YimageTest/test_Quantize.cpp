@@ -0,0 +1,177 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-19.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "Yimage/Quantize.hpp"
+#include <sstream>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include "Yimage/ImageAlgorithms.hpp"
+#include "Yimage/ImageWriter.hpp"
+#include "Yimage/Pipeline.hpp"
+#include "Yimage/Png/WritePng.hpp"
+#include "Yimage/ReadImage.hpp"
+#include "Yimage/WriteImage.hpp"
+#include "Yimage/YimageException.hpp"
+#include "Resources.hpp"
+
+namespace
+{
+    int get_mean_error(const Yimage::ImageView& a, const Yimage::ImageView& b)
+    {
+        uint64_t sum = 0;
+        for (size_t y = 0; y < a.height(); ++y)
+        {
+            for (size_t x = 0; x < a.width(); ++x)
+            {
+                auto ca = get_rgba8(a, x, y);
+                auto cb = get_rgba8(b, x, y);
+                sum += std::abs(ca.r - cb.r) + std::abs(ca.g - cb.g)
+                       + std::abs(ca.b - cb.b) + std::abs(ca.a - cb.a);
+            }
+        }
+        return int(sum / (a.width() * a.height()));
+    }
+}
+
+TEST_CASE("Quantize image with few colors")
+{
+    using namespace Yimage;
+    Image image(PixelType::RGBA_8, 64, 32);
+    const Rgba8 colors[] = {Color::Red, Color::Green, Color::Transparent};
+    fill_rgba8(image.mutable_view(), colors, 3);
+
+    auto palette = make_palette(image.view());
+    REQUIRE(palette == std::vector<Rgba8>{Color::Transparent, Color::Green,
+                                          Color::Red});
+
+    auto quantized = quantize(image.view(), QuantizeOptions()
+        .dither(DitherMethod::ORDERED));
+    REQUIRE(quantized.pixel_type() == PixelType::INDEXED_2);
+    REQUIRE(quantized.metadata()->palette == palette);
+    REQUIRE(expand_palette(quantized.view()).view() == image.view());
+}
+
+TEST_CASE("Quantize photo")
+{
+    using namespace Yimage;
+    auto image = read_image(CITY_JPG, CITY_JPG_SIZE);
+    const DitherMethod methods[] = {DitherMethod::NONE,
+                                    DitherMethod::ORDERED,
+                                    DitherMethod::FLOYD_STEINBERG};
+    const ExecutionContext contexts[] = {
+        ExecutionContext().parallelism(ParallelismHint::SEQUENTIAL),
+        ExecutionContext().thread_count(4).parallelism(ParallelismHint::MAXIMUM)
+    };
+
+    for (auto method : methods)
+    {
+        for (auto& context : contexts)
+        {
+            auto options = QuantizeOptions().max_colors(64).dither(method);
+            auto quantized = quantize(image.view(), options, context);
+            CAPTURE(int(method), context.max_threads());
+            REQUIRE(quantized.pixel_type() == PixelType::INDEXED_8);
+            REQUIRE(quantized.metadata()->palette.size() <= 64);
+            auto expanded = expand_palette(quantized.view(), PixelType::RGB_8);
+            REQUIRE(get_mean_error(expanded.view(), image.view()) < 10);
+        }
+    }
+
+    auto sequential = make_palette(image.view(), 16, contexts[0]);
+    auto parallel = make_palette(image.view(), 16, contexts[1]);
+    REQUIRE(sequential.size() == 16);
+    REQUIRE(sequential == parallel);
+}
+
+TEST_CASE("Remap to palette")
+{
+    using namespace Yimage;
+    Image image(PixelType::RGB_8, 8, 1);
+    fill_rgba8(image.mutable_view(), Rgba8(200, 10, 10));
+    const std::vector<Rgba8> palette{Color::Black, Color::Red};
+
+    Image indexed(PixelType::INDEXED_1, 8, 1);
+    remap_to_palette(image.view(), palette, indexed.mutable_view());
+    REQUIRE(indexed.data()[0] == 0xFF);
+
+    Image too_small(PixelType::INDEXED_1, 8, 1);
+    const std::vector<Rgba8> large_palette(3);
+    REQUIRE_THROWS(remap_to_palette(image.view(), large_palette,
+                                    too_small.mutable_view()));
+}
+
+TEST_CASE("Write quantized PNG")
+{
+    using namespace Yimage;
+    Image image(PixelType::RGBA_8, 256, 256);
+    const Rgba8 colors[] = {Color::Red, Color::Green, Color::Blue,
+                            Color::Transparent, Color::White};
+    fill_rgba8(image.mutable_view(), colors, 5);
+
+    std::vector<unsigned char> truecolor;
+    VectorSink truecolor_sink(truecolor);
+    write_png(truecolor_sink, image.view());
+
+    std::vector<unsigned char> indexed;
+    VectorSink indexed_sink(indexed);
+    write_png(indexed_sink, image.view(),
+              PngWriteOptions().quantize(QuantizeOptions()));
+
+    REQUIRE(indexed.size() < truecolor.size());
+    auto result = read_image(indexed.data(), indexed.size());
+    REQUIRE(result.pixel_type() == PixelType::INDEXED_4);
+    REQUIRE(expand_palette(result.view()).view() == image.view());
+}
+
+TEST_CASE("Quantize with write_image and pipelines")
+{
+    using namespace Yimage;
+    Image image(PixelType::RGBA_8, 256, 256);
+    const Rgba8 colors[] = {Color::Red, Color::Green, Color::Blue,
+                            Color::Transparent, Color::White};
+    fill_rgba8(image.mutable_view(), colors, 5);
+    auto options = PngWriteOptions().quantize(QuantizeOptions());
+
+    std::vector<std::string> outputs;
+    {
+        std::stringstream stream;
+        write_image(stream, image.view(), ImageFormat::PNG, options);
+        outputs.push_back(stream.str());
+    }
+    {
+        Pipeline pipeline(image.view());
+        std::stringstream stream;
+        write_image(stream, pipeline, ImageFormat::PNG, options);
+        outputs.push_back(stream.str());
+    }
+    {
+        Pipeline pipeline(image.view());
+        std::stringstream stream;
+        write_png(stream, pipeline, options);
+        outputs.push_back(stream.str());
+    }
+
+    for (auto& output : outputs)
+    {
+        auto result = read_image(output.data(), output.size());
+        REQUIRE(result.pixel_type() == PixelType::INDEXED_4);
+        REQUIRE(expand_palette(result.view()).view() == image.view());
+    }
+
+    // The rows are written as they are received by these.
+    std::stringstream stream;
+    REQUIRE_THROWS_AS(ImageWriter(stream, {ImageFormat::PNG, image.width(),
+                                           image.height(), image.pixel_type()},
+                                  options),
+                      YimageException);
+    PngMetadata metadata;
+    metadata.width = uint32_t(image.width());
+    metadata.height = uint32_t(image.height());
+    REQUIRE_THROWS_AS(write_png(stream, image.data(), image.size(),
+                                metadata, {}, options),
+                      YimageException);
+}
@@ -6,6 +6,10 @@
 // License text is included with the source distribution.
 //****************************************************************************
 #include "Yimage/ReadImage.hpp"
+#include "Yimage/Jpeg/ReadJpeg.hpp"
+#include <fstream>
+#include <string>
+#include <vector>
 #include <catch2/catch_test_macros.hpp>
 #include "Resources.hpp"
 
@@ -31,3 +35,101 @@ TEST_CASE("Read TIFF")
     REQUIRE(bool(image));
     REQUIRE(image.pixel_type() == Yimage::PixelType::MONO_FLOAT_32);
 }
+
+TEST_CASE("Read scaled JPEG")
+{
+    using namespace Yimage;
+    REQUIRE(get_jpeg_scale(150, 150, 0, 0) == std::pair(1u, 8u));
+    REQUIRE(get_jpeg_scale(150, 150, 19, 19) == std::pair(1u, 8u));
+    REQUIRE(get_jpeg_scale(150, 150, 20, 19) == std::pair(1u, 4u));
+    REQUIRE(get_jpeg_scale(150, 150, 40, 1) == std::pair(3u, 8u));
+    REQUIRE(get_jpeg_scale(150, 150, 150, 150) == std::pair(1u, 1u));
+    REQUIRE(get_jpeg_scale(150, 150, 300, 300) == std::pair(1u, 1u));
+
+    for (unsigned denom : {1u, 2u, 4u, 8u})
+    {
+        auto options = JpegReadOptions().scale_denom(denom);
+        auto image = read_jpeg(CITY_JPG, CITY_JPG_SIZE, options);
+        auto size = (150 + denom - 1) / denom;
+        REQUIRE(image.width() == size);
+        REQUIRE(image.height() == size);
+
+        Image dst(image.pixel_type(), size + 2, size);
+        read_jpeg_into(CITY_JPG, CITY_JPG_SIZE,
+                       dst.mutable_view().subimage(1, 0, size, size),
+                       options);
+        REQUIRE(dst.view().subimage(1, 0, size, size) == image.view());
+    }
+
+    auto image = read_image(CITY_JPG, CITY_JPG_SIZE,
+                            ImageReadOptions().min_size(40, 40));
+    REQUIRE(image.width() == 57);
+    REQUIRE(image.height() == 57);
+
+    image = read_image(THUMB_UP_PNG, THUMB_UP_PNG_SIZE,
+                       ImageReadOptions().min_size(8, 8));
+    REQUIRE(image.width() == 32);
+}
+
+namespace
+{
+    std::filesystem::path write_temp_file(const std::string& name,
+                                          const void* data, size_t size)
+    {
+        auto path = std::filesystem::temp_directory_path() / name;
+        std::ofstream file(path, std::ios::binary);
+        file.write(static_cast<const char*>(data), std::streamsize(size));
+        return path;
+    }
+}
+
+TEST_CASE("Read images from files")
+{
+    using namespace Yimage;
+    struct File
+    {
+        std::string name;
+        const void* data;
+        size_t size;
+    };
+    std::vector<File> files{
+        {"YimageTest_thumb_up.png", THUMB_UP_PNG, THUMB_UP_PNG_SIZE},
+        {"YimageTest_city.jpg", CITY_JPG, CITY_JPG_SIZE},
+        {"YimageTest_geoid.tif", GEOID_TIF, GEOID_TIF_SIZE}
+    };
+
+    for (auto& [name, data, size] : files)
+    {
+        auto path = write_temp_file(name, data, size);
+        auto image = read_image(path);
+        std::filesystem::remove(path);
+
+        REQUIRE(image.view() == read_image(data, size).view());
+        REQUIRE(image.metadata()->path == path);
+    }
+}
+
+TEST_CASE("Read images into subimages")
+{
+    using namespace Yimage;
+    std::vector<std::pair<const void*, size_t>> files{
+        {THUMB_UP_PNG, THUMB_UP_PNG_SIZE},
+        {CITY_JPG, CITY_JPG_SIZE},
+        {GEOID_TIF, GEOID_TIF_SIZE}
+    };
+
+    for (auto [data, size] : files)
+    {
+        auto expected = read_image(data, size);
+        Image atlas(expected.pixel_type(),
+                    expected.width() + 3, expected.height() + 2);
+        auto dst = atlas.mutable_subimage(2, 1,
+                                          expected.width(),
+                                          expected.height());
+        read_image_into(data, size, dst);
+        REQUIRE(ImageView(dst) == expected.view());
+
+        Image too_small(expected.pixel_type(), 1, 1);
+        REQUIRE_THROWS(read_image_into(data, size, too_small.mutable_view()));
+    }
+}
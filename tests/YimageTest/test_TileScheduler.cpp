@@ -0,0 +1,145 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-19.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "Yimage/ImageAlgorithms.hpp"
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include "Yimage/YimageException.hpp"
+
+TEST_CASE("Test make_tiles")
+{
+    using namespace Yimage;
+    SECTION("full rows")
+    {
+        auto tiles = make_tiles(100, 25, 8, 1000);
+        REQUIRE(tiles.size() == 3);
+        REQUIRE(tiles[0] == ImageRegion{0, 0, 100, 10});
+        REQUIRE(tiles[2] == ImageRegion{0, 20, 100, 5});
+    }
+    SECTION("partial rows")
+    {
+        auto tiles = make_tiles(100, 10, 32, 1024);
+        REQUIRE(tiles.size() == 8);
+        REQUIRE(tiles[0] == ImageRegion{0, 0, 32, 8});
+        REQUIRE(tiles[3] == ImageRegion{96, 0, 4, 8});
+        REQUIRE(tiles[5] == ImageRegion{32, 8, 32, 2});
+    }
+    SECTION("empty image")
+    {
+        REQUIRE(make_tiles(0, 10, 8).empty());
+    }
+}
+
+TEST_CASE("Test for_each_tile visits every pixel once")
+{
+    using namespace Yimage;
+    std::vector<uint8_t> buffer(301 * 97);
+    MutableImageView image(buffer.data(), PixelType::MONO_8, 300, 97, 1);
+    std::atomic<size_t> count = 0;
+    for_each_tile(image,
+                  [&](const MutableImageView& tile)
+                  {
+                      for (size_t y = 0; y < tile.height(); ++y)
+                      {
+                          auto [beg, end] = tile.row(y);
+                          for (auto it = beg; it != end; ++it)
+                              ++*it;
+                          count += tile.width();
+                      }
+                  },
+                  ExecutionContext().thread_count(4).grain_size(256));
+    REQUIRE(count == 300 * 97);
+    for (size_t y = 0; y < 97; ++y)
+    {
+        REQUIRE(buffer[y * 301] == 1);
+        REQUIRE(buffer[y * 301 + 299] == 1);
+        REQUIRE(buffer[y * 301 + 300] == 0);
+    }
+}
+
+TEST_CASE("Test parallel algorithms match sequential results")
+{
+    using namespace Yimage;
+    constexpr size_t W = 123, H = 77;
+    std::vector<uint8_t> src(W * H * 3);
+    std::iota(src.begin(), src.end(), uint8_t(0));
+    ImageView src_img(src.data(), PixelType::RGB_8, W, H);
+
+    std::vector<uint8_t> seq(W * H * 3), par(W * H * 3);
+    MutableImageView seq_img(seq.data(), PixelType::RGB_8, W, H);
+    MutableImageView par_img(par.data(), PixelType::RGB_8, W, H);
+    auto parallel = ExecutionContext().thread_count(4).grain_size(100);
+
+    SECTION("fill_rgba8")
+    {
+        std::vector<Rgba8> colors{Color::Red, Color::Green, Color::Blue,
+                                  Color::White, Color::Yellow};
+        fill_rgba8(seq_img, colors.data(), colors.size(), ExecutionContext().thread_count(1));
+        fill_rgba8(par_img, colors.data(), colors.size(), parallel);
+        REQUIRE(seq == par);
+    }
+    SECTION("paste")
+    {
+        paste(src_img, seq_img, 7, -3, ExecutionContext().thread_count(1));
+        paste(src_img, par_img, 7, -3, parallel);
+        REQUIRE(seq == par);
+    }
+    SECTION("flip_vertically")
+    {
+        paste(src_img, seq_img);
+        paste(src_img, par_img);
+        flip_vertically(seq_img, ExecutionContext().thread_count(1));
+        flip_vertically(par_img, parallel);
+        REQUIRE(seq == par);
+        REQUIRE(std::equal(src.begin(), src.begin() + W * 3,
+                           par.end() - W * 3));
+    }
+}
+
+TEST_CASE("Test for_each_tile with executor")
+{
+    using namespace Yimage;
+    std::atomic<size_t> tasks = 0;
+    auto context = ExecutionContext()
+        .thread_count(3)
+        .grain_size(100)
+        .executor([&](std::function<void()> task)
+        {
+            ++tasks;
+            task();
+        });
+
+    std::vector<uint8_t> buffer(100 * 100);
+    MutableImageView image(buffer.data(), PixelType::MONO_8, 100, 100);
+    fill_rgba8(image, Color::White, context);
+    REQUIRE(tasks == 2);
+    REQUIRE(std::all_of(buffer.begin(), buffer.end(),
+                        [](auto v) {return v == 0xFF;}));
+
+    tasks = 0;
+    fill_rgba8(image, Color::Black,
+               context.parallelism(ParallelismHint::SEQUENTIAL));
+    REQUIRE(tasks == 0);
+    REQUIRE(buffer[9999] == 0);
+}
+
+TEST_CASE("Test run_parallel rethrows exceptions")
+{
+    using namespace Yimage;
+    auto context = ExecutionContext().thread_count(2);
+    REQUIRE_THROWS_AS(run_parallel(10,
+                                   [](size_t i)
+                                   {
+                                       if (i == 7)
+                                           throw YimageException("7");
+                                   },
+                                   context),
+                      YimageException);
+}
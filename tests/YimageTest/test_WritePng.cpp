@@ -0,0 +1,454 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-19.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "Yimage/Png/WritePng.hpp"
+#include <memory_resource>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include "Yimage/ImageReader.hpp"
+#include "Yimage/Pipeline.hpp"
+#include "Yimage/Png/ReadPng.hpp"
+#include "Yimage/ProbeImage.hpp"
+#include "Yimage/ReadImage.hpp"
+#include "Yimage/YimageException.hpp"
+#include "Resources.hpp"
+
+namespace
+{
+    std::vector<unsigned char> write(const Yimage::ImageView& image,
+                                     const Yimage::PngWriteOptions& options)
+    {
+        std::vector<unsigned char> buffer;
+        Yimage::VectorSink sink(buffer);
+        write_png(sink, image, options);
+        return buffer;
+    }
+
+    /**
+     * @brief A sink that throws when more than @a capacity bytes are
+     *      written, and optionally when it is flushed.
+     */
+    class FailingSink : public Yimage::ImageSink
+    {
+    public:
+        FailingSink(size_t capacity, bool fail_flush)
+            : capacity_(capacity),
+              fail_flush_(fail_flush)
+        {}
+
+        void write(const void*, size_t size) override
+        {
+            if (size > capacity_ - size_)
+                throw std::runtime_error("The sink is full.");
+            size_ += size;
+        }
+
+        void flush() override
+        {
+            if (fail_flush_)
+                throw std::runtime_error("Can not flush the sink.");
+        }
+    private:
+        size_t capacity_;
+        size_t size_ = 0;
+        bool fail_flush_;
+    };
+}
+
+TEST_CASE("Write PNG with presets")
+{
+    using namespace Yimage;
+    auto image = read_image(CITY_JPG, CITY_JPG_SIZE);
+
+    auto fastest = write(image.view(), PngWriteOptions::fastest());
+    auto balanced = write(image.view(), PngWriteOptions::balanced());
+    auto smallest = write(image.view(), PngWriteOptions::smallest());
+
+    REQUIRE(read_image(fastest.data(), fastest.size()).view() == image.view());
+    REQUIRE(read_image(balanced.data(), balanced.size()).view() == image.view());
+    REQUIRE(read_image(smallest.data(), smallest.size()).view() == image.view());
+    REQUIRE(smallest.size() <= balanced.size());
+    REQUIRE(balanced.size() < fastest.size());
+}
+
+TEST_CASE("Write PNG without compression")
+{
+    using namespace Yimage;
+    auto image = read_image(CITY_JPG, CITY_JPG_SIZE);
+    auto options = PngWriteOptions()
+        .compression_level(0)
+        .filters(PNG_FILTER_NONE)
+        .buffer_size(1024);
+    auto buffer = write(image.view(), options);
+    REQUIRE(buffer.size() > image.size());
+    REQUIRE(read_image(buffer.data(), buffer.size()).view() == image.view());
+}
+
+namespace
+{
+    Yimage::Image make_image(Yimage::PixelType pixel_type,
+                             size_t width, size_t height)
+    {
+        Yimage::Image image(pixel_type, width, height);
+        for (size_t y = 0; y < height; ++y)
+        {
+            auto [b, e] = image.mutable_view().row(y);
+            for (auto it = b; it != e; ++it)
+                *it = uint8_t((it - b) / 3 + y * y / 7 + (it - b) % 5);
+        }
+        return image;
+    }
+}
+
+TEST_CASE("Write PNG to memory")
+{
+    using namespace Yimage;
+    auto image = read_image(CITY_JPG, CITY_JPG_SIZE);
+
+    std::vector<unsigned char> buffer{1, 2, 3};
+    write_png(buffer, image.view());
+    REQUIRE(buffer.size() > 3);
+    REQUIRE(buffer[2] == 3);
+    REQUIRE(read_image(buffer.data() + 3, buffer.size() - 3).view()
+            == image.view());
+
+    std::vector<std::byte> memory(1024 * 1024);
+    std::pmr::monotonic_buffer_resource arena(memory.data(), memory.size(),
+                                              std::pmr::null_memory_resource());
+    ArenaSink sink(&arena);
+    write_png(sink, image.view());
+    auto result = sink.release();
+    REQUIRE(sink.data().empty());
+    // The bytes are still where the sink wrote them, in the arena.
+    auto address = reinterpret_cast<const std::byte*>(result.data());
+    REQUIRE(address >= memory.data());
+    REQUIRE(address + result.size() <= memory.data() + memory.size());
+    REQUIRE(read_image(result.data(), result.size()).view() == image.view());
+}
+
+TEST_CASE("Write PNG in parallel")
+{
+    using namespace Yimage;
+    auto context = ExecutionContext()
+        .thread_count(4)
+        .parallelism(ParallelismHint::MAXIMUM);
+
+    const PixelType pixel_types[] = {
+        PixelType::MONO_1, PixelType::MONO_8, PixelType::RGB_8,
+        PixelType::RGBA_8, PixelType::RGBA_16
+    };
+    const PngWriteOptions all_options[] = {
+        PngWriteOptions(),
+        PngWriteOptions::fastest(),
+        PngWriteOptions::smallest(),
+        PngWriteOptions().compression_level(0),
+        PngWriteOptions().window_bits(9).filters(PNG_FILTER_UP | PNG_FILTER_PAETH)
+    };
+
+    for (auto pixel_type : pixel_types)
+    {
+        auto image = make_image(pixel_type, 304, 400);
+        for (auto& options : all_options)
+        {
+            std::vector<unsigned char> parallel;
+            VectorSink parallel_sink(parallel);
+            write_png(parallel_sink, image.view(), options, context);
+
+            // Pipelines are always written with libpng and zlib, also
+            // when images are written with libdeflate.
+            std::vector<unsigned char> sequential;
+            VectorSink sequential_sink(sequential);
+            Pipeline pipeline(image.view());
+            write_png(sequential_sink, pipeline, options);
+
+            CAPTURE(int(pixel_type), options.compression_level().value_or(-1));
+            REQUIRE(parallel != sequential);
+            REQUIRE(read_image(parallel.data(), parallel.size()).view() == image.view());
+            REQUIRE(parallel.size() < sequential.size() + sequential.size() / 10 + 1024);
+        }
+    }
+}
+
+TEST_CASE("Write PNG from a subimage")
+{
+    using namespace Yimage;
+    auto image = read_image(CITY_JPG, CITY_JPG_SIZE);
+    auto subimage = image.view().subimage(13, 21, 100, 80);
+    REQUIRE(!subimage.is_contiguous());
+
+    auto buffer = write(subimage, {});
+    REQUIRE(read_image(buffer.data(), buffer.size()).view() == subimage);
+}
+
+TEST_CASE("Write and read indexed PNG")
+{
+    using namespace Yimage;
+    const PixelType pixel_types[] = {
+        PixelType::INDEXED_1, PixelType::INDEXED_2,
+        PixelType::INDEXED_4, PixelType::INDEXED_8
+    };
+    const ExecutionContext contexts[] = {
+        ExecutionContext().parallelism(ParallelismHint::SEQUENTIAL),
+        ExecutionContext().thread_count(4).parallelism(ParallelismHint::MAXIMUM)
+    };
+
+    for (auto pixel_type : pixel_types)
+    {
+        auto image = make_image(pixel_type, 304, 400);
+        auto metadata = std::make_unique<ImageMetadata>();
+        for (size_t i = 0; i < (size_t(1) << get_pixel_size(pixel_type)); ++i)
+        {
+            metadata->palette.push_back({uint8_t(i), uint8_t(255 - i), 7,
+                                         uint8_t(i < 2 ? i : 255)});
+        }
+        image.set_metadata(std::move(metadata));
+
+        for (auto& context : contexts)
+        {
+            std::vector<unsigned char> buffer;
+            VectorSink sink(buffer);
+            write_png(sink, image.view(), {}, context);
+
+            CAPTURE(int(pixel_type), context.max_threads());
+            REQUIRE(probe_image(buffer.data(), buffer.size())
+                    == ImageInfo{ImageFormat::PNG, 304, 400, pixel_type});
+            auto result = read_image(buffer.data(), buffer.size());
+            REQUIRE(result.view() == image.view());
+            REQUIRE(result.metadata()->palette == image.metadata()->palette);
+        }
+    }
+}
+
+TEST_CASE("Read indexed PNG with rows that don't end on a byte boundary")
+{
+    using namespace Yimage;
+    constexpr size_t WIDTH = 5, HEIGHT = 3;
+    for (int bit_depth : {1, 2, 4})
+    {
+        for (auto interlace_type : {PNG_INTERLACE_NONE, PNG_INTERLACE_ADAM7})
+        {
+            PngMetadata metadata;
+            metadata.width = WIDTH;
+            metadata.height = HEIGHT;
+            metadata.bit_depth = bit_depth;
+            metadata.color_type = PNG_COLOR_TYPE_PALETTE;
+            metadata.interlace_type = interlace_type;
+            const auto colors = size_t(1) << bit_depth;
+            for (size_t i = 0; i < colors; ++i)
+                metadata.palette.push_back({uint8_t(i), 0, uint8_t(255 - i), 255});
+
+            // The packed indexes, and the indexes as they are read.
+            const auto row_size = (WIDTH * bit_depth + 7) / 8;
+            std::vector<uint8_t> packed(row_size * HEIGHT);
+            Image expected(PixelType::INDEXED_8, WIDTH, HEIGHT);
+            for (size_t y = 0; y < HEIGHT; ++y)
+            {
+                auto row = expected.mutable_view().row(y).first;
+                for (size_t x = 0; x < WIDTH; ++x)
+                {
+                    auto index = uint8_t((x + y) % colors);
+                    row[x] = index;
+                    auto shift = 8 - bit_depth - int(x * bit_depth % 8);
+                    packed[y * row_size + x * bit_depth / 8] |= uint8_t(index << shift);
+                }
+            }
+
+            std::ostringstream stream;
+            write_png(stream, packed.data(), packed.size(), metadata, {});
+            auto str = stream.str();
+
+            CAPTURE(bit_depth, interlace_type);
+            REQUIRE(probe_image(str.data(), str.size()).pixel_type == PixelType::INDEXED_8);
+            auto result = read_image(str.data(), str.size());
+            REQUIRE(result.view() == expected.view());
+            REQUIRE(result.metadata()->palette == metadata.palette);
+
+            ImageReader reader(str.data(), str.size());
+            REQUIRE(reader.info().pixel_type == PixelType::INDEXED_8);
+            Image rows(PixelType::INDEXED_8, WIDTH, HEIGHT);
+            reader.read_rows(rows.mutable_view());
+            REQUIRE(rows.view() == expected.view());
+        }
+    }
+}
+
+TEST_CASE("Write PNG to a failing sink")
+{
+    using namespace Yimage;
+    // ARGB images are always written with libpng.
+    Image image(PixelType::ARGB_8, 64, 64);
+    FailingSink sink(100, false);
+    REQUIRE_THROWS_AS(write_png(sink, image.view()), YimageException);
+
+    // The same image fits in a larger sink.
+    FailingSink large_sink(1'000'000, false);
+    REQUIRE_NOTHROW(write_png(large_sink, image.view()));
+}
+
+TEST_CASE("Write PNG to a sink that can't be flushed")
+{
+    using namespace Yimage;
+    auto context = ExecutionContext().thread_count(1);
+    for (auto pixel_type : {PixelType::ARGB_8, PixelType::RGBA_8})
+    {
+        CAPTURE(int(pixel_type));
+        Image image(pixel_type, 64, 64);
+        FailingSink sink(1'000'000, true);
+        REQUIRE_THROWS(write_png(sink, image.view(), {}, context));
+
+        Pipeline pipeline(image.view());
+        REQUIRE_THROWS(write_png(sink, pipeline, {}, context));
+    }
+
+    // The file sink's buffer holds the entire image until it is flushed.
+    if (std::filesystem::exists("/dev/full"))
+    {
+        Image image(PixelType::ARGB_8, 64, 64);
+        REQUIRE_THROWS_AS(write_png("/dev/full", image.view(), {}, context),
+                          YimageException);
+    }
+}
+
+TEST_CASE("Write indexed PNG with an invalid palette")
+{
+    using namespace Yimage;
+    Image image(PixelType::INDEXED_1, 16, 16);
+    REQUIRE_THROWS_AS(write(image.view(), {}), YimageException);
+
+    auto metadata = std::make_unique<ImageMetadata>();
+    metadata->palette.resize(3);
+    image.set_metadata(std::move(metadata));
+    REQUIRE_THROWS_AS(write(image.view(), {}), YimageException);
+}
+
+TEST_CASE("Write and read interlaced PNG")
+{
+    using namespace Yimage;
+    struct Format
+    {
+        PixelType pixel_type;
+        size_t width;
+        size_t height;
+    };
+    // The smallest images have passes without any pixels.
+    const Format formats[] = {
+        {PixelType::MONO_1, 304, 37},
+        {PixelType::MONO_2, 8, 3},
+        {PixelType::MONO_4, 2, 1},
+        {PixelType::MONO_8, 1, 1},
+        {PixelType::MONO_ALPHA_8, 5, 6},
+        {PixelType::RGB_8, 301, 213},
+        {PixelType::RGBA_8, 3, 11},
+        {PixelType::RGBA_16, 77, 9}
+    };
+
+    for (auto& format : formats)
+    {
+        auto image = make_image(format.pixel_type, format.width, format.height);
+        std::vector<unsigned char> buffer;
+        VectorSink sink(buffer);
+        write_png(sink, image.view(), PngWriteOptions().interlaced(true));
+
+        CAPTURE(int(format.pixel_type), format.width, format.height);
+        auto result = read_image(buffer.data(), buffer.size());
+        REQUIRE(result.view() == image.view());
+        auto metadata = dynamic_cast<const PngMetadata*>(result.metadata());
+        REQUIRE(metadata);
+        REQUIRE(metadata->interlace_type == PNG_INTERLACE_ADAM7);
+
+        ImageReader reader(buffer.data(), buffer.size());
+        Image rows(format.pixel_type, format.width, format.height);
+        reader.read_rows(rows.mutable_view());
+        REQUIRE(rows.view() == image.view());
+    }
+}
+
+TEST_CASE("Write interlaced PNG from a pipeline")
+{
+    using namespace Yimage;
+    auto image = read_image(CITY_JPG, CITY_JPG_SIZE);
+    for (const auto& context : {ExecutionContext(),
+                                ExecutionContext().thread_count(1)})
+    {
+        Pipeline pipeline(image.view());
+        std::vector<unsigned char> buffer;
+        VectorSink sink(buffer);
+        write_png(sink, pipeline, PngWriteOptions().interlaced(true), context);
+
+        auto result = read_image(buffer.data(), buffer.size());
+        REQUIRE(result.view() == image.view());
+    }
+}
+
+TEST_CASE("Write and read PNG with every filter")
+{
+    using namespace Yimage;
+    // The reference is ImageReader, which always reads the rows with
+    // libpng, also when PNGs are read with libdeflate.
+    const PixelType pixel_types[] = {
+        PixelType::MONO_1, PixelType::MONO_4, PixelType::MONO_8,
+        PixelType::MONO_ALPHA_8, PixelType::MONO_ALPHA_16,
+        PixelType::RGB_8, PixelType::RGB_16,
+        PixelType::RGBA_8, PixelType::RGBA_16
+    };
+    const int filters[] = {
+        PNG_FILTER_VALUE_NONE, PNG_FILTER_VALUE_SUB, PNG_FILTER_VALUE_UP,
+        PNG_FILTER_VALUE_AVG, PNG_FILTER_VALUE_PAETH, PNG_ALL_FILTERS
+    };
+
+    for (auto pixel_type : pixel_types)
+    {
+        auto image = make_image(pixel_type, 72, 37);
+        for (auto filter : filters)
+        {
+            for (bool interlaced : {false, true})
+            {
+                CAPTURE(int(pixel_type), filter, interlaced);
+                auto buffer = write(image.view(), PngWriteOptions()
+                    .filters(filter)
+                    .interlaced(interlaced));
+                REQUIRE(read_png(buffer.data(), buffer.size()).view()
+                        == image.view());
+
+                ImageReader reader(buffer.data(), buffer.size());
+                Image rows(pixel_type, image.width(), image.height());
+                reader.read_rows(rows.mutable_view());
+                REQUIRE(rows.view() == image.view());
+            }
+        }
+    }
+}
+
+TEST_CASE("Write PNG files with FileSink options")
+{
+    using namespace Yimage;
+    auto image = read_image(CITY_JPG, CITY_JPG_SIZE);
+    auto path = std::filesystem::temp_directory_path() / "YimageTest_FileSink.png";
+    const FileSinkOptions all_options[] = {
+        FileSinkOptions(),
+        FileSinkOptions().buffer_size(0),
+        FileSinkOptions().buffer_size(100),
+        FileSinkOptions().preallocate(true).sync(FileSync::DATA),
+        FileSinkOptions().sync(FileSync::FULL).drop_cache(true)
+    };
+
+    for (auto& options : all_options)
+    {
+        CAPTURE(options.buffer_size(), int(options.sync()));
+        std::vector<unsigned char> expected;
+        write_png(expected, image.view());
+        {
+            FileSink sink(path, options);
+            write_png(sink, image.view());
+        }
+        REQUIRE(std::filesystem::file_size(path) == expected.size());
+        REQUIRE(read_image(path).view() == image.view());
+    }
+    std::filesystem::remove(path);
+}